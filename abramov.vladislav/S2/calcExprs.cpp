@@ -1,96 +1,39 @@
 #include "calcExprs.hpp"
 #include <stdexcept>
-#include <sstream>
 #include <limits>
-#include "stack.hpp"
 
 namespace
 {
-  constexpr long long int max = std::numeric_limits< long long int >::max();
-  constexpr long long int min = std::numeric_limits< long long int >::min();
-
-  int sign(long long int a)
-  {
-    if (a > 0)
-    {
-      return 1;
-    }
-    else if (a < 0)
-    {
-      return -1;
-    }
-    else
-    {
-      return 0;
-    }
-  }
-
-  bool same_sign(long long int a, long long int b)
-  {
-    return sign(a) * sign(b) > 0;
-  }
+  using Operation = long long int (*)(long long int, long long int);
 
   long long int sum(long long int a, long long int b)
   {
-    if (same_sign(a, b) && a > 0 && max - a >= b)
-    {
-      return a + b;
-    }
-    else if (same_sign(a, b) && a < 0 && min - a <= b)
+    long long int res = 0ll;
+    if (__builtin_add_overflow(a, b, &res))
     {
-      return a + b;
+      throw std::logic_error("Overflow\n");
     }
-    else if (a == 0 || b == 0)
-    {
-      return a + b;
-    }
-    else if (!same_sign(a, b))
-    {
-      return a + b;
-    }
-    throw std::logic_error("Overflow\n");
+    return res;
   }
 
   long long int diff(long long int a, long long int b)
   {
-    if (same_sign(a, b) && a > 0 && min + b <= a)
-    {
-      return a - b;
-    }
-    else if (same_sign(a, b) && a < 0 && max - a >= b)
-    {
-      return a - b;
-    }
-    else if (a == 0 || b == 0)
+    long long int res = 0ll;
+    if (__builtin_sub_overflow(a, b, &res))
     {
-      return a - b;
+      throw std::logic_error("Overflow\n");
     }
-    else if (!same_sign(a, b))
-    {
-      return a - b;
-    }
-    throw std::logic_error("Overflow\n");
+    return res;
   }
 
   long long int prod(long long int a, long long int b)
   {
-    if (same_sign(a, b) && a > 0 && max / a >= b)
-    {
-      return a * b;
-    }
-    else if (same_sign(a, b) && a < 0 && max / a >= std::abs(b))
-    {
-      return a * b;
-    }
-    else if (a == 0 || b == 0)
+    long long int res = 0ll;
+    if (__builtin_mul_overflow(a, b, &res))
     {
-      return 0ll;
+      throw std::logic_error("Overflow\n");
     }
-    else if (!same_sign(a, b) && std::abs(min / a) >= std::abs(b))
-    {
-      return a * b;
-    }
-    throw std::logic_error("Overflow\n");
+    return res;
   }
 
   long long int quot(long long int a, long long int b)
@@ -99,202 +42,118 @@ namespace
     {
       throw std::logic_error("Division by zero\n");
     }
-    else if (a == 0)
-    {
-      return 0ll;
-    }
-    else if (same_sign(a, b) && a < 0 && a != min && b != -1ll)
+    if (a == std::numeric_limits< long long int >::min() && b == -1ll)
     {
-      return a / b;
+      throw std::logic_error("Overflow\n");
     }
-    else
-    {
-      return a / b;
-    }
-    throw std::logic_error("Overflow\n");
+    return a / b;
   }
 
-  long long int doOperation(long long int a, long long int b, const std::string &op)
+  long long int mod(long long int a, long long int b)
   {
-    if (op == "+")
-    {
-      return sum(a, b);
-    }
-    else if (op == "-")
-    {
-      return diff(a, b);
-    }
-    else if (op == "*")
+    if (b == 0)
     {
-      return prod(a, b);
+      throw std::logic_error("Division by zero\n");
     }
-    else if (op == "/")
+    long long int res = b == -1ll ? 0ll : a % b;
+    if (a < 0)
     {
-      return quot(a, b);
+      return sum(b, res);
     }
-    else if (op == "%")
-    {
-      if (a < 0)
-      {
-        return b - std::abs(a) % b;
-      }
-      else if (b == 0)
-      {
-        throw std::logic_error("Division by zero\n");
-      }
-      else
-      {
-        return a % b;
-      }
-    }
-    throw std::logic_error("Operation not supported\n");
+    return res;
+  }
+
+  constexpr Operation operations[] = { sum, diff, prod, quot, mod };
+
+  long long int doOperation(long long int a, long long int b, abramov::OpCode op)
+  {
+    return operations[static_cast< size_t >(op)](a, b);
   }
 
-  bool isNumber(const std::string &s)
+  void applyTop(abramov::ExprWorkspace &ws)
   {
-    try
+    if (ws.operands.size() < 2)
     {
-      std::stoll(s);
+      throw std::logic_error("Wrong expression\n");
     }
-    catch (...)
+    long long int num_r = ws.operands.top();
+    ws.operands.pop();
+    long long int num_l = ws.operands.top();
+    ws.operands.pop();
+    ws.operands.push(doOperation(num_l, num_r, ws.operators.top()));
+    ws.operators.pop();
+  }
+
+  void clear(abramov::ExprWorkspace &ws)
+  {
+    while (!ws.operands.empty())
     {
-      return false;
+      ws.operands.pop();
     }
-    for (auto it = s.begin(); it != s.end(); ++it)
+    while (!ws.operators.empty())
     {
-      if (!std::isdigit(*it))
-      {
-        return false;
-      }
+      ws.operators.pop();
     }
-    return true;
   }
 }
 
 long long int abramov::calcExpr(const std::string &s)
 {
-  Queue< std::string > *postfix = getPostfix(s);
-  long long int res = 0ll;
-  try
-  {
-    res = calcPostfix(postfix);
-  }
-  catch (...)
-  {
-    delete postfix;
-    throw;
-  }
-  delete postfix;
-  return res;
+  ExprWorkspace ws;
+  return calcExpr(s, ws);
 }
 
-long long int abramov::calcPostfix(abramov::Queue< std::string > *queue)
+long long int abramov::calcExpr(const std::string &s, ExprWorkspace &ws)
 {
-  Stack< long long int > stack;
-  std::string temp;
-  while(!queue->empty())
+  clear(ws);
+  ExprTokenizer tokenizer(s.data(), s.data() + s.size());
+  ExprToken token{};
+  size_t depth = 0;
+  while (tokenizer.next(token))
   {
-    temp = queue->front();
-    queue->pop();
-    if (isNumber(temp))
+    if (token.is_number)
     {
-      stack.push(std::stoll(temp));
+      ws.operands.push(token.value);
     }
-    else
+    else if (token.op == OpCode::OPEN)
     {
-      long long int num_r = stack.top();
-      stack.pop();
-      long long int num_l = stack.top();
-      stack.pop();
-      stack.push(doOperation(num_l, num_r, temp));
+      ws.operators.push(OpCode::OPEN);
+      ++depth;
     }
-  }
-  if (stack.size() != 1)
-  {
-    throw std::logic_error("Wrong expression\n");
-  }
-  return stack.top();
-}
-
-abramov::Queue< std::string > *abramov::getPostfix(const std::string &s)
-{
-  Queue< std::string > queue_infix;
-  std::stringstream ss(s);
-  std::string token;
-  while (ss >> token)
-  {
-    queue_infix.push(token);
-  }
-  Stack< std::string > stack;
-  Queue< std::string > *queue_postfix = new Queue< std::string >;
-  bool bracket = false;
-  while(!queue_infix.empty())
-  {
-    std::string temp = queue_infix.front();
-    queue_infix.pop();
-    if (temp == "(")
+    else if (token.op == OpCode::CLOSE)
     {
-      stack.push("(");
-      bracket = true;
-    }
-    else if (temp == ")")
-    {
-      if (!bracket)
+      if (depth == 0)
       {
-        delete queue_postfix;
         throw std::logic_error("Unbalanced brackets\n");
       }
-      while (stack.top() != "(")
-      {
-        queue_postfix->push(stack.top());
-        stack.pop();
-      }
-      stack.pop();
-      bracket = false;
-    }
-    else if (isNumber(temp))
-    {
-      queue_postfix->push(temp);
-    }
-    else if (temp == "+" || temp == "-")
-    {
-      if (!stack.empty())
+      while (ws.operators.top() != OpCode::OPEN)
       {
-        if (stack.top() != "(")
-        {
-          queue_postfix->push(stack.top());
-          stack.pop();
-        }
+        applyTop(ws);
       }
-      stack.push(temp);
+      ws.operators.pop();
+      --depth;
     }
-    else if (temp == "*" || temp == "/" || temp == "%")
+    else
     {
-      if (!stack.empty())
+      const int priority = getPriority(token.op);
+      while (!ws.operators.empty() && getPriority(ws.operators.top()) >= priority)
       {
-        if (stack.top() == "*" || stack.top() == "/" || stack.top() == "%")
-        {
-          queue_postfix->push(stack.top());
-          stack.pop();
-        }
+        applyTop(ws);
       }
-      stack.push(temp);
-    }
-    else
-    {
-      delete queue_postfix;
-      throw std::logic_error("Not supported symbol\n");
+      ws.operators.push(token.op);
     }
   }
-  while (!stack.empty())
+  if (depth != 0)
   {
-    queue_postfix->push(stack.top());
-    stack.pop();
+    throw std::logic_error("Unbalanced brackets\n");
   }
-  if (bracket)
+  while (!ws.operators.empty())
   {
-    delete queue_postfix;
-    throw std::logic_error("Unbalanced brackets\n");
+    applyTop(ws);
+  }
+  if (ws.operands.size() != 1)
+  {
+    throw std::logic_error("Wrong expression\n");
   }
-  return queue_postfix;
+  return ws.operands.top();
 }
@@ -1,12 +1,18 @@
 #ifndef CALCEXPRS_HPP
 #define CALCEXPRS_HPP
 #include <string>
-#include "queue.hpp"
+#include "stack.hpp"
+#include "expr_token.hpp"
 
 namespace abramov
 {
+  struct ExprWorkspace
+  {
+    Stack< long long int > operands;
+    Stack< OpCode > operators;
+  };
+
   long long int calcExpr(const std::string &s);
-  long long int calcPostfix(abramov::Queue< std::string > *queue);
-  Queue< std::string > *getPostfix(const std::string &s);
+  long long int calcExpr(const std::string &s, ExprWorkspace &ws);
 }
 #endif
@@ -0,0 +1,109 @@
+#include "expr_token.hpp"
+#include <cctype>
+#include <stdexcept>
+
+namespace
+{
+  bool isSpace(char c)
+  {
+    return std::isspace(static_cast< unsigned char >(c));
+  }
+
+  bool getOpCode(char c, abramov::OpCode &op)
+  {
+    using abramov::OpCode;
+    switch (c)
+    {
+    case '+':
+      op = OpCode::ADD;
+      return true;
+    case '-':
+      op = OpCode::SUB;
+      return true;
+    case '*':
+      op = OpCode::MUL;
+      return true;
+    case '/':
+      op = OpCode::DIV;
+      return true;
+    case '%':
+      op = OpCode::MOD;
+      return true;
+    case '(':
+      op = OpCode::OPEN;
+      return true;
+    case ')':
+      op = OpCode::CLOSE;
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  bool parseNumber(const char *begin, const char *end, long long int &value)
+  {
+    long long int res = 0ll;
+    for (const char *it = begin; it != end; ++it)
+    {
+      if (!std::isdigit(static_cast< unsigned char >(*it)))
+      {
+        return false;
+      }
+      if (__builtin_mul_overflow(res, 10ll, &res) || __builtin_add_overflow(res, *it - '0', &res))
+      {
+        return false;
+      }
+    }
+    value = res;
+    return true;
+  }
+}
+
+abramov::ExprTokenizer::ExprTokenizer(const char *begin, const char *end):
+  pos_(begin),
+  end_(end)
+{}
+
+bool abramov::ExprTokenizer::next(ExprToken &token)
+{
+  while (pos_ != end_ && isSpace(*pos_))
+  {
+    ++pos_;
+  }
+  if (pos_ == end_)
+  {
+    return false;
+  }
+  const char *begin = pos_;
+  while (pos_ != end_ && !isSpace(*pos_))
+  {
+    ++pos_;
+  }
+  if (pos_ - begin == 1 && getOpCode(*begin, token.op))
+  {
+    token.is_number = false;
+    return true;
+  }
+  if (!parseNumber(begin, pos_, token.value))
+  {
+    throw std::logic_error("Not supported symbol\n");
+  }
+  token.is_number = true;
+  return true;
+}
+
+int abramov::getPriority(OpCode op)
+{
+  switch (op)
+  {
+  case OpCode::ADD:
+  case OpCode::SUB:
+    return 1;
+  case OpCode::MUL:
+  case OpCode::DIV:
+  case OpCode::MOD:
+    return 2;
+  default:
+    return 0;
+  }
+}
@@ -0,0 +1,36 @@
+#ifndef EXPR_TOKEN_HPP
+#define EXPR_TOKEN_HPP
+#include <cstddef>
+
+namespace abramov
+{
+  enum class OpCode: unsigned char
+  {
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+    MOD,
+    OPEN,
+    CLOSE
+  };
+
+  struct ExprToken
+  {
+    bool is_number;
+    OpCode op;
+    long long int value;
+  };
+
+  struct ExprTokenizer
+  {
+    ExprTokenizer(const char *begin, const char *end);
+    bool next(ExprToken &token);
+  private:
+    const char *pos_;
+    const char *end_;
+  };
+
+  int getPriority(OpCode op);
+}
+#endif
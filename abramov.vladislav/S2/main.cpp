@@ -1,24 +1,32 @@
 #include <iostream>
 #include <fstream>
+#include <string>
 #include "postfix_infix_exprs.hpp"
 
 int main(int argc, char **argv)
 {
-  if (argc > 2)
+  const bool batch = argc > 1 && std::string(argv[1]) == "--batch";
+  const int first_file = batch ? 2 : 1;
+  if (argc > first_file + 1)
   {
     std::cerr << "Wrong parameters\n";
     return 1;
   }
   try
   {
-    if (argc == 2)
+    std::ifstream file;
+    if (argc == first_file + 1)
     {
-      std::ifstream input(argv[1]);
-      abramov::calcInfix(input);
+      file.open(argv[first_file]);
+    }
+    std::istream &input = argc == first_file + 1 ? file : std::cin;
+    if (batch)
+    {
+      abramov::calcInfixBatch(input);
     }
     else
     {
-      abramov::calcInfix(std::cin);
+      abramov::calcInfix(input);
     }
   }
   catch (const std::exception &e)
@@ -1,14 +1,130 @@
 #include "postfix_infix_exprs.hpp"
+#include <algorithm>
+#include <exception>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <system_error>
+#include <thread>
 #include "stack.hpp"
-#include "queue.hpp"
 #include "calcExprs.hpp"
 
+namespace
+{
+  constexpr size_t block_size = 1024;
+  constexpr size_t blocks_per_thread = 4;
+
+  struct LineBlock
+  {
+    std::unique_ptr< std::string[] > lines;
+    std::unique_ptr< long long int[] > results;
+    size_t count;
+    std::exception_ptr error;
+  };
+
+  void printResults(abramov::Stack< long long int > &stack)
+  {
+    if (stack.empty())
+    {
+      std::cout << "\n";
+      return;
+    }
+    std::cout << stack.top();
+    stack.pop();
+    while (!stack.empty())
+    {
+      std::cout << " " << stack.top();
+      stack.pop();
+    }
+    std::cout << "\n";
+  }
+
+  void calcBlocks(LineBlock *blocks, size_t count, size_t first, size_t step)
+  {
+    abramov::ExprWorkspace ws;
+    for (size_t i = first; i < count; i += step)
+    {
+      LineBlock &block = blocks[i];
+      try
+      {
+        for (size_t j = 0; j < block.count; ++j)
+        {
+          block.results[j] = abramov::calcExpr(block.lines[j], ws);
+        }
+      }
+      catch (...)
+      {
+        block.error = std::current_exception();
+      }
+    }
+  }
+
+  size_t readBlocks(std::istream &in, LineBlock *blocks, size_t count)
+  {
+    size_t filled = 0;
+    while (filled < count)
+    {
+      LineBlock &block = blocks[filled];
+      block.count = 0;
+      block.error = nullptr;
+      while (block.count < block_size && std::getline(in, block.lines[block.count]))
+      {
+        if (!block.lines[block.count].empty())
+        {
+          ++block.count;
+        }
+      }
+      if (block.count == 0)
+      {
+        break;
+      }
+      ++filled;
+    }
+    return filled;
+  }
+
+  void calcWave(LineBlock *blocks, size_t count, size_t threads)
+  {
+    threads = std::min(threads, count);
+    std::unique_ptr< std::thread[] > workers(new std::thread[threads - 1]);
+    size_t started = 0;
+    try
+    {
+      while (started + 1 < threads)
+      {
+        workers[started] = std::thread(calcBlocks, blocks, count, started + 1, threads);
+        ++started;
+      }
+    }
+    catch (const std::system_error &)
+    {}
+    try
+    {
+      for (size_t i = 0; i < threads - started; ++i)
+      {
+        calcBlocks(blocks, count, i == 0 ? 0 : started + i, threads);
+      }
+    }
+    catch (...)
+    {
+      for (size_t i = 0; i < started; ++i)
+      {
+        workers[i].join();
+      }
+      throw;
+    }
+    for (size_t i = 0; i < started; ++i)
+    {
+      workers[i].join();
+    }
+  }
+}
+
 std::istream &abramov::calcInfix(std::istream &in)
 {
   std::string s;
   abramov::Stack< long long int > stack;
+  abramov::ExprWorkspace ws;
   while (in)
   {
     std::getline(in, s);
@@ -16,20 +132,43 @@ std::istream &abramov::calcInfix(std::istream &in)
     {
       continue;
     }
-    stack.push(calcExpr(s));
+    stack.push(calcExpr(s, ws));
   }
-  if (stack.empty())
+  printResults(stack);
+  return in;
+}
+
+std::istream &abramov::calcInfixBatch(std::istream &in, size_t threads)
+{
+  if (threads == 0)
   {
-    std::cout << "\n";
-    return in;
+    threads = std::max(std::thread::hardware_concurrency(), 1u);
   }
-  std::cout << stack.top();
-  stack.pop();
-  while (!stack.empty())
+  const size_t wave_size = threads * blocks_per_thread;
+  std::unique_ptr< LineBlock[] > blocks(new LineBlock[wave_size]);
+  for (size_t i = 0; i < wave_size; ++i)
   {
-    std::cout << " " << stack.top();
-    stack.pop();
+    blocks[i].lines.reset(new std::string[block_size]);
+    blocks[i].results.reset(new long long int[block_size]);
+  }
+  abramov::Stack< long long int > stack;
+  size_t filled = readBlocks(in, blocks.get(), wave_size);
+  while (filled != 0)
+  {
+    calcWave(blocks.get(), filled, threads);
+    for (size_t i = 0; i < filled; ++i)
+    {
+      if (blocks[i].error)
+      {
+        std::rethrow_exception(blocks[i].error);
+      }
+      for (size_t j = 0; j < blocks[i].count; ++j)
+      {
+        stack.push(blocks[i].results[j]);
+      }
+    }
+    filled = readBlocks(in, blocks.get(), wave_size);
   }
-  std::cout << "\n";
+  printResults(stack);
   return in;
 }
@@ -1,9 +1,11 @@
 #ifndef POSTFIX_INFIX_EXPRS
 #define POSTFIX_INFIX_EXPRS
+#include <cstddef>
 #include <iostream>
 
 namespace abramov
 {
   std::istream &calcInfix(std::istream &in);
+  std::istream &calcInfixBatch(std::istream &in, size_t threads = 0);
 }
 #endif
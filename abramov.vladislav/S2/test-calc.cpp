@@ -0,0 +1,91 @@
+#include <boost/test/unit_test.hpp>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include "calcExprs.hpp"
+#include "postfix_infix_exprs.hpp"
+
+namespace
+{
+  std::string calcToString(const std::string &input, bool batch)
+  {
+    std::istringstream in(input);
+    std::ostringstream out;
+    std::streambuf *old = std::cout.rdbuf(out.rdbuf());
+    try
+    {
+      batch ? abramov::calcInfixBatch(in, 3) : abramov::calcInfix(in);
+    }
+    catch (...)
+    {
+      std::cout.rdbuf(old);
+      throw;
+    }
+    std::cout.rdbuf(old);
+    return out.str();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(calc_mixed_priority_chain)
+{
+  BOOST_TEST(abramov::calcExpr("1 - 2 * 3 + 4") == -1);
+  BOOST_TEST(abramov::calcExpr("10 - 4 - 3") == 3);
+  BOOST_TEST(abramov::calcExpr("1 + 2 * 3 - 4 / 2") == 5);
+}
+
+BOOST_AUTO_TEST_CASE(calc_nested_brackets)
+{
+  BOOST_TEST(abramov::calcExpr("( ( 1 + 2 ) * 3 )") == 9);
+  BOOST_TEST(abramov::calcExpr("2 * ( 3 + ( 4 - 1 ) )") == 12);
+  BOOST_CHECK_THROW(abramov::calcExpr("( 1 + 2"), std::logic_error);
+  BOOST_CHECK_THROW(abramov::calcExpr("1 + 2 )"), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(calc_mod)
+{
+  BOOST_TEST(abramov::calcExpr("7 % 3") == 1);
+  BOOST_TEST(abramov::calcExpr("( 0 - 6 ) % 3") == 3);
+  BOOST_TEST(abramov::calcExpr("( 0 - 7 ) % 3") == 2);
+  BOOST_TEST(abramov::calcExpr("( 0 - 7 ) % ( 0 - 3 )") == -4);
+  BOOST_CHECK_THROW(abramov::calcExpr("( 0 - 5 ) % 0"), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(calc_workspace_reuse)
+{
+  abramov::ExprWorkspace ws;
+  BOOST_CHECK_THROW(abramov::calcExpr("1 +", ws), std::logic_error);
+  BOOST_TEST(abramov::calcExpr("2 * 3", ws) == 6);
+}
+
+BOOST_AUTO_TEST_CASE(calc_batch_keeps_order)
+{
+  std::string input;
+  for (int i = 0; i < 5000; ++i)
+  {
+    input += std::to_string(i) + " * 2 - 1\n";
+    if (i % 7 == 0)
+    {
+      input += "\n";
+    }
+  }
+  BOOST_TEST(calcToString(input, true) == calcToString(input, false));
+  BOOST_TEST(calcToString("", true) == "\n");
+}
+
+BOOST_AUTO_TEST_CASE(calc_batch_first_error)
+{
+  std::string input;
+  for (int i = 0; i < 5000; ++i)
+  {
+    input += i == 1500 ? "( 1\n" : (i == 4000 ? "1 / 0\n" : "1 + 1\n");
+  }
+  try
+  {
+    calcToString(input, true);
+    BOOST_TEST(false);
+  }
+  catch (const std::logic_error &e)
+  {
+    BOOST_TEST(std::string(e.what()) == "Unbalanced brackets\n");
+  }
+}
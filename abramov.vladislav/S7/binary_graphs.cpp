@@ -0,0 +1,293 @@
+#include "binary_graphs.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+  using namespace abramov;
+
+  using Word = std::uint64_t;
+
+  const char file_magic[4] = { 'G', 'R', 'P', 'H' };
+  const std::uint32_t file_version = 1;
+
+  struct FileHeader
+  {
+    char magic[4];
+    std::uint32_t version;
+    Word string_count;
+    Word graph_count;
+  };
+
+  struct GraphHeader
+  {
+    Word name;
+    Word vertex_count;
+    Word edge_count;
+  };
+
+  struct GraphFile
+  {
+    explicit GraphFile(const std::string &filename);
+    GraphFile(const GraphFile &other) = delete;
+    GraphFile &operator=(const GraphFile &other) = delete;
+    ~GraphFile();
+    const char *readBytes(size_t count);
+    const Word *readWords(size_t count);
+    void skipPadding();
+  private:
+    void *map_;
+    size_t size_;
+    size_t pos_;
+  };
+
+  GraphFile::GraphFile(const std::string &filename):
+    map_(MAP_FAILED),
+    size_(0),
+    pos_(0)
+  {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+      throw std::runtime_error("Incorrect filename");
+    }
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+      size_ = static_cast< size_t >(info.st_size);
+      map_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    if (map_ == MAP_FAILED)
+    {
+      throw std::runtime_error("Incorrect graph file");
+    }
+  }
+
+  GraphFile::~GraphFile()
+  {
+    ::munmap(map_, size_);
+  }
+
+  const char *GraphFile::readBytes(size_t count)
+  {
+    if (count > size_ - pos_)
+    {
+      throw std::runtime_error("Unexpected end of graph file");
+    }
+    const char *res = static_cast< const char* >(map_) + pos_;
+    pos_ += count;
+    return res;
+  }
+
+  const Word *GraphFile::readWords(size_t count)
+  {
+    if (count > (size_ - pos_) / sizeof(Word))
+    {
+      throw std::runtime_error("Unexpected end of graph file");
+    }
+    return reinterpret_cast< const Word* >(readBytes(count * sizeof(Word)));
+  }
+
+  void GraphFile::skipPadding()
+  {
+    readBytes((sizeof(Word) - pos_ % sizeof(Word)) % sizeof(Word));
+  }
+
+  SimpleArray< std::string > readStrings(GraphFile &file, Word str_count)
+  {
+    const Word *str_offsets = file.readWords(str_count + 1);
+    const char *chars = file.readBytes(str_offsets[str_count]);
+    file.skipPadding();
+    SimpleArray< std::string > strs;
+    for (size_t i = 0; i < str_count; ++i)
+    {
+      if (str_offsets[i] > str_offsets[i + 1] || str_offsets[i + 1] > str_offsets[str_count])
+      {
+        throw std::runtime_error("Incorrect graph data");
+      }
+      strs.pushBack(std::string(chars + str_offsets[i], str_offsets[i + 1] - str_offsets[i]));
+    }
+    return strs;
+  }
+
+  Graph readGraph(GraphFile &file, const SimpleArray< std::string > &strs)
+  {
+    GraphHeader header;
+    std::memcpy(&header, file.readBytes(sizeof(header)), sizeof(header));
+    const Word *names = file.readWords(header.vertex_count);
+    const Word *offsets = file.readWords(header.vertex_count + 1);
+    const Word *targets = file.readWords(header.edge_count);
+    const Word *weights = file.readWords(header.edge_count);
+    if (header.name >= strs.size() || offsets[header.vertex_count] != header.edge_count)
+    {
+      throw std::runtime_error("Incorrect graph data");
+    }
+    Graph graph(strs[header.name]);
+    for (size_t i = 0; i < header.vertex_count; ++i)
+    {
+      if (names[i] >= strs.size() || offsets[i] > offsets[i + 1] || offsets[i + 1] > header.edge_count)
+      {
+        throw std::runtime_error("Incorrect graph data");
+      }
+      for (size_t e = offsets[i]; e < offsets[i + 1]; ++e)
+      {
+        if (targets[e] >= header.vertex_count || names[targets[e]] >= strs.size())
+        {
+          throw std::runtime_error("Incorrect graph data");
+        }
+        graph.addEdge(strs[names[i]], strs[names[targets[e]]], weights[e]);
+      }
+    }
+    return graph;
+  }
+
+  void writeWords(std::ostream &out, const SimpleArray< Word > &words)
+  {
+    if (words.size() > 0)
+    {
+      out.write(reinterpret_cast< const char* >(&words[0]), words.size() * sizeof(Word));
+    }
+  }
+
+  Word getId(HashTable< std::string, Word > &ids, SimpleArray< std::string > &strs, const std::string &str)
+  {
+    auto it = ids.find(str);
+    if (it != ids.end())
+    {
+      return it->second;
+    }
+    ids.insert(str, strs.size());
+    strs.pushBack(str);
+    return strs.size() - 1;
+  }
+
+  void collectVerts(const Graph &graph, HashTable< std::string, Word > &ids, SimpleArray< std::string > &verts)
+  {
+    HashTable< std::string, Word > uniq_verts;
+    for (auto it = graph.cbegin(); it != graph.cend(); ++it)
+    {
+      getId(uniq_verts, verts, it->first);
+      const SimpleArray< Edge > &edges = it->second;
+      for (size_t i = 0; i < edges.size(); ++i)
+      {
+        getId(uniq_verts, verts, edges[i].to);
+      }
+    }
+    if (!verts.empty())
+    {
+      std::sort(&verts[0], &verts[0] + verts.size());
+    }
+    for (size_t i = 0; i < verts.size(); ++i)
+    {
+      ids.insert(verts[i], i);
+    }
+  }
+}
+
+bool abramov::isBinaryGraphs(std::istream &in)
+{
+  char head[sizeof(file_magic)] = {};
+  std::istream::pos_type start = in.tellg();
+  in.read(head, sizeof(head));
+  bool res = in && std::memcmp(head, file_magic, sizeof(file_magic)) == 0;
+  in.clear();
+  in.seekg(start);
+  return res;
+}
+
+void abramov::readBinaryGraphs(const std::string &filename, GraphCollection &collect)
+{
+  GraphFile file(filename);
+  FileHeader header;
+  std::memcpy(&header, file.readBytes(sizeof(header)), sizeof(header));
+  if (std::memcmp(header.magic, file_magic, sizeof(file_magic)) != 0 || header.version != file_version)
+  {
+    throw std::runtime_error("Incorrect graph file");
+  }
+  if (header.string_count >= std::numeric_limits< size_t >::max() / sizeof(Word))
+  {
+    throw std::runtime_error("Incorrect graph data");
+  }
+  SimpleArray< std::string > strs = readStrings(file, header.string_count);
+  for (size_t g = 0; g < header.graph_count; ++g)
+  {
+    collect.addGraph(readGraph(file, strs));
+  }
+}
+
+void abramov::writeBinaryGraphs(const GraphCollection &collect, std::ostream &out)
+{
+  SimpleArray< std::string > graph_names = collect.getAllGraphsSorted();
+  HashTable< std::string, Word > str_ids;
+  SimpleArray< std::string > strs;
+  for (size_t g = 0; g < graph_names.size(); ++g)
+  {
+    getId(str_ids, strs, graph_names[g]);
+    HashTable< std::string, Word > vert_ids;
+    SimpleArray< std::string > verts;
+    collectVerts(collect.cgetGraph(graph_names[g]), vert_ids, verts);
+    for (size_t i = 0; i < verts.size(); ++i)
+    {
+      getId(str_ids, strs, verts[i]);
+    }
+  }
+
+  FileHeader header = { { file_magic[0], file_magic[1], file_magic[2], file_magic[3] }, file_version, strs.size(),
+    graph_names.size() };
+  out.write(reinterpret_cast< const char* >(&header), sizeof(header));
+  SimpleArray< Word > str_offsets;
+  str_offsets.pushBack(0);
+  for (size_t i = 0; i < strs.size(); ++i)
+  {
+    str_offsets.pushBack(str_offsets[i] + strs[i].size());
+  }
+  writeWords(out, str_offsets);
+  for (size_t i = 0; i < strs.size(); ++i)
+  {
+    out.write(strs[i].data(), strs[i].size());
+  }
+  const char padding[sizeof(Word)] = {};
+  out.write(padding, (sizeof(Word) - str_offsets[strs.size()] % sizeof(Word)) % sizeof(Word));
+
+  for (size_t g = 0; g < graph_names.size(); ++g)
+  {
+    const Graph &graph = collect.cgetGraph(graph_names[g]);
+    HashTable< std::string, Word > vert_ids;
+    SimpleArray< std::string > verts;
+    collectVerts(graph, vert_ids, verts);
+    SimpleArray< Word > names;
+    SimpleArray< Word > offsets;
+    SimpleArray< Word > targets;
+    SimpleArray< Word > weights;
+    offsets.pushBack(0);
+    for (size_t i = 0; i < verts.size(); ++i)
+    {
+      names.pushBack(str_ids.at(verts[i]));
+      const SimpleArray< Edge > *edges = graph.getEdges(verts[i]);
+      for (size_t e = 0; edges && e < edges->size(); ++e)
+      {
+        targets.pushBack(vert_ids.at((*edges)[e].to));
+        weights.pushBack((*edges)[e].weight);
+      }
+      offsets.pushBack(targets.size());
+    }
+    GraphHeader graph_header = { str_ids.at(graph_names[g]), verts.size(), targets.size() };
+    out.write(reinterpret_cast< const char* >(&graph_header), sizeof(graph_header));
+    writeWords(out, names);
+    writeWords(out, offsets);
+    writeWords(out, targets);
+    writeWords(out, weights);
+  }
+  if (!out)
+  {
+    throw std::runtime_error("Incorrect output file");
+  }
+}
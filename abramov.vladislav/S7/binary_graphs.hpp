@@ -0,0 +1,14 @@
+#ifndef BINARY_GRAPHS_HPP
+#define BINARY_GRAPHS_HPP
+#include <istream>
+#include <ostream>
+#include <string>
+#include "graph_collection.hpp"
+
+namespace abramov
+{
+  bool isBinaryGraphs(std::istream &in);
+  void readBinaryGraphs(const std::string &filename, GraphCollection &collect);
+  void writeBinaryGraphs(const GraphCollection &collect, std::ostream &out);
+}
+#endif
@@ -51,6 +51,27 @@ void abramov::Graph::addEdge(const std::string &from, const std::string &to, siz
   ++edge_count;
 }
 
+void abramov::Graph::addEdges(const std::string &vert, const SimpleArray< Edge > &edges)
+{
+  auto it = adj_list.find(vert);
+  if (it == adj_list.end())
+  {
+    adj_list.insert(vert, edges);
+  }
+  else if (it->second.empty())
+  {
+    it->second = edges;
+  }
+  else
+  {
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+      it->second.pushBack(edges[i]);
+    }
+  }
+  edge_count += edges.size();
+}
+
 bool abramov::Graph::cutEdge(const std::string &from, const std::string &to, size_t w)
 {
   if (!hasVertex(from) || !hasVertex(to))
@@ -16,6 +16,7 @@ namespace abramov
     Graph &operator=(const Graph &other);
     void addVertex(const std::string &vert);
     void addEdge(const std::string &from, const std::string &to, size_t w);
+    void addEdges(const std::string &vert, const SimpleArray< Edge > &edges);
     bool cutEdge(const std::string &from, const std::string &to, size_t w);
     const std::string &getName() const noexcept;
     size_t getEdgeCount() const noexcept;
@@ -30,20 +30,25 @@ namespace
   {
     for (auto it = graph.cbegin(); it != graph.cend(); ++it)
     {
-      res.addVertex(it->first);
+      res.addEdges(it->first, it->second);
     }
+  }
+
+  HashTable< std::string, bool > getTargets(const Graph &graph)
+  {
+    HashTable< std::string, bool > targets;
     for (auto it = graph.cbegin(); it != graph.cend(); ++it)
     {
-      const SimpleArray< Edge > *edges = graph.getEdges(it->first);
-      if (edges)
+      for (size_t i = 0; i < it->second.size(); ++i)
       {
-        for (size_t i = 0; i < edges->size(); ++i)
+        const std::string &to = it->second[i].to;
+        if (targets.cfind(to) == targets.cend())
         {
-          const Edge &edge = (*edges)[i];
-          res.addEdge(edge.from, edge.to, edge.weight);
+          targets.insert(to, true);
         }
       }
     }
+    return targets;
   }
 }
 
@@ -271,10 +276,10 @@ void abramov::mergeGraphs(GraphCollection &collect, const std::string &name, std
   collect.addGraph(res);
 }
 
-void extractGraph(GraphCollection &collect, const std::string &name, std::istream in)
+void abramov::extractGraph(GraphCollection &collect, const std::string &name, std::istream &in)
 {
-  std::string new_name;
-  in >> new_name;
+  std::string src_name;
+  in >> src_name;
   size_t k = 0;
   in >> k;
   SimpleArray< std::string > verts;
@@ -284,31 +289,57 @@ void extractGraph(GraphCollection &collect, const std::string &name, std::istrea
     in >> vert;
     verts.pushBack(vert);
   }
-  const Graph &src_graph = collect.cgetGraph(name);
+  const Graph &src_graph = collect.cgetGraph(src_name);
+  HashTable< std::string, bool > targets;
+  bool targets_ready = false;
   for (size_t i = 0; i < verts.size(); ++i)
   {
-    if (!src_graph.hasVertex(verts[i]))
+    if (src_graph.hasVertex(verts[i]))
+    {
+      continue;
+    }
+    if (!targets_ready)
+    {
+      targets = getTargets(src_graph);
+      targets_ready = true;
+    }
+    if (targets.cfind(verts[i]) == targets.cend())
     {
       throw std::logic_error("There is no such vertex\n");
     }
   }
-  Graph res(new_name);
+  HashTable< std::string, bool > kept_verts;
+  for (size_t i = 0; i < verts.size(); ++i)
+  {
+    kept_verts.insert(verts[i], true);
+  }
+  Graph res(name);
   for (size_t i = 0; i < verts.size(); ++i)
   {
     const SimpleArray< Edge > *edges = src_graph.getEdges(verts[i]);
-    if (edges)
+    if (!edges)
+    {
+      continue;
+    }
+    size_t kept = 0;
+    while (kept < edges->size() && kept_verts.cfind((*edges)[kept].to) != kept_verts.cend())
     {
-      for (size_t j = 0; j < edges->size(); ++j)
+      ++kept;
+    }
+    if (kept == edges->size())
+    {
+      if (kept)
       {
-        for (size_t n = 0; n < verts.size(); ++n)
-        {
-          const Edge &edge = (*edges)[j];
-          if (verts[n] == edge.to)
-          {
-            res.addEdge(edge.from, edge.to, edge.weight);
-            break;
-          }
-        }
+        res.addEdges(verts[i], *edges);
+      }
+      continue;
+    }
+    for (size_t j = 0; j < edges->size(); ++j)
+    {
+      const Edge &edge = (*edges)[j];
+      if (kept_verts.cfind(edge.to) != kept_verts.cend())
+      {
+        res.addEdge(edge.from, edge.to, edge.weight);
       }
     }
   }
@@ -13,5 +13,6 @@ namespace abramov
   void cutEdgeFromGraph(GraphCollection &collect, const std::string &name, std::istream &in);
   void createGraph(GraphCollection &collect, std::istream &in);
   void mergeGraphs(GraphCollection &collect, const std::string &name, std::istream &in);
+  void extractGraph(GraphCollection &collect, const std::string &name, std::istream &in);
 }
 #endif
@@ -1,24 +1,54 @@
 #include <limits>
 #include <iostream>
 #include "graph_utils.hpp"
+#include "binary_graphs.hpp"
 
 int main(int argc, char **argv)
 {
   using namespace abramov;
 
-  if (argc != 2)
+  const bool is_convert = argc == 4 && std::string(argv[1]) == "--convert";
+  if (argc != 2 && !is_convert)
   {
     std::cerr << "Wrong parameters\n";
     return 1;
   }
-  std::ifstream input(argv[1]);
+  const std::string filename = argv[is_convert ? 2 : 1];
+  std::ifstream input(filename, std::ios::binary);
   if (!input)
   {
     std::cerr << "Incorrect filename\n";
     return 1;
   }
   GraphCollection collection{};
-  readGraphs(input, collection);
+  try
+  {
+    if (isBinaryGraphs(input))
+    {
+      input.close();
+      readBinaryGraphs(filename, collection);
+    }
+    else
+    {
+      readGraphs(input, collection);
+    }
+    if (is_convert)
+    {
+      std::ofstream output(argv[3], std::ios::binary);
+      if (!output)
+      {
+        std::cerr << "Incorrect filename\n";
+        return 1;
+      }
+      writeBinaryGraphs(collection, output);
+      return 0;
+    }
+  }
+  catch (const std::exception &e)
+  {
+    std::cerr << e.what() << "\n";
+    return 1;
+  }
   std::string command;
   while (!(std::cin >> command).eof())
   {
@@ -72,6 +102,9 @@ int main(int argc, char **argv)
       }
       else if (command == "extract")
       {
+        std::string name;
+        std::cin >> name;
+        extractGraph(collection, name, std::cin);
       }
       else
       {
@@ -12,17 +12,20 @@ namespace abramov
     SimpleArray(const SimpleArray< T > &other);
     ~SimpleArray();
     SimpleArray< T > &operator=(const SimpleArray< T > &other);
-    T &operator[](size_t id) noexcept;
+    T &operator[](size_t id);
     const T &operator[](size_t id) const noexcept;
     void pushBack(const T &val);
     size_t size() const noexcept;
     bool empty() const noexcept;
   private:
     T *data_;
+    size_t *refs_;
     size_t capacity_;
     size_t size_;
 
     void resize(size_t k);
+    void unshare();
+    void release() noexcept;
     void swap(SimpleArray< T > &rhs) noexcept;
   };
 }
@@ -30,32 +33,45 @@ namespace abramov
 template< class T >
 abramov::SimpleArray< T >::SimpleArray():
   data_(nullptr),
+  refs_(nullptr),
   capacity_(0),
   size_(0)
 {}
 
 template< class T >
 abramov::SimpleArray< T >::SimpleArray(const SimpleArray< T > &other):
-  data_(new T[other.capacity_]),
+  data_(other.data_),
+  refs_(other.refs_),
   capacity_(other.capacity_),
   size_(other.size_)
 {
-  for (size_t i = 0; i < size_; ++i)
+  if (refs_)
   {
-    data_[i] = other.data_[i];
+    ++*refs_;
   }
 }
 
 template< class T >
 abramov::SimpleArray< T >::~SimpleArray()
 {
-  delete[] data_;
+  release();
+}
+
+template< class T >
+void abramov::SimpleArray< T >::release() noexcept
+{
+  if (refs_ && --*refs_ == 0)
+  {
+    delete[] data_;
+    delete refs_;
+  }
 }
 
 template< class T >
 void abramov::SimpleArray< T >::swap(SimpleArray< T > &other) noexcept
 {
   std::swap(data_, other.data_);
+  std::swap(refs_, other.refs_);
   std::swap(capacity_, other.capacity_);
   std::swap(size_, other.size_);
 }
@@ -75,8 +91,9 @@ const T &abramov::SimpleArray< T >::operator[](size_t id) const noexcept
 }
 
 template< class T >
-T &abramov::SimpleArray< T >::operator[](size_t id) noexcept
+T &abramov::SimpleArray< T >::operator[](size_t id)
 {
+  unshare();
   return const_cast< T& >(static_cast< const SimpleArray& >(*this)[id]);
 }
 
@@ -85,15 +102,16 @@ void abramov::SimpleArray< T >::pushBack(const T &val)
 {
   if (size_ >= capacity_)
   {
+    size_t new_capacity = 10;
     if (capacity_)
     {
-      capacity_ *= 2;
+      new_capacity = capacity_ * 2;
     }
-    else
-    {
-      capacity_ = 10;
-    }
-    resize(capacity_);
+    resize(new_capacity);
+  }
+  else
+  {
+    unshare();
   }
   data_[size_++] = val;
 }
@@ -102,12 +120,33 @@ template< class T >
 void abramov::SimpleArray< T >::resize(size_t k)
 {
   T *new_data = new T[k];
-  for (size_t i = 0; i < size_; ++i)
+  size_t *new_refs = nullptr;
+  try
   {
-    new_data[i] = data_[i];
+    for (size_t i = 0; i < size_; ++i)
+    {
+      new_data[i] = data_[i];
+    }
+    new_refs = new size_t(1);
+  }
+  catch (...)
+  {
+    delete[] new_data;
+    throw;
   }
-  delete[] data_;
+  release();
   data_ = new_data;
+  refs_ = new_refs;
+  capacity_ = k;
+}
+
+template< class T >
+void abramov::SimpleArray< T >::unshare()
+{
+  if (refs_ && *refs_ > 1)
+  {
+    resize(capacity_);
+  }
 }
 
 template< class T >
@@ -0,0 +1,188 @@
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include "binary_graphs.hpp"
+#include "graph_utils.hpp"
+
+namespace
+{
+  const std::string graph_text = "g1 3 a b 1 b c 2 a b 4\ng2 2 x y 7 y x 7\n";
+
+  void writeFile(const std::string &filename, const std::string &data)
+  {
+    std::ofstream out(filename, std::ios::binary);
+    out.write(data.data(), data.size());
+  }
+
+  abramov::GraphCollection readTextGraphs(const std::string &text = graph_text)
+  {
+    const std::string filename = "test-binary-graphs.txt";
+    writeFile(filename, text);
+    abramov::GraphCollection collect{};
+    std::ifstream in(filename);
+    abramov::readGraphs(in, collect);
+    in.close();
+    std::remove(filename.c_str());
+    return collect;
+  }
+
+  std::string writeToString(const abramov::GraphCollection &collect)
+  {
+    std::ostringstream out(std::ios::binary);
+    abramov::writeBinaryGraphs(collect, out);
+    return out.str();
+  }
+
+  std::multiset< std::string > describe(const abramov::GraphCollection &collect)
+  {
+    std::multiset< std::string > res;
+    abramov::SimpleArray< std::string > names = collect.getAllGraphsSorted();
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+      const abramov::Graph &graph = collect.cgetGraph(names[i]);
+      for (auto it = graph.cbegin(); it != graph.cend(); ++it)
+      {
+        res.insert(names[i] + " " + it->first);
+        for (size_t j = 0; j < it->second.size(); ++j)
+        {
+          const abramov::Edge &edge = it->second[j];
+          res.insert(names[i] + " " + edge.from + " " + edge.to + " " + std::to_string(edge.weight));
+        }
+      }
+    }
+    return res;
+  }
+
+  std::multiset< std::string > describeEdges(const abramov::Graph &graph)
+  {
+    std::multiset< std::string > res;
+    for (auto it = graph.cbegin(); it != graph.cend(); ++it)
+    {
+      for (size_t j = 0; j < it->second.size(); ++j)
+      {
+        const abramov::Edge &edge = it->second[j];
+        res.insert(edge.from + " " + edge.to + " " + std::to_string(edge.weight));
+      }
+    }
+    return res;
+  }
+
+  void extract(abramov::GraphCollection &collect, const std::string &name, const std::string &args)
+  {
+    std::istringstream in(args);
+    abramov::extractGraph(collect, name, in);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(binary_graphs_round_trip)
+{
+  const abramov::GraphCollection collect = readTextGraphs();
+  const std::string filename = "test-binary-graphs.bin";
+  writeFile(filename, writeToString(collect));
+  std::ifstream in(filename, std::ios::binary);
+  BOOST_TEST(abramov::isBinaryGraphs(in));
+  in.close();
+  abramov::GraphCollection loaded{};
+  abramov::readBinaryGraphs(filename, loaded);
+  std::remove(filename.c_str());
+  BOOST_TEST(loaded.getAllGraphsSorted().size() == 2);
+  BOOST_TEST(loaded.cgetGraph("g1").getEdgeCount() == 3);
+  BOOST_TEST((describe(loaded) == describe(collect)));
+}
+
+BOOST_AUTO_TEST_CASE(binary_graphs_text_is_not_binary)
+{
+  std::istringstream in(graph_text);
+  BOOST_TEST(!abramov::isBinaryGraphs(in));
+}
+
+BOOST_AUTO_TEST_CASE(binary_graphs_truncated_file)
+{
+  const std::string data = writeToString(readTextGraphs());
+  const std::string filename = "test-binary-graphs-truncated.bin";
+  for (size_t size: { size_t(4), size_t(16), data.size() / 2, data.size() - 1 })
+  {
+    writeFile(filename, data.substr(0, size));
+    abramov::GraphCollection loaded{};
+    BOOST_CHECK_THROW(abramov::readBinaryGraphs(filename, loaded), std::runtime_error);
+  }
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(extract_sink_vertex)
+{
+  abramov::GraphCollection collect = readTextGraphs("G 3 a b 1 a c 2 b c 3\n");
+  extract(collect, "F", "G 3 a b c");
+  const abramov::Graph &res = collect.cgetGraph("F");
+  BOOST_TEST(res.getEdgeCount() == 3);
+  BOOST_TEST((describeEdges(res) == describeEdges(collect.cgetGraph("G"))));
+  extract(collect, "H", "G 1 c");
+  BOOST_TEST(collect.cgetGraph("H").getEdgeCount() == 0);
+  BOOST_CHECK_THROW(extract(collect, "E", "G 2 a z"), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(extract_filters_edges)
+{
+  abramov::GraphCollection collect = readTextGraphs("G 4 a b 1 a c 2 b c 3 c a 4\n");
+  extract(collect, "F", "G 2 a c");
+  const abramov::Graph &res = collect.cgetGraph("F");
+  BOOST_TEST(res.getEdgeCount() == 2);
+  BOOST_TEST((describeEdges(res) == std::multiset< std::string >{ "a c 2", "c a 4" }));
+  BOOST_TEST(collect.cgetGraph("G").getEdgeCount() == 4);
+}
+
+BOOST_AUTO_TEST_CASE(graph_copy_survives_bind_and_cut)
+{
+  abramov::GraphCollection collect = readTextGraphs();
+  const abramov::GraphCollection copy = collect;
+  const std::multiset< std::string > before = describe(copy);
+  std::istringstream bind("a c 5");
+  abramov::addEdgeToGraph(collect, "g1", bind);
+  std::istringstream cut("a b 1");
+  abramov::cutEdgeFromGraph(collect, "g1", cut);
+  BOOST_TEST((describeEdges(collect.cgetGraph("g1")) == std::multiset< std::string >{ "a b 4", "a c 5", "b c 2" }));
+  BOOST_TEST((describe(copy) == before));
+  BOOST_TEST(copy.cgetGraph("g1").getEdgeCount() == 3);
+}
+
+BOOST_AUTO_TEST_CASE(graph_add_edges_adopts_and_appends)
+{
+  abramov::SimpleArray< abramov::Edge > edges;
+  edges.pushBack(abramov::Edge("a", "b", 1));
+  edges.pushBack(abramov::Edge("a", "c", 2));
+  abramov::Graph graph("g");
+  graph.addEdges("a", edges);
+  graph.addVertex("b");
+  graph.addEdges("b", abramov::SimpleArray< abramov::Edge >());
+  BOOST_TEST(graph.getEdgeCount() == 2);
+  BOOST_TEST(graph.getEdges("b")->empty());
+  abramov::SimpleArray< abramov::Edge > more;
+  more.pushBack(abramov::Edge("a", "d", 3));
+  graph.addEdges("a", more);
+  BOOST_TEST(graph.getEdgeCount() == 3);
+  const abramov::SimpleArray< abramov::Edge > &res = *graph.getEdges("a");
+  BOOST_TEST(res.size() == 3);
+  BOOST_TEST(res[0].to == "b");
+  BOOST_TEST(res[2].to == "d");
+  BOOST_TEST(edges.size() == 2);
+  graph.addEdge("b", "a", 4);
+  graph.addEdges("b", more);
+  BOOST_TEST(graph.getEdges("b")->size() == 2);
+  BOOST_TEST(more.size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(extract_copy_survives_bind)
+{
+  abramov::GraphCollection collect = readTextGraphs("G 3 a b 1 a c 2 b c 3\n");
+  extract(collect, "F", "G 2 a b");
+  BOOST_TEST((describeEdges(collect.cgetGraph("F")) == std::multiset< std::string >{ "a b 1" }));
+  extract(collect, "H", "G 3 a b c");
+  std::istringstream bind("a b 7");
+  abramov::addEdgeToGraph(collect, "H", bind);
+  BOOST_TEST(collect.cgetGraph("H").getEdges("a")->size() == 3);
+  BOOST_TEST(collect.cgetGraph("G").getEdges("a")->size() == 2);
+  BOOST_TEST(collect.cgetGraph("G").getEdgeCount() == 3);
+}
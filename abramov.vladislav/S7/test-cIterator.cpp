@@ -1,5 +1,5 @@
 #include <boost/test/unit_test.hpp>
-#include "hash_table.hpp"
+#include <hash_table/hash_table.hpp>
 
 BOOST_AUTO_TEST_CASE(pre_increment_const)
 {
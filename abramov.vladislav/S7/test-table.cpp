@@ -1,22 +1,22 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/test/tools/detail/print_helper.hpp>
-#include "hash_table.hpp"
+#include <hash_table/hash_table.hpp>
 
 namespace boost::test_tools::tt_detail
 {
   template< class Key, class Value, class Hash, class Equal >
-  struct print_log_value< abramov::Iterator< Key, Value, Hash, Equal  > >
+  struct print_log_value< abramov::HashIterator< Key, Value, Hash, Equal > >
   {
-    void operator()(std::ostream &os, const abramov::Iterator< Key, Value, Hash, Equal > &iter)
+    void operator()(std::ostream &os, const abramov::HashIterator< Key, Value, Hash, Equal > &iter)
     {
       os << "iter";
     }
   };
 
   template< class Key, class Value, class Hash, class Equal >
-  struct print_log_value< abramov::ConstIterator< Key, Value, Hash, Equal > >
+  struct print_log_value< abramov::ConstHashIterator< Key, Value, Hash, Equal > >
   {
-    void operator()(std::ostream &os, const abramov::ConstIterator< Key, Value, Hash, Equal > &iter)
+    void operator()(std::ostream &os, const abramov::ConstHashIterator< Key, Value, Hash, Equal > &iter)
     {
       os << "cIter";
     }
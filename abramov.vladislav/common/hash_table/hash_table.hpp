@@ -2,6 +2,7 @@
 #define HASH_TABLE_HPP
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <algorithm>
 #include <functional>
 #include "decls.hpp"
@@ -51,6 +52,7 @@ namespace abramov
     void resizeIfNeed();
     void swap(HashTable< Key, Value, Hash, Equal > &other) noexcept;
     size_t findInsertPosition(const Key &k) const;
+    size_t getHomePosition(const Key &k) const;
     bool isPrime(size_t k) const noexcept;
     size_t getLargerPrimeCapacity(size_t k) const noexcept;
   };
@@ -174,17 +176,26 @@ void abramov::HashTable< Key, Value, Hash, Equal >::rehash(size_t k)
 {
   HashNode< Key, Value > **old_table = table_;
   size_t old_capacity = capacity_;
-  capacity_ = k;
-  size_ = 0;
-  initTable();
+  capacity_ = std::max(k, size_ + 1);
+  try
+  {
+    initTable();
+  }
+  catch (...)
+  {
+    table_ = old_table;
+    capacity_ = old_capacity;
+    throw;
+  }
   for (size_t i = 0; i < old_capacity; ++i)
   {
     HashNode< Key, Value > *curr = old_table[i];
     while (curr)
     {
-      insert(curr->data_.first, curr->data_.second);
       HashNode< Key, Value > *next = curr->next_;
-      delete curr;
+      size_t pos = findInsertPosition(curr->data_.first);
+      curr->next_ = table_[pos];
+      table_[pos] = curr;
       curr = next;
     }
   }
@@ -194,54 +205,51 @@ void abramov::HashTable< Key, Value, Hash, Equal >::rehash(size_t k)
 template< class Key, class Value, class Hash, class Equal >
 size_t abramov::HashTable< Key, Value, Hash, Equal >::findInsertPosition(const Key &k) const
 {
-  size_t pos = hash_(k) % capacity_;
+  size_t orig_pos = getHomePosition(k);
+  size_t pos = orig_pos;
   size_t att = 0;
   while (table_[pos] && !equal_(table_[pos]->data_.first, k))
   {
-    pos = (pos + att * att) % capacity_;
     ++att;
+    pos = (orig_pos + att) % capacity_;
   }
   return pos;
 }
 
+template< class Key, class Value, class Hash, class Equal >
+size_t abramov::HashTable< Key, Value, Hash, Equal >::getHomePosition(const Key &k) const
+{
+  std::uint64_t mixed = static_cast< std::uint64_t >(hash_(k)) + capacity_ * 0x9E3779B97F4A7C15;
+  mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9;
+  mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EB;
+  mixed ^= mixed >> 31;
+  return static_cast< size_t >(mixed % capacity_);
+}
+
 template< class Key, class Value, class Hash, class Equal >
 size_t abramov::HashTable< Key, Value, Hash, Equal >::erase(const Key &k)
 {
+  size_t pos = findInsertPosition(k);
   size_t removed = 0;
-  size_t orig_pos = hash_(k) % capacity_;
-  size_t pos = orig_pos;
-  size_t att = 0;
-  do
+  HashNode< Key, Value > *curr = table_[pos];
+  table_[pos] = nullptr;
+  while (curr)
   {
-    HashNode< Key, Value > *curr = table_[pos];
-    HashNode< Key, Value > *prev = nullptr;
-    while (curr)
+    HashNode< Key, Value > *next = curr->next_;
+    delete curr;
+    ++removed;
+    --size_;
+    curr = next;
+  }
+  if (removed)
+  {
+    for (size_t i = (pos + 1) % capacity_; table_[i]; i = (i + 1) % capacity_)
     {
-      if (equal_(curr->data_.first, k))
-      {
-        HashNode< Key, Value > *del = curr;
-        if (prev)
-        {
-          prev->next_ = curr->next_;
-        }
-        else
-        {
-          table_[pos] = curr->next_;
-        }
-        curr = curr->next_;
-        delete del;
-        ++removed;
-        --size_;
-      }
-      else
-      {
-        prev = curr;
-        curr = curr->next_;
-      }
+      HashNode< Key, Value > *moved = table_[i];
+      table_[i] = nullptr;
+      table_[findInsertPosition(moved->data_.first)] = moved;
     }
-    ++att;
-    pos = (orig_pos + att * att) % capacity_;
-  } while (pos != orig_pos);
+  }
   return removed;
 }
 
@@ -286,24 +294,12 @@ abramov::HashTable< Key, Value, Hash, Equal >::find(const Key & k)
   {
     return end();
   }
-  size_t pos = hash_(k) % capacity_;
-  size_t att = 0;
-  size_t orig_pos = pos;
-  do
+  size_t pos = findInsertPosition(k);
+  if (!table_[pos])
   {
-    HashNode< Key, Value > *curr = table_[pos];
-    while (curr)
-    {
-      if (equal_(curr->data_.first, k))
-      {
-        return HashIterator< Key, Value, Hash, Equal >(this, pos, curr);
-      }
-      curr = curr->next_;
-    }
-    ++att;
-    pos = (orig_pos + att * att) % capacity_;
-  } while (pos != orig_pos);
-  return end();
+    return end();
+  }
+  return HashIterator< Key, Value, Hash, Equal >(this, pos, table_[pos]);
 }
 
 template< class Key, class Value, class Hash, class Equal >
@@ -335,24 +331,12 @@ abramov::HashTable< Key, Value, Hash, Equal >::cfind(const Key & k) const
   {
     return cend();
   }
-  size_t pos = hash_(k) % capacity_;
-  size_t att = 0;
-  size_t orig_pos = pos;
-  do
+  size_t pos = findInsertPosition(k);
+  if (!table_[pos])
   {
-    HashNode< Key, Value > *curr = table_[pos];
-    while (curr)
-    {
-      if (equal_(curr->data_.first, k))
-      {
-        return ConstHashIterator< Key, Value, Hash, Equal >(this, pos, curr);
-      }
-      curr = curr->next_;
-    }
-    ++att;
-    pos = (orig_pos + att * att) % capacity_;
-  } while (pos != orig_pos);
-  return cend();
+    return cend();
+  }
+  return ConstHashIterator< Key, Value, Hash, Equal >(this, pos, table_[pos]);
 }
 
 template< class Key, class Value, class Hash, class Equal >
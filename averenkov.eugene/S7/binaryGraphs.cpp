@@ -0,0 +1,291 @@
+#include "binaryGraphs.hpp"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <array.hpp>
+#include <hashTable.hpp>
+
+namespace
+{
+  using word = std::uint64_t;
+
+  const char magic[4] = { 'G', 'R', 'P', 'H' };
+  const std::uint32_t version = 1;
+
+  struct FileHeader
+  {
+    char magic[4];
+    std::uint32_t version;
+    word stringCount;
+    word graphCount;
+  };
+
+  struct GraphHeader
+  {
+    word name;
+    word vertexCount;
+    word edgeCount;
+  };
+
+  class GraphFileReader
+  {
+  public:
+    explicit GraphFileReader(const std::string& filename);
+    GraphFileReader(const GraphFileReader&) = delete;
+    GraphFileReader& operator=(const GraphFileReader&) = delete;
+    ~GraphFileReader();
+
+    FileHeader readFileHeader();
+    averenkov::Array< std::string > readStrings(size_t count);
+    void readGraph(const averenkov::Array< std::string >& strings, averenkov::Tree< std::string, averenkov::Graph >& graphs);
+
+  private:
+    const char* begin_;
+    const char* end_;
+    const char* current_;
+
+    const word* readWords(size_t count);
+    void skip(size_t bytes);
+  };
+
+  GraphFileReader::GraphFileReader(const std::string& filename):
+    begin_(nullptr),
+    end_(nullptr),
+    current_(nullptr)
+  {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+      throw std::runtime_error("Error opening file");
+    }
+    struct stat info;
+    size_t size = ::fstat(fd, &info) == 0 ? static_cast< size_t >(info.st_size) : 0;
+    void* mapped = size == 0 ? MAP_FAILED : ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED)
+    {
+      throw std::runtime_error("Invalid graph file");
+    }
+    begin_ = static_cast< const char* >(mapped);
+    end_ = begin_ + size;
+    current_ = begin_;
+  }
+
+  GraphFileReader::~GraphFileReader()
+  {
+    ::munmap(const_cast< char* >(begin_), end_ - begin_);
+  }
+
+  void GraphFileReader::skip(size_t bytes)
+  {
+    if (bytes > static_cast< size_t >(end_ - current_))
+    {
+      throw std::runtime_error("Graph file is too short");
+    }
+    current_ += bytes;
+  }
+
+  const word* GraphFileReader::readWords(size_t count)
+  {
+    if (count > static_cast< size_t >(end_ - current_) / sizeof(word))
+    {
+      throw std::runtime_error("Graph file is too short");
+    }
+    const word* result = reinterpret_cast< const word* >(current_);
+    current_ += count * sizeof(word);
+    return result;
+  }
+
+  FileHeader GraphFileReader::readFileHeader()
+  {
+    const char* start = current_;
+    skip(sizeof(FileHeader));
+    FileHeader header;
+    std::memcpy(&header, start, sizeof(header));
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version)
+    {
+      throw std::runtime_error("Invalid graph file");
+    }
+    return header;
+  }
+
+  averenkov::Array< std::string > GraphFileReader::readStrings(size_t count)
+  {
+    if (count >= static_cast< size_t >(end_ - current_))
+    {
+      throw std::runtime_error("Graph file is too short");
+    }
+    const word* offsets = readWords(count + 1);
+    const char* chars = current_;
+    skip(offsets[count]);
+    skip((sizeof(word) - (current_ - begin_) % sizeof(word)) % sizeof(word));
+    averenkov::Array< std::string > strings(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (offsets[i] > offsets[i + 1] || offsets[i + 1] > offsets[count])
+      {
+        throw std::runtime_error("Invalid graph data");
+      }
+      strings[i].assign(chars + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+    return strings;
+  }
+
+  void GraphFileReader::readGraph(const averenkov::Array< std::string >& strings,
+      averenkov::Tree< std::string, averenkov::Graph >& graphs)
+  {
+    const word* header = readWords(sizeof(GraphHeader) / sizeof(word));
+    GraphHeader graphHeader = { header[0], header[1], header[2] };
+    const word* names = readWords(graphHeader.vertexCount);
+    const word* offsets = readWords(graphHeader.vertexCount + 1);
+    const word* targets = readWords(graphHeader.edgeCount);
+    const word* weights = readWords(graphHeader.edgeCount);
+    if (graphHeader.name >= strings.size() || offsets[graphHeader.vertexCount] != graphHeader.edgeCount)
+    {
+      throw std::runtime_error("Invalid graph data");
+    }
+    averenkov::Graph& graph = graphs[strings[graphHeader.name]];
+    graph = averenkov::Graph();
+    graph.reserve(graphHeader.vertexCount);
+    for (size_t i = 0; i < graphHeader.vertexCount; ++i)
+    {
+      if (names[i] >= strings.size() || offsets[i] > offsets[i + 1])
+      {
+        throw std::runtime_error("Invalid graph data");
+      }
+      graph.addVertex(strings[names[i]]);
+    }
+    for (size_t i = 0; i < graphHeader.vertexCount; ++i)
+    {
+      if (offsets[i] == offsets[i + 1])
+      {
+        continue;
+      }
+      averenkov::Graph::Targets targetWeights;
+      targetWeights.reserve(offsets[i + 1] - offsets[i]);
+      for (size_t e = offsets[i]; e < offsets[i + 1]; ++e)
+      {
+        if (targets[e] >= graphHeader.vertexCount)
+        {
+          throw std::runtime_error("Invalid graph data");
+        }
+        targetWeights[strings[names[targets[e]]]].push_back(weights[e]);
+      }
+      graph.addEdges(strings[names[i]], std::move(targetWeights));
+    }
+  }
+
+  void writeWords(std::ostream& out, const word* data, size_t count)
+  {
+    out.write(reinterpret_cast< const char* >(data), count * sizeof(word));
+  }
+
+  size_t internString(averenkov::HashTable< std::string, size_t >& ids, averenkov::Array< std::string >& strings,
+      const std::string& str)
+  {
+    auto inserted = ids.insert({ str, strings.size() });
+    if (inserted.second)
+    {
+      strings.push_back(str);
+    }
+    return inserted.first->value;
+  }
+}
+
+bool averenkov::isBinaryGraphs(std::istream& in)
+{
+  char head[sizeof(magic)] = {};
+  std::istream::pos_type start = in.tellg();
+  in.read(head, sizeof(head));
+  bool result = in && std::memcmp(head, magic, sizeof(magic)) == 0;
+  in.clear();
+  in.seekg(start);
+  return result;
+}
+
+void averenkov::loadBinaryGraphs(Tree< std::string, Graph >& graphs, const std::string& filename)
+{
+  GraphFileReader reader(filename);
+  FileHeader header = reader.readFileHeader();
+  Array< std::string > strings = reader.readStrings(header.stringCount);
+  for (size_t g = 0; g < header.graphCount; ++g)
+  {
+    reader.readGraph(strings, graphs);
+  }
+}
+
+void averenkov::saveBinaryGraphs(const Tree< std::string, Graph >& graphs, std::ostream& out)
+{
+  HashTable< std::string, size_t > ids;
+  Array< std::string > strings;
+  size_t graphCount = 0;
+  for (auto it = graphs.cbegin(); it != graphs.cend(); ++it)
+  {
+    internString(ids, strings, it->first);
+    const GraphSnapshot& snapshot = it->second.snapshot();
+    for (size_t i = 0; i < snapshot.names.size(); ++i)
+    {
+      internString(ids, strings, snapshot.names[i]);
+    }
+    ++graphCount;
+  }
+
+  FileHeader header = { { magic[0], magic[1], magic[2], magic[3] }, version, strings.size(), graphCount };
+  out.write(reinterpret_cast< const char* >(&header), sizeof(header));
+  Array< word > stringOffsets(strings.size() + 1);
+  for (size_t i = 0; i < strings.size(); ++i)
+  {
+    stringOffsets[i + 1] = stringOffsets[i] + strings[i].size();
+  }
+  writeWords(out, stringOffsets.get_data(), stringOffsets.size());
+  for (size_t i = 0; i < strings.size(); ++i)
+  {
+    out.write(strings[i].data(), strings[i].size());
+  }
+  const char padding[sizeof(word)] = {};
+  out.write(padding, (sizeof(word) - stringOffsets[strings.size()] % sizeof(word)) % sizeof(word));
+
+  for (auto it = graphs.cbegin(); it != graphs.cend(); ++it)
+  {
+    const GraphSnapshot& snapshot = it->second.snapshot();
+    const size_t vertexCount = snapshot.names.size();
+    Array< word > names(vertexCount);
+    Array< word > offsets(vertexCount + 1);
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+      names[i] = ids.at(snapshot.names[i]);
+      const size_t lastEdge = snapshot.outOffsets[i + 1];
+      offsets[i + 1] = offsets[i];
+      for (size_t e = snapshot.outOffsets[i]; e < lastEdge; ++e)
+      {
+        offsets[i + 1] += snapshot.weightOffsets[e + 1] - snapshot.weightOffsets[e];
+      }
+    }
+    const size_t edgeCount = offsets[vertexCount];
+    Array< word > targets(edgeCount);
+    Array< word > weights(edgeCount);
+    size_t pos = 0;
+    for (size_t e = 0; e < snapshot.outTargets.size(); ++e)
+    {
+      for (size_t w = snapshot.weightOffsets[e]; w < snapshot.weightOffsets[e + 1]; ++w)
+      {
+        targets[pos] = snapshot.outTargets[e];
+        weights[pos++] = snapshot.weights[w];
+      }
+    }
+    GraphHeader graphHeader = { ids.at(it->first), vertexCount, edgeCount };
+    out.write(reinterpret_cast< const char* >(&graphHeader), sizeof(graphHeader));
+    writeWords(out, names.get_data(), vertexCount);
+    writeWords(out, offsets.get_data(), vertexCount + 1);
+    writeWords(out, targets.get_data(), edgeCount);
+    writeWords(out, weights.get_data(), edgeCount);
+  }
+  if (!out)
+  {
+    throw std::runtime_error("Error writing file");
+  }
+}
@@ -0,0 +1,17 @@
+#ifndef BINARY_GRAPHS_HPP
+#define BINARY_GRAPHS_HPP
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <graph.hpp>
+#include <BiTree.hpp>
+
+namespace averenkov
+{
+  bool isBinaryGraphs(std::istream& in);
+  void loadBinaryGraphs(Tree< std::string, Graph >& graphs, const std::string& filename);
+  void saveBinaryGraphs(const Tree< std::string, Graph >& graphs, std::ostream& out);
+}
+
+#endif
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <cctype>
 #include <limits>
+#include <utility>
 
 namespace
 {
@@ -17,6 +18,15 @@ namespace
       vertices.push_back(vertex);
     }
   }
+
+  void printWeights(std::ostream& out, const averenkov::GraphSnapshot& snapshot, size_t edge)
+  {
+    for (size_t i = snapshot.weightOffsets[edge]; i < snapshot.weightOffsets[edge + 1]; ++i)
+    {
+      out << " " << snapshot.weights[i];
+    }
+    out << "\n";
+  }
 }
 
 void averenkov::loadGraphsFromFile(Tree< std::string, Graph >& graphs, std::istream& in)
@@ -78,34 +88,15 @@ void averenkov::printVertices(std::ostream& out, std::istream& in, const Tree< s
   {
     throw std::invalid_argument("Invalid command");
   }
-  Array< std::string > vertexNames;
-  for (auto vit = it->second.vertices.begin(); vit != it->second.vertices.end(); ++vit)
-  {
-    vertexNames.push_back(vit->key);
-  }
-  for (size_t i = 0; i < vertexNames.size(); ++i)
-  {
-    size_t minIndex = i;
-    for (size_t j = i + 1; j < vertexNames.size(); ++j)
-    {
-      if (vertexNames[j] < vertexNames[minIndex])
-      {
-        minIndex = j;
-      }
-    }
-    if (minIndex != i)
-    {
-      std::swap(vertexNames[i], vertexNames[minIndex]);
-    }
-  }
-  if (vertexNames.empty())
+  const GraphSnapshot& snapshot = it->second.snapshot();
+  if (snapshot.names.empty())
   {
     out << "\n";
     return;
   }
-  for (size_t i = 0; i < vertexNames.size(); ++i)
+  for (size_t i = 0; i < snapshot.names.size(); ++i)
   {
-    out << vertexNames[i] << "\n";
+    out << snapshot.names[i] << "\n";
   }
 }
 
@@ -115,58 +106,23 @@ void averenkov::printOutbound(std::ostream& out, std::istream& in, const Tree< s
   std::string vertex;
   in >> graphName >> vertex;
   auto it = graphs.find(graphName);
-  if (it == graphs.end() || it->second.vertices.find(vertex) == it->second.vertices.end())
+  if (it == graphs.end() || it->second.vertices().find(vertex) == it->second.vertices().end())
   {
     throw std::invalid_argument("Invalid command");
   }
-  auto edgesIt = it->second.edges.find(vertex);
-  if (edgesIt == it->second.edges.end())
-  {
-    out << "\n";
-    return;
-  }
-  Array< std::string > targets;
-  Tree< std::string, Array< size_t > > weightsMap;
-  for (auto it = edgesIt->value.begin(); it != edgesIt->value.end(); ++it)
-  {
-    targets.push_back(it->key);
-    weightsMap.insert({it->key, it->value});
-  }
-  for (size_t i = 0; i < targets.size(); ++i)
-  {
-    for (size_t j = i + 1; j < targets.size(); ++j)
-    {
-      if (targets[j] < targets[i])
-      {
-        std::swap(targets[i], targets[j]);
-      }
-    }
-  }
-  if (targets.empty())
+  const GraphSnapshot& snapshot = it->second.snapshot();
+  const size_t id = snapshot.find(vertex);
+  const size_t first = snapshot.outOffsets[id];
+  const size_t last = snapshot.outOffsets[id + 1];
+  if (first == last)
   {
     out << "\n";
     return;
   }
-  for (size_t i = 0; i < targets.size(); ++i)
+  for (size_t i = first; i < last; ++i)
   {
-    auto weightsIt = weightsMap.find(targets[i]);
-    out << targets[i];
-    Array< size_t > weights = weightsIt->second;
-    for (size_t j = 0; j < weights.size(); ++j)
-    {
-      for (size_t k = j + 1; k < weights.size(); ++k)
-      {
-        if (weights[k] < weights[j])
-        {
-          std::swap(weights[j], weights[k]);
-        }
-      }
-    }
-    for (size_t j = 0; j < weights.size(); ++j)
-    {
-      out << " " << weights[j];
-    }
-    out << "\n";
+    out << snapshot.names[snapshot.outTargets[i]];
+    printWeights(out, snapshot, i);
   }
 }
 
@@ -179,54 +135,16 @@ void averenkov::printInbound(std::ostream& out, std::istream& in, const Tree< st
   {
     throw std::invalid_argument("Graph not found");
   }
-  if (graphIt->second.vertices.find(vertex) == graphIt->second.vertices.end())
+  if (graphIt->second.vertices().find(vertex) == graphIt->second.vertices().end())
   {
     throw std::invalid_argument("Invalid command");
   }
-  Array< std::string > sources;
-  Tree< std::string, Array< size_t > > weightsMap;
-  for (auto fromIt = graphIt->second.edges.begin(); fromIt != graphIt->second.edges.end(); ++fromIt)
-  {
-    for (auto toIt = fromIt->value.begin(); toIt != fromIt->value.end(); ++toIt)
-    {
-      if (toIt->key == vertex)
-      {
-        sources.push_back(fromIt->key);
-        weightsMap.insert({fromIt->key, toIt->value});
-        break;
-      }
-    }
-  }
-  for (size_t i = 0; i < sources.size(); ++i)
+  const GraphSnapshot& snapshot = graphIt->second.snapshot();
+  const size_t id = snapshot.find(vertex);
+  for (size_t i = snapshot.inOffsets[id]; i < snapshot.inOffsets[id + 1]; ++i)
   {
-    for (size_t j = i + 1; j < sources.size(); ++j)
-    {
-      if (sources[j] < sources[i])
-      {
-        std::swap(sources[i], sources[j]);
-      }
-    }
-  }
-  for (size_t i = 0; i < sources.size(); ++i)
-  {
-    auto weightsIt = weightsMap.find(sources[i]);
-    Array< size_t > weights = weightsIt->second;
-    for (size_t j = 0; j < weights.size(); ++j)
-    {
-      for (size_t k = j + 1; k < weights.size(); ++k)
-      {
-        if (weights[k] < weights[j])
-        {
-          std::swap(weights[j], weights[k]);
-        }
-      }
-    }
-    out << sources[i];
-    for (size_t j = 0; j < weights.size(); ++j)
-    {
-      out << " " << weights[j];
-    }
-    out << "\n";
+    out << snapshot.names[snapshot.inSources[i]];
+    printWeights(out, snapshot, snapshot.inEdges[i]);
   }
 }
 
@@ -256,38 +174,10 @@ void averenkov::cutEdge(std::istream& in, Tree< std::string, Graph >& graphs)
   {
     throw std::invalid_argument("Graph not found");
   }
-  auto fromIt = graphIt->second.edges.find(from);
-  if (fromIt == graphIt->second.edges.end())
+  if (!graphIt->second.cutEdge(from, to, weight))
   {
     throw std::invalid_argument("Edge not found");
   }
-  auto toIt = fromIt->value.find(to);
-  if (toIt == fromIt->value.end())
-  {
-    throw std::invalid_argument("Edge not found");
-  }
-  bool found = false;
-  for (size_t i = 0; i < toIt->value.size(); ++i)
-  {
-    if (toIt->value[i] == weight)
-    {
-      for (size_t j = i; j < toIt->value.size() - 1; ++j)
-      {
-        toIt->value[j] = toIt->value[j + 1];
-      }
-      toIt->value.pop_back();
-      found = true;
-      break;
-    }
-  }
-  if (!found)
-  {
-    throw std::invalid_argument("Weight not found");
-  }
-  if (toIt->value.empty())
-  {
-    fromIt->value.erase(to);
-  }
 }
 
 void averenkov::createGraph(std::istream& in, Tree< std::string, Graph >& graphs)
@@ -327,62 +217,9 @@ void averenkov::mergeGraphs(std::istream& in, Tree< std::string, Graph >& graphs
   {
     throw std::invalid_argument("Graph not found");
   }
-  Graph mergedGraph;
+  Graph mergedGraph = merge(it1->second, it2->second);
   mergedGraph.name = newGraph;
-  for (auto it = it1->second.vertices.begin(); it != it1->second.vertices.end(); ++it)
-  {
-    mergedGraph.vertices.insert({it->key, true});
-  }
-  for (auto it = it2->second.vertices.begin(); it != it2->second.vertices.end(); ++it)
-  {
-    mergedGraph.vertices.insert({it->key, true});
-  }
-  for (auto fromIt = it1->second.edges.begin(); fromIt != it1->second.edges.end(); ++fromIt)
-  {
-    for (auto toIt = fromIt->value.begin(); toIt != fromIt->value.end(); ++toIt)
-    {
-      auto mergedToIt = mergedGraph.edges.find(fromIt->key);
-      if (mergedToIt == mergedGraph.edges.end())
-      {
-        HashTable< std::string, Array< size_t > > newMap;
-        newMap.insert({toIt->key, toIt->value});
-        mergedGraph.edges.insert({fromIt->key, newMap});
-      }
-      else
-      {
-        mergedToIt->value.insert({toIt->key, toIt->value});
-      }
-    }
-  }
-  for (auto fromIt = it2->second.edges.begin(); fromIt != it2->second.edges.end(); ++fromIt)
-  {
-    for (auto toIt = fromIt->value.begin(); toIt != fromIt->value.end(); ++toIt)
-    {
-      auto mergedToIt = mergedGraph.edges.find(fromIt->key);
-      if (mergedToIt == mergedGraph.edges.end())
-      {
-        HashTable< std::string, Array< size_t > > newMap;
-        newMap.insert({toIt->key, toIt->value});
-        mergedGraph.edges.insert({fromIt->key, newMap});
-      }
-      else
-      {
-        auto existingWeightsIt = mergedToIt->value.find(toIt->key);
-        if (existingWeightsIt == mergedToIt->value.end())
-        {
-          mergedToIt->value.insert({toIt->key, toIt->value});
-        }
-        else
-        {
-          for (size_t i = 0; i < toIt->value.size(); ++i)
-          {
-            existingWeightsIt->value.push_back(toIt->value[i]);
-          }
-        }
-      }
-    }
-  }
-  graphs.insert({newGraph, mergedGraph});
+  graphs[newGraph] = std::move(mergedGraph);
 }
 
 void averenkov::extractGraph(std::istream& in, Tree< std::string, Graph >& graphs)
@@ -403,7 +240,7 @@ void averenkov::extractGraph(std::istream& in, Tree< std::string, Graph >& graph
   readVertices(in, count, vertices);
   for (size_t i = 0; i < vertices.size(); ++i)
   {
-    if (oldGraphIt->second.vertices.find(vertices[i]) == oldGraphIt->second.vertices.end())
+    if (oldGraphIt->second.vertices().find(vertices[i]) == oldGraphIt->second.vertices().end())
     {
       throw std::invalid_argument("Vertex not found in source graph");
     }
@@ -412,13 +249,15 @@ void averenkov::extractGraph(std::istream& in, Tree< std::string, Graph >& graph
   extractedGraph.name = newGraph;
   for (size_t i = 0; i < vertices.size(); ++i)
   {
-    extractedGraph.vertices.insert({vertices[i], true});
+    extractedGraph.addVertex(vertices[i]);
   }
+  const Graph::Edges& oldEdges = oldGraphIt->second.edges();
   for (size_t i = 0; i < vertices.size(); ++i)
   {
-    auto fromIt = oldGraphIt->second.edges.find(vertices[i]);
-    if (fromIt != oldGraphIt->second.edges.end())
+    auto fromIt = oldEdges.find(vertices[i]);
+    if (fromIt != oldEdges.end() && extractedGraph.edges().find(vertices[i]) == extractedGraph.edges().end())
     {
+      Graph::Targets targets;
       for (auto toIt = fromIt->value.begin(); toIt != fromIt->value.end(); ++toIt)
       {
         bool targetFound = false;
@@ -432,19 +271,13 @@ void averenkov::extractGraph(std::istream& in, Tree< std::string, Graph >& graph
         }
         if (targetFound)
         {
-          auto extractedToIt = extractedGraph.edges.find(vertices[i]);
-          if (extractedToIt == extractedGraph.edges.end())
-          {
-            HashTable< std::string, Array< size_t > > newMap;
-            newMap.insert({toIt->key, toIt->value});
-            extractedGraph.edges.insert({vertices[i], newMap});
-          }
-          else
-          {
-            extractedToIt->value.insert({toIt->key, toIt->value});
-          }
+          targets.insert({toIt->key, toIt->value});
         }
       }
+      if (!targets.empty())
+      {
+        extractedGraph.addEdges(vertices[i], std::move(targets));
+      }
     }
   }
   graphs.insert({newGraph, extractedGraph});
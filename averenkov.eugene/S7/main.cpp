@@ -6,16 +6,19 @@
 #include <graph.hpp>
 #include <BiTree.hpp>
 #include "commands.hpp"
+#include "binaryGraphs.hpp"
 
 int main(int argc, char* argv[])
 {
   using namespace averenkov;
-  if (argc != 2)
+  const bool isConvert = argc == 4 && std::string(argv[1]) == "--convert";
+  if (argc != 2 && !isConvert)
   {
     std::cerr << "Error\n";
     return 1;
   }
-  std::ifstream file(argv[1]);
+  const char * fileName = argv[isConvert ? 2 : 1];
+  std::ifstream file(fileName, std::ios::binary);
   if (!file)
   {
     std::cerr << "Error opening file\n";
@@ -23,7 +26,34 @@ int main(int argc, char* argv[])
   }
 
   Tree< std::string, Graph > graphs;
-  loadGraphsFromFile(graphs, file);
+  try
+  {
+    if (isBinaryGraphs(file))
+    {
+      file.close();
+      loadBinaryGraphs(graphs, fileName);
+    }
+    else
+    {
+      loadGraphsFromFile(graphs, file);
+    }
+    if (isConvert)
+    {
+      std::ofstream binary(argv[3], std::ios::binary);
+      if (!binary)
+      {
+        std::cerr << "Error opening file\n";
+        return 1;
+      }
+      saveBinaryGraphs(graphs, binary);
+      return 0;
+    }
+  }
+  catch (const std::exception & e)
+  {
+    std::cerr << e.what() << "\n";
+    return 1;
+  }
 
   Tree< std::string, std::function< void() > > cmds;
   commandsInit(cmds, graphs);
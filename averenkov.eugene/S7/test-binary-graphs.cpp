@@ -0,0 +1,108 @@
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include "binaryGraphs.hpp"
+#include "commands.hpp"
+
+namespace
+{
+  using averenkov::Graph;
+  using Graphs = averenkov::Tree< std::string, Graph >;
+
+  const char* const graphText = "g1 3 a b 1 b c 2 a b 4\ng2 2 x y 7 y x 7\n";
+
+  std::multiset< std::string > describe(const Graphs& graphs)
+  {
+    std::multiset< std::string > result;
+    for (auto it = graphs.begin(); it != graphs.end(); ++it)
+    {
+      const Graph& graph = it->second;
+      for (auto v = graph.vertices().begin(); v != graph.vertices().end(); ++v)
+      {
+        result.insert(it->first + ' ' + v->key);
+      }
+      for (auto from = graph.edges().begin(); from != graph.edges().end(); ++from)
+      {
+        for (auto to = from->value.begin(); to != from->value.end(); ++to)
+        {
+          for (size_t i = 0; i < to->value.size(); ++i)
+          {
+            result.insert(it->first + ' ' + from->key + ' ' + to->key + ' ' + std::to_string(to->value[i]));
+          }
+        }
+      }
+    }
+    return result;
+  }
+
+  std::string saveToString(const Graphs& graphs)
+  {
+    std::ostringstream out(std::ios::binary);
+    averenkov::saveBinaryGraphs(graphs, out);
+    return out.str();
+  }
+
+  void writeFile(const std::string& filename, const std::string& data)
+  {
+    std::ofstream out(filename, std::ios::binary);
+    out.write(data.data(), data.size());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(BinaryGraphsTests)
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+  Graphs graphs;
+  std::istringstream text(graphText);
+  averenkov::loadGraphsFromFile(graphs, text);
+  const std::string filename = "test-binary-graphs.bin";
+  writeFile(filename, saveToString(graphs));
+  std::ifstream in(filename, std::ios::binary);
+  BOOST_TEST(averenkov::isBinaryGraphs(in));
+  in.close();
+  Graphs loaded;
+  averenkov::loadBinaryGraphs(loaded, filename);
+  std::remove(filename.c_str());
+  BOOST_TEST(loaded.size() == graphs.size());
+  BOOST_TEST((describe(loaded) == describe(graphs)));
+}
+
+BOOST_AUTO_TEST_CASE(TextIsNotBinary)
+{
+  std::istringstream text(graphText);
+  BOOST_TEST(!averenkov::isBinaryGraphs(text));
+}
+
+BOOST_AUTO_TEST_CASE(TruncatedFileThrows)
+{
+  Graphs graphs;
+  std::istringstream text(graphText);
+  averenkov::loadGraphsFromFile(graphs, text);
+  const std::string data = saveToString(graphs);
+  const std::string filename = "test-binary-graphs-truncated.bin";
+  for (size_t size: { size_t(4), size_t(16), data.size() / 2, data.size() - 1 })
+  {
+    writeFile(filename, data.substr(0, size));
+    Graphs loaded;
+    BOOST_CHECK_THROW(averenkov::loadBinaryGraphs(loaded, filename), std::runtime_error);
+  }
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(DataSkipsPoppedFront)
+{
+  averenkov::Array< size_t > words;
+  words.push_back(1);
+  words.push_back(2);
+  words.push_back(3);
+  words.pop_front();
+  BOOST_TEST(words.get_data()[0] == 2);
+  const averenkov::Array< size_t >& view = words;
+  BOOST_TEST(view.get_data() + view.size() == &view[0] + 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -157,6 +157,24 @@ BOOST_AUTO_TEST_CASE(TableExpansion)
 
   BOOST_TEST(table.size() == 50);
   BOOST_TEST(table.load_factor() <= table.max_load_factor());
+  for (int i = 0; i < 50; ++i)
+  {
+    BOOST_TEST((table.find(i) != table.end()));
+  }
+  BOOST_TEST(std::distance(table.begin(), table.end()) == 50);
+}
+
+BOOST_AUTO_TEST_CASE(EraseInsertChurn)
+{
+  IntStringTable table;
+  table.insert({ 0, "churn" });
+  for (int i = 1; i < 1000; ++i)
+  {
+    table.insert({ i, "churn" });
+    table.erase(i - 1);
+  }
+  BOOST_TEST(table.size() == 1);
+  BOOST_TEST(table.find(999)->value == "churn");
 }
 
 BOOST_AUTO_TEST_CASE(MoveOperations)
@@ -55,13 +55,13 @@ namespace averenkov
   template< class T >
   T* Array< T >::get_data()
   {
-    return data_;
+    return data_ + first_;
   }
 
   template< class T >
   const T* Array< T >::get_data() const
   {
-    return data_;
+    return data_ + first_;
   }
 
   template< class T >
@@ -1,17 +1,202 @@
 #include "graph.hpp"
+#include <algorithm>
+
+namespace
+{
+  struct EdgeRef
+  {
+    size_t from;
+    size_t to;
+    const averenkov::Array< size_t >* weights;
+  };
+
+  struct OutboundOrder
+  {
+    const EdgeRef* refs;
+    bool operator()(size_t lhs, size_t rhs) const
+    {
+      return refs[lhs].from < refs[rhs].from || (refs[lhs].from == refs[rhs].from && refs[lhs].to < refs[rhs].to);
+    }
+  };
+
+  struct InboundOrder
+  {
+    const EdgeRef* refs;
+    bool operator()(size_t lhs, size_t rhs) const
+    {
+      return refs[lhs].to < refs[rhs].to || (refs[lhs].to == refs[rhs].to && refs[lhs].from < refs[rhs].from);
+    }
+  };
+
+  void fillOffsets(averenkov::Array< size_t >& offsets, const averenkov::Array< size_t >& keys)
+  {
+    size_t* data = offsets.get_data();
+    const size_t* key = keys.get_data();
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+      ++data[key[i] + 1];
+    }
+    for (size_t i = 1; i < offsets.size(); ++i)
+    {
+      data[i] += data[i - 1];
+    }
+  }
+
+  struct EdgeRange
+  {
+    const averenkov::GraphSnapshot* snapshot;
+    size_t first;
+    size_t last;
+
+    bool empty() const
+    {
+      return first == last;
+    }
+
+    const std::string& target() const
+    {
+      return snapshot->names[snapshot->outTargets[first]];
+    }
+
+    const size_t* weightsBegin() const
+    {
+      return snapshot->weights.get_data() + snapshot->weightOffsets[first];
+    }
+
+    const size_t* weightsEnd() const
+    {
+      return snapshot->weights.get_data() + snapshot->weightOffsets[first + 1];
+    }
+  };
+
+  EdgeRange outboundRange(const averenkov::GraphSnapshot& snapshot, size_t vertex, bool isPresent)
+  {
+    if (!isPresent)
+    {
+      return { std::addressof(snapshot), 0, 0 };
+    }
+    return { std::addressof(snapshot), snapshot.outOffsets[vertex], snapshot.outOffsets[vertex + 1] };
+  }
+
+  std::shared_ptr< const averenkov::GraphSnapshot > buildSnapshot(const averenkov::Graph& graph)
+  {
+    using averenkov::Array;
+    auto result = std::make_shared< averenkov::GraphSnapshot >();
+    averenkov::GraphSnapshot& snapshot = *result;
+
+    Array< std::string > names(graph.vertices().size());
+    std::string* namesData = names.get_data();
+    for (auto it = graph.vertices().begin(); it != graph.vertices().end(); ++it)
+    {
+      *namesData++ = it->key;
+    }
+    std::sort(names.get_data(), names.get_data() + names.size());
+    snapshot.names.swap(names);
+
+    size_t edgeCount = 0;
+    size_t weightCount = 0;
+    for (auto fromIt = graph.edges().begin(); fromIt != graph.edges().end(); ++fromIt)
+    {
+      edgeCount += fromIt->value.size();
+      for (auto toIt = fromIt->value.begin(); toIt != fromIt->value.end(); ++toIt)
+      {
+        weightCount += toIt->value.size();
+      }
+    }
+    Array< EdgeRef > refs(edgeCount);
+    EdgeRef* refsData = refs.get_data();
+    size_t count = 0;
+    for (auto fromIt = graph.edges().begin(); fromIt != graph.edges().end(); ++fromIt)
+    {
+      const size_t from = snapshot.find(fromIt->key);
+      for (auto toIt = fromIt->value.begin(); toIt != fromIt->value.end(); ++toIt)
+      {
+        const size_t to = snapshot.find(toIt->key);
+        if (from != snapshot.npos && to != snapshot.npos)
+        {
+          refsData[count++] = { from, to, std::addressof(toIt->value) };
+        }
+      }
+    }
+
+    Array< size_t > order(count);
+    size_t* orderData = order.get_data();
+    for (size_t i = 0; i < count; ++i)
+    {
+      orderData[i] = i;
+    }
+    std::sort(orderData, orderData + count, OutboundOrder{ refsData });
+    Array< size_t > outSources(count);
+    Array< size_t > outTargets(count);
+    Array< size_t > weightOffsets(count + 1);
+    Array< size_t > weights(weightCount);
+    size_t* weightsData = weights.get_data();
+    size_t weightPos = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      const EdgeRef& ref = refsData[orderData[i]];
+      outSources[i] = ref.from;
+      outTargets[i] = ref.to;
+      weightOffsets[i] = weightPos;
+      const size_t* run = ref.weights->get_data();
+      std::copy(run, run + ref.weights->size(), weightsData + weightPos);
+      std::sort(weightsData + weightPos, weightsData + weightPos + ref.weights->size());
+      weightPos += ref.weights->size();
+    }
+    weightOffsets[count] = weightPos;
+    Array< size_t > outOffsets(snapshot.names.size() + 1);
+    fillOffsets(outOffsets, outSources);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      refsData[i] = { outSources[i], outTargets[i], nullptr };
+      orderData[i] = i;
+    }
+    std::sort(orderData, orderData + count, InboundOrder{ refsData });
+    Array< size_t > inTargets(count);
+    Array< size_t > inSources(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      inTargets[i] = refsData[orderData[i]].to;
+      inSources[i] = refsData[orderData[i]].from;
+    }
+    Array< size_t > inOffsets(snapshot.names.size() + 1);
+    fillOffsets(inOffsets, inTargets);
+
+    snapshot.outOffsets.swap(outOffsets);
+    snapshot.outTargets.swap(outTargets);
+    snapshot.weightOffsets.swap(weightOffsets);
+    snapshot.weights.swap(weights);
+    snapshot.inOffsets.swap(inOffsets);
+    snapshot.inSources.swap(inSources);
+    snapshot.inEdges.swap(order);
+    return result;
+  }
+}
+
+constexpr size_t averenkov::GraphSnapshot::npos;
+
+size_t averenkov::GraphSnapshot::find(const std::string& vertex) const
+{
+  const std::string* first = names.get_data();
+  const std::string* last = first + names.size();
+  const std::string* pos = std::lower_bound(first, last, vertex);
+  return pos != last && *pos == vertex ? pos - first : npos;
+}
 
 void averenkov::Graph::addEdge(const std::string& from, const std::string& to, size_t weight)
 {
-  vertices.insert({from, true});
-  vertices.insert({to, true});
-  auto toMapIt = edges.find(from);
-  if (toMapIt == edges.end())
+  invalidate();
+  vertices_.insert({from, true});
+  vertices_.insert({to, true});
+  auto toMapIt = edges_.find(from);
+  if (toMapIt == edges_.end())
   {
-    HashTable< std::string, Array< size_t > > newMap;
+    Targets newMap;
     Array< size_t > weights;
     weights.push_back(weight);
     newMap.insert({to, weights});
-    edges.insert({from, newMap});
+    edges_.insert({from, newMap});
   }
   else
   {
@@ -29,11 +214,152 @@ void averenkov::Graph::addEdge(const std::string& from, const std::string& to, s
   }
 }
 
+void averenkov::Graph::addEdges(const std::string& from, Targets targets)
+{
+  invalidate();
+  vertices_.insert({from, true});
+  for (auto toIt = targets.begin(); toIt != targets.end(); ++toIt)
+  {
+    vertices_.insert({toIt->key, true});
+  }
+  auto toMapIt = edges_.find(from);
+  if (toMapIt == edges_.end())
+  {
+    edges_.emplace(from, std::move(targets));
+    return;
+  }
+  for (auto toIt = targets.begin(); toIt != targets.end(); ++toIt)
+  {
+    Array< size_t >& weights = toMapIt->value[toIt->key];
+    for (size_t i = 0; i < toIt->value.size(); ++i)
+    {
+      weights.push_back(toIt->value[i]);
+    }
+  }
+}
+
+bool averenkov::Graph::cutEdge(const std::string& from, const std::string& to, size_t weight)
+{
+  auto toMapIt = edges_.find(from);
+  if (toMapIt == edges_.end())
+  {
+    return false;
+  }
+  auto weightsIt = toMapIt->value.find(to);
+  if (weightsIt == toMapIt->value.end())
+  {
+    return false;
+  }
+  Array< size_t >& weights = weightsIt->value;
+  for (size_t i = 0; i < weights.size(); ++i)
+  {
+    if (weights[i] == weight)
+    {
+      invalidate();
+      for (size_t j = i; j < weights.size() - 1; ++j)
+      {
+        weights[j] = weights[j + 1];
+      }
+      weights.pop_back();
+      if (weights.empty())
+      {
+        toMapIt->value.erase(to);
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
 void averenkov::Graph::addVertex(const std::string& vertex)
 {
-  if (vertices.find(vertex) == vertices.end())
+  invalidate();
+  if (vertices_.find(vertex) == vertices_.end())
+  {
+    vertices_.insert({vertex, true});
+  }
+}
+
+void averenkov::Graph::reserve(size_t vertexCount)
+{
+  vertices_.reserve(vertexCount);
+  edges_.reserve(vertexCount);
+}
+
+const averenkov::Graph::Edges& averenkov::Graph::edges() const noexcept
+{
+  return edges_;
+}
+
+const averenkov::Graph::Vertices& averenkov::Graph::vertices() const noexcept
+{
+  return vertices_;
+}
+
+void averenkov::Graph::invalidate() noexcept
+{
+  snapshot_.reset();
+}
+
+const averenkov::GraphSnapshot& averenkov::Graph::snapshot() const
+{
+  if (!snapshot_)
   {
-    vertices.insert({vertex, true});
+    snapshot_ = buildSnapshot(*this);
   }
+  return *snapshot_;
 }
 
+averenkov::Graph averenkov::merge(const Graph& first, const Graph& second)
+{
+  const GraphSnapshot& lhs = first.snapshot();
+  const GraphSnapshot& rhs = second.snapshot();
+  Graph result;
+  result.reserve(lhs.names.size() + rhs.names.size());
+  size_t i = 0;
+  size_t j = 0;
+  while (i < lhs.names.size() || j < rhs.names.size())
+  {
+    const bool isLhs = j == rhs.names.size() || (i < lhs.names.size() && !(rhs.names[j] < lhs.names[i]));
+    const bool isRhs = i == lhs.names.size() || (j < rhs.names.size() && !(lhs.names[i] < rhs.names[j]));
+    const std::string& name = isLhs ? lhs.names[i] : rhs.names[j];
+    result.vertices_.emplace(name, true);
+    EdgeRange lhsEdges = outboundRange(lhs, i, isLhs);
+    EdgeRange rhsEdges = outboundRange(rhs, j, isRhs);
+    if (!lhsEdges.empty() || !rhsEdges.empty())
+    {
+      Graph::Targets targets;
+      targets.reserve((lhsEdges.last - lhsEdges.first) + (rhsEdges.last - rhsEdges.first));
+      while (!lhsEdges.empty() || !rhsEdges.empty())
+      {
+        const bool isLhsEdge = rhsEdges.empty() || (!lhsEdges.empty() && !(rhsEdges.target() < lhsEdges.target()));
+        const bool isRhsEdge = lhsEdges.empty() || (!rhsEdges.empty() && !(lhsEdges.target() < rhsEdges.target()));
+        const size_t lhsCount = isLhsEdge ? lhsEdges.weightsEnd() - lhsEdges.weightsBegin() : 0;
+        const size_t rhsCount = isRhsEdge ? rhsEdges.weightsEnd() - rhsEdges.weightsBegin() : 0;
+        Array< size_t > weights(lhsCount + rhsCount);
+        const size_t* lhsWeights = isLhsEdge ? lhsEdges.weightsBegin() : nullptr;
+        const size_t* rhsWeights = isRhsEdge ? rhsEdges.weightsBegin() : nullptr;
+        std::merge(lhsWeights, lhsWeights + lhsCount, rhsWeights, rhsWeights + rhsCount, weights.get_data());
+        targets.emplace(isLhsEdge ? lhsEdges.target() : rhsEdges.target(), std::move(weights));
+        if (isLhsEdge)
+        {
+          ++lhsEdges.first;
+        }
+        if (isRhsEdge)
+        {
+          ++rhsEdges.first;
+        }
+      }
+      result.edges_.emplace(name, std::move(targets));
+    }
+    if (isLhs)
+    {
+      ++i;
+    }
+    if (isRhs)
+    {
+      ++j;
+    }
+  }
+  return result;
+}
@@ -1,22 +1,56 @@
 #ifndef GRAPH_HPP
 #define GRAPH_HPP
 
+#include <memory>
 #include <string>
 #include <array.hpp>
 #include <hashTable.hpp>
 
 namespace averenkov
 {
+  struct GraphSnapshot
+  {
+    static constexpr size_t npos = static_cast< size_t >(-1);
+
+    Array< std::string > names;
+    Array< size_t > outOffsets;
+    Array< size_t > outTargets;
+    Array< size_t > weightOffsets;
+    Array< size_t > weights;
+    Array< size_t > inOffsets;
+    Array< size_t > inSources;
+    Array< size_t > inEdges;
+
+    size_t find(const std::string& vertex) const;
+  };
+
   struct Graph
   {
+    using Targets = HashTable< std::string, Array< size_t > >;
+    using Edges = HashTable< std::string, Targets >;
+    using Vertices = HashTable< std::string, bool >;
+
     std::string name;
-    HashTable< std::string, HashTable< std::string, Array< size_t > > > edges;
-    HashTable< std::string, bool > vertices;
     void addEdge(const std::string& from, const std::string& to, size_t weight);
+    void addEdges(const std::string& from, Targets targets);
+    bool cutEdge(const std::string& from, const std::string& to, size_t weight);
     void addVertex(const std::string& vertex);
+    void reserve(size_t vertexCount);
+    const Edges& edges() const noexcept;
+    const Vertices& vertices() const noexcept;
+    const GraphSnapshot& snapshot() const;
+
+  private:
+    Edges edges_;
+    Vertices vertices_;
+    mutable std::shared_ptr< const GraphSnapshot > snapshot_;
+
+    void invalidate() noexcept;
+    friend Graph merge(const Graph& first, const Graph& second);
   };
 
+  Graph merge(const Graph& first, const Graph& second);
+
 }
 
 #endif
-
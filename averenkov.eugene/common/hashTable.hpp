@@ -78,6 +78,7 @@ namespace averenkov
   private:
     Array< detail::Bucket< Key, Value > > table_;
     size_t size_ = 0;
+    size_t deleted_ = 0;
     Hash hasher_;
     Equal key_equal_;
     float max_load_factor_ = 0.75;
@@ -90,7 +91,7 @@ namespace averenkov
   template < class Key, class Value, class Hash, class Equal >
   size_t HashTable< Key, Value, Hash, Equal >::probe(size_t hash, size_t i) const noexcept
   {
-    return (hash + i * i) % table_.size();
+    return (hash + i) % table_.size();
   }
 
   template < class Key, class Value, class Hash, class Equal >
@@ -110,6 +111,7 @@ namespace averenkov
   HashTable< Key, Value, Hash, Equal >::HashTable(const HashTable& other):
     table_(other.table_),
     size_(other.size_),
+    deleted_(other.deleted_),
     hasher_(other.hasher_),
     key_equal_(other.key_equal_),
     max_load_factor_(other.max_load_factor_)
@@ -119,11 +121,13 @@ namespace averenkov
   HashTable< Key, Value, Hash, Equal >::HashTable(HashTable&& other) noexcept:
     table_(std::move(other.table_)),
     size_(other.size_),
+    deleted_(other.deleted_),
     hasher_(std::move(other.hasher_)),
     key_equal_(std::move(other.key_equal_)),
     max_load_factor_(other.max_load_factor_)
   {
     other.size_ = 0;
+    other.deleted_ = 0;
   }
 
   template < class Key, class Value, class Hash, class Equal >
@@ -146,6 +150,7 @@ namespace averenkov
     {
       table_ = other.table_;
       size_ = other.size_;
+      deleted_ = other.deleted_;
       hasher_ = other.hasher_;
       key_equal_ = other.key_equal_;
       max_load_factor_ = other.max_load_factor_;
@@ -160,10 +165,12 @@ namespace averenkov
     {
       table_ = std::move(other.table_);
       size_ = other.size_;
+      deleted_ = other.deleted_;
       hasher_ = std::move(other.hasher_);
       key_equal_ = std::move(other.key_equal_);
       max_load_factor_ = other.max_load_factor_;
       other.size_ = 0;
+      other.deleted_ = 0;
     }
     return *this;
   }
@@ -253,6 +260,7 @@ namespace averenkov
       table_[i].deleted = false;
     }
     size_ = 0;
+    deleted_ = 0;
   }
 
   template < class Key, class Value, class Hash, class Equal >
@@ -267,9 +275,10 @@ namespace averenkov
   std::pair< typename HashTable< Key, Value, Hash, Equal >::iterator, bool >
     HashTable< Key, Value, Hash, Equal >::emplace(K&& key, V&& value)
   {
-    if (size_ + 1 > max_load_factor_ * table_.size())
+    if (size_ + deleted_ + 1 > max_load_factor_ * table_.size())
     {
-      rehash(table_.size() * 2);
+      bool grow = size_ + 1 > max_load_factor_ * table_.size() / 2;
+      rehash(grow ? table_.size() * 2 : table_.size());
     }
     size_t hash = hasher_(key) % table_.size();
     size_t i = 0;
@@ -301,9 +310,10 @@ namespace averenkov
     if (first_deleted != table_.size())
     {
       index = first_deleted;
+      --deleted_;
     }
-    table_[index].key = key;
-    table_[index].value = value;
+    table_[index].key = std::forward< K >(key);
+    table_[index].value = std::forward< V >(value);
     table_[index].occupied = true;
     table_[index].deleted = false;
     ++size_;
@@ -339,6 +349,7 @@ namespace averenkov
     table_[index].occupied = false;
     table_[index].deleted = true;
     size_--;
+    deleted_++;
 
     auto next = pos;
     ++next;
@@ -373,6 +384,7 @@ namespace averenkov
   {
     table_.swap(other.table_);
     std::swap(size_, other.size_);
+    std::swap(deleted_, other.deleted_);
     std::swap(hasher_, other.hasher_);
     std::swap(key_equal_, other.key_equal_);
     std::swap(max_load_factor_, other.max_load_factor_);
@@ -512,10 +524,6 @@ namespace averenkov
   {
     count = next_prime(count);
     Array< detail::Bucket < Key, Value > > new_table(count);
-    for (size_t i = 0; i < count; ++i)
-    {
-      new_table.push_back(detail::Bucket< Key, Value >());
-    }
 
     for (size_t i = 0; i < table_.size(); ++i)
     {
@@ -527,7 +535,7 @@ namespace averenkov
 
         while (j < count)
         {
-          size_t current_index = (index + j * j) % count;
+          size_t current_index = (index + j) % count;
           if (!new_table[current_index].occupied)
           {
             new_table[current_index].key = std::move(bucket.key);
@@ -540,6 +548,7 @@ namespace averenkov
       }
     }
     table_ = std::move(new_table);
+    deleted_ = 0;
   }
 
   template < class Key, class Value, class Hash, class Equal >
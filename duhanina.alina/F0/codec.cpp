@@ -0,0 +1,797 @@
+#include "codec.hpp"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <tree.hpp>
+
+namespace
+{
+  void assign_code_lengths(const duhanina::DynamicArray< std::pair< char, size_t > >& symbols, size_t first, size_t last, unsigned depth, duhanina::CodeTable& table)
+  {
+    if (last - first == 1)
+    {
+      table.code_lengths[duhanina::symbol_index(symbols[first].first)] = std::min(depth, 255u);
+      return;
+    }
+    size_t total = 0;
+    for (size_t i = first; i < last; i++)
+    {
+      total += symbols[i].second;
+    }
+    size_t left = 0;
+    size_t split = first;
+    while (split < last - 1)
+    {
+      size_t next = left + symbols[split].second;
+      size_t next_diff = next * 2 > total ? next * 2 - total : total - next * 2;
+      size_t diff = left * 2 > total ? left * 2 - total : total - left * 2;
+      if (split != first && next_diff >= diff)
+      {
+        break;
+      }
+      left = next;
+      split++;
+    }
+    assign_code_lengths(symbols, first, split, depth + 1, table);
+    assign_code_lengths(symbols, split, last, depth + 1, table);
+  }
+
+  duhanina::Tree< std::string, duhanina::CachedHistogram, std::less< std::string > > histogram_cache;
+
+  bool same_file_state(const duhanina::CachedHistogram& cached, const struct stat& info)
+  {
+    return cached.device == info.st_dev && cached.inode == info.st_ino && cached.size == info.st_size
+      && cached.mtime_sec == info.st_mtim.tv_sec && cached.mtime_nsec == info.st_mtim.tv_nsec;
+  }
+
+  void write_word(std::ostream& out, std::uint64_t word)
+  {
+    for (size_t i = 0; i < sizeof(word); i++)
+    {
+      char byte = (word >> (8 * i)) & 0xFF;
+      out.put(byte);
+    }
+  }
+
+  std::uint64_t read_word(const char* data)
+  {
+    std::uint64_t word = 0;
+    for (size_t i = 0; i < sizeof(word); i++)
+    {
+      word |= static_cast< std::uint64_t >(static_cast< unsigned char >(data[i])) << (8 * i);
+    }
+    return word;
+  }
+
+  template < class Task >
+  void run_parallel(size_t count, unsigned threads, Task task)
+  {
+    threads = std::min< size_t >(threads, count);
+    if (threads <= 1)
+    {
+      for (size_t i = 0; i < count; i++)
+      {
+        task(i);
+      }
+      return;
+    }
+    std::atomic< size_t > next(0);
+    std::unique_ptr< std::exception_ptr[] > errors(new std::exception_ptr[threads]);
+    auto worker = [&](unsigned thread)
+    {
+      try
+      {
+        for (size_t i = next++; i < count; i = next++)
+        {
+          task(i);
+        }
+      }
+      catch (...)
+      {
+        errors[thread] = std::current_exception();
+        next = count;
+      }
+    };
+    std::unique_ptr< std::thread[] > pool(new std::thread[threads - 1]);
+    unsigned started = 0;
+    try
+    {
+      for (; started < threads - 1; started++)
+      {
+        pool[started] = std::thread(worker, started + 1);
+      }
+    }
+    catch (const std::system_error&)
+    {
+      // threads that failed to start leave their indices to the ones running
+    }
+    catch (...)
+    {
+      next = count;
+      for (unsigned i = 0; i < started; i++)
+      {
+        pool[i].join();
+      }
+      throw;
+    }
+    worker(0);
+    for (unsigned i = 0; i < started; i++)
+    {
+      pool[i].join();
+    }
+    for (unsigned i = 0; i < threads; i++)
+    {
+      if (errors[i])
+      {
+        std::rethrow_exception(errors[i]);
+      }
+    }
+  }
+
+  bool choose_local_table(const duhanina::Histogram& histogram, size_t global_bits, duhanina::CodeTable& local)
+  {
+    size_t symbols = 0;
+    for (size_t i = 0; i < duhanina::ALPHABET_SIZE; i++)
+    {
+      symbols += histogram.counts[i] != 0;
+    }
+    if (symbols < 2)
+    {
+      return false;
+    }
+    local = duhanina::build_code_table(histogram);
+    return duhanina::encoded_bit_count(histogram, local) / 8 + duhanina::ALPHABET_SIZE < global_bits / 8;
+  }
+
+  size_t block_payload_size(const duhanina::Histogram& histogram, const duhanina::CodeTable& table)
+  {
+    size_t global_bits = duhanina::encoded_bit_count(histogram, table);
+    duhanina::CodeTable local;
+    if (choose_local_table(histogram, global_bits, local))
+    {
+      return duhanina::ALPHABET_SIZE + (duhanina::encoded_bit_count(histogram, local) + 7) / 8;
+    }
+    return (global_bits + 7) / 8;
+  }
+
+  void encode_block(duhanina::str_t text, const duhanina::CodeTable& table, const duhanina::CanonicalCodes& codes, duhanina::BlockEntry& entry, std::string& payload)
+  {
+    duhanina::Histogram histogram;
+    duhanina::add_counts(text.data(), text.size(), histogram);
+    size_t global_bits = duhanina::encoded_bit_count(histogram, table);
+    std::ostringstream packed;
+    duhanina::BitWriter writer(packed);
+    duhanina::CodeTable local;
+    entry.has_table = choose_local_table(histogram, global_bits, local);
+    if (entry.has_table)
+    {
+      packed.write(reinterpret_cast< const char* >(local.code_lengths), duhanina::ALPHABET_SIZE);
+      duhanina::encode_symbols(text.data(), text.size(), duhanina::CanonicalCodes(local), writer);
+    }
+    else
+    {
+      duhanina::encode_symbols(text.data(), text.size(), codes, writer);
+    }
+    writer.flush();
+    entry.bit_count = writer.bit_count();
+    payload = packed.str();
+    entry.byte_count = payload.size();
+  }
+
+  void decode_block(duhanina::str_t payload, const duhanina::BlockEntry& entry, const duhanina::CanonicalCodes& codes, size_t expected, std::string& text)
+  {
+    std::ostringstream decoded;
+    size_t table_size = 0;
+    if (entry.has_table)
+    {
+      duhanina::CodeTable local;
+      std::copy(payload.begin(), payload.begin() + duhanina::ALPHABET_SIZE, local.code_lengths);
+      if (duhanina::symbol_count(local) < 2 || !duhanina::is_prefix_code(local))
+      {
+        throw std::runtime_error("INVALID_CODES");
+      }
+      table_size = duhanina::ALPHABET_SIZE;
+      duhanina::BitReader reader(payload.data() + table_size, payload.size() - table_size);
+      duhanina::decode_bits(reader, entry.bit_count, duhanina::CanonicalCodes(local), decoded);
+    }
+    else
+    {
+      duhanina::BitReader reader(payload.data(), payload.size());
+      duhanina::decode_bits(reader, entry.bit_count, codes, decoded);
+    }
+    text = decoded.str();
+    if (text.size() != expected)
+    {
+      throw std::runtime_error("INVALID_CODES");
+    }
+  }
+}
+
+unsigned char duhanina::symbol_index(char c)
+{
+  return static_cast< unsigned char >(c);
+}
+
+void duhanina::limit_code_lengths(CodeTable& table)
+{
+  const std::uint64_t capacity = static_cast< std::uint64_t >(1) << MAX_CODE_LENGTH;
+  std::uint64_t kraft = 0;
+  for (size_t i = 0; i < ALPHABET_SIZE; i++)
+  {
+    if (table.code_lengths[i] > MAX_CODE_LENGTH)
+    {
+      table.code_lengths[i] = MAX_CODE_LENGTH;
+    }
+    if (table.code_lengths[i] != 0)
+    {
+      kraft += static_cast< std::uint64_t >(1) << (MAX_CODE_LENGTH - table.code_lengths[i]);
+    }
+  }
+  while (kraft > capacity)
+  {
+    size_t longest = ALPHABET_SIZE;
+    for (size_t i = 0; i < ALPHABET_SIZE; i++)
+    {
+      unsigned length = table.code_lengths[i];
+      if (length != 0 && length < MAX_CODE_LENGTH && (longest == ALPHABET_SIZE || length > table.code_lengths[longest]))
+      {
+        longest = i;
+      }
+    }
+    kraft -= static_cast< std::uint64_t >(1) << (MAX_CODE_LENGTH - table.code_lengths[longest] - 1);
+    table.code_lengths[longest]++;
+  }
+}
+
+bool duhanina::is_prefix_code(const CodeTable& table)
+{
+  std::uint64_t kraft = 0;
+  for (size_t i = 0; i < ALPHABET_SIZE; i++)
+  {
+    unsigned length = table.code_lengths[i];
+    if (length > MAX_CODE_LENGTH)
+    {
+      return false;
+    }
+    if (length != 0)
+    {
+      kraft += static_cast< std::uint64_t >(1) << (MAX_CODE_LENGTH - length);
+    }
+  }
+  return kraft <= (static_cast< std::uint64_t >(1) << MAX_CODE_LENGTH);
+}
+
+size_t duhanina::symbol_count(const CodeTable& table)
+{
+  size_t count = 0;
+  for (size_t i = 0; i < ALPHABET_SIZE; i++)
+  {
+    if (table.code_lengths[i] != 0)
+    {
+      count++;
+    }
+  }
+  return count;
+}
+
+std::string duhanina::code_string(std::uint32_t code, unsigned length)
+{
+  std::string result(length, '0');
+  for (unsigned i = 0; i < length; i++)
+  {
+    if ((code >> (length - 1 - i)) & 1)
+    {
+      result[i] = '1';
+    }
+  }
+  return result;
+}
+
+duhanina::CanonicalCodes::CanonicalCodes(const CodeTable& table):
+  codes(),
+  lengths(),
+  max_length(0),
+  first_code(),
+  counts(),
+  offsets(),
+  sorted_symbols(),
+  lookup()
+{
+  for (size_t i = 0; i < ALPHABET_SIZE; i++)
+  {
+    lengths[i] = table.code_lengths[i];
+    counts[lengths[i]]++;
+    max_length = std::max< unsigned >(max_length, lengths[i]);
+  }
+  counts[0] = 0;
+  std::uint64_t next_code[MAX_CODE_LENGTH + 1] = {};
+  std::uint64_t code = 0;
+  std::uint32_t offset = 0;
+  for (unsigned length = 1; length <= MAX_CODE_LENGTH; length++)
+  {
+    code = (code + counts[length - 1]) << 1;
+    first_code[length] = code;
+    next_code[length] = code;
+    offsets[length] = offset;
+    offset += counts[length];
+  }
+  for (size_t i = 0; i < ALPHABET_SIZE; i++)
+  {
+    unsigned length = lengths[i];
+    if (length == 0)
+    {
+      continue;
+    }
+    codes[i] = static_cast< std::uint32_t >(next_code[length]++);
+    sorted_symbols[offsets[length] + (codes[i] - first_code[length])] = static_cast< unsigned char >(i);
+    if (length <= LOOKUP_BITS)
+    {
+      size_t first = static_cast< size_t >(codes[i]) << (LOOKUP_BITS - length);
+      size_t last = static_cast< size_t >(codes[i] + 1) << (LOOKUP_BITS - length);
+      for (size_t j = first; j < last; j++)
+      {
+        lookup[j] = static_cast< std::uint16_t >((i << 8) | length);
+      }
+    }
+  }
+}
+
+duhanina::BitWriter::BitWriter(std::ostream& out):
+  out_(out),
+  bytes_(),
+  buffer_(0),
+  count_(0),
+  total_(0)
+{
+  bytes_.reserve(BLOCK_SIZE);
+}
+
+void duhanina::BitWriter::write(std::uint32_t code, unsigned length)
+{
+  buffer_ = (buffer_ << length) | code;
+  count_ += length;
+  total_ += length;
+  while (count_ >= 8)
+  {
+    count_ -= 8;
+    bytes_.push_back(static_cast< char >(buffer_ >> count_));
+  }
+  if (bytes_.size() >= BLOCK_SIZE)
+  {
+    write_bytes();
+  }
+}
+
+void duhanina::BitWriter::flush()
+{
+  if (count_ > 0)
+  {
+    bytes_.push_back(static_cast< char >(buffer_ << (8 - count_)));
+    count_ = 0;
+  }
+  write_bytes();
+}
+
+size_t duhanina::BitWriter::bit_count() const
+{
+  return total_;
+}
+
+void duhanina::BitWriter::write_bytes()
+{
+  out_.write(bytes_.data(), bytes_.size());
+  bytes_.clear();
+}
+
+duhanina::BitReader::BitReader(std::istream& in):
+  in_(&in),
+  bytes_(BLOCK_SIZE, '\0'),
+  data_(bytes_.data()),
+  size_(0),
+  pos_(0),
+  buffer_(0),
+  count_(0)
+{}
+
+duhanina::BitReader::BitReader(const char* data, size_t size):
+  in_(nullptr),
+  bytes_(),
+  data_(data),
+  size_(size),
+  pos_(0),
+  buffer_(0),
+  count_(0)
+{}
+
+std::uint32_t duhanina::BitReader::peek(unsigned length)
+{
+  while (count_ <= 56)
+  {
+    if (pos_ == size_ && in_ && *in_)
+    {
+      in_->read(&bytes_[0], BLOCK_SIZE);
+      size_ = in_->gcount();
+      pos_ = 0;
+    }
+    std::uint64_t byte = pos_ < size_ ? static_cast< unsigned char >(data_[pos_++]) : 0;
+    buffer_ |= byte << (56 - count_);
+    count_ += 8;
+  }
+  return static_cast< std::uint32_t >(buffer_ >> (64 - length));
+}
+
+void duhanina::BitReader::skip(unsigned length)
+{
+  buffer_ <<= length;
+  count_ -= length;
+}
+
+void duhanina::add_counts(const char* data, size_t size, Histogram& histogram)
+{
+  size_t counts[4][ALPHABET_SIZE] = {};
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4)
+  {
+    counts[0][symbol_index(data[i])]++;
+    counts[1][symbol_index(data[i + 1])]++;
+    counts[2][symbol_index(data[i + 2])]++;
+    counts[3][symbol_index(data[i + 3])]++;
+  }
+  for (; i < size; i++)
+  {
+    counts[0][symbol_index(data[i])]++;
+  }
+  for (size_t j = 0; j < ALPHABET_SIZE; j++)
+  {
+    histogram.counts[j] += counts[0][j] + counts[1][j] + counts[2][j] + counts[3][j];
+  }
+  histogram.total += size;
+}
+
+duhanina::CachedHistogram duhanina::cached_histogram(str_t filename)
+{
+  struct stat info;
+  if (::stat(filename.c_str(), &info) == -1)
+  {
+    throw std::runtime_error("FILE_NOT_FOUND");
+  }
+  auto it = histogram_cache.find(filename);
+  if (it != histogram_cache.end() && same_file_state(it->second, info))
+  {
+    return it->second;
+  }
+  std::ifstream in(filename, std::ios::binary);
+  if (!in)
+  {
+    throw std::runtime_error("FILE_NOT_FOUND");
+  }
+  CachedHistogram cached;
+  cached.device = info.st_dev;
+  cached.inode = info.st_ino;
+  cached.mtime_sec = info.st_mtim.tv_sec;
+  cached.mtime_nsec = info.st_mtim.tv_nsec;
+  cached.size = info.st_size;
+  std::vector< char > buffer(CONTAINER_BLOCK_SIZE);
+  while (in.read(buffer.data(), buffer.size()) || in.gcount() > 0)
+  {
+    Histogram block;
+    add_counts(buffer.data(), in.gcount(), block);
+    for (size_t i = 0; i < ALPHABET_SIZE; i++)
+    {
+      cached.histogram.counts[i] += block.counts[i];
+    }
+    cached.histogram.total += block.total;
+    cached.blocks.push_back(block);
+  }
+  histogram_cache[filename] = cached;
+  return cached;
+}
+
+duhanina::Histogram duhanina::file_histogram(str_t filename)
+{
+  return cached_histogram(filename).histogram;
+}
+
+bool duhanina::same_histogram(const Histogram& lhs, const Histogram& rhs)
+{
+  return lhs.total == rhs.total && std::equal(lhs.counts, lhs.counts + ALPHABET_SIZE, rhs.counts);
+}
+
+duhanina::CodeTable duhanina::build_code_table(const Histogram& histogram)
+{
+  if (histogram.total == 0)
+  {
+    throw std::runtime_error("EMPTY");
+  }
+  DynamicArray< std::pair< char, size_t > > sorted_freq;
+  for (int c = CHAR_MIN; c <= CHAR_MAX; c++)
+  {
+    size_t count = histogram.counts[symbol_index(static_cast< char >(c))];
+    if (count != 0)
+    {
+      sorted_freq.push_back(std::make_pair(static_cast< char >(c), count));
+    }
+  }
+  if (sorted_freq.size() == 1)
+  {
+    throw std::runtime_error("SINGLE_SYMBOL");
+  }
+  auto by_count = [](const std::pair< char, size_t >& lhs, const std::pair< char, size_t >& rhs)
+  {
+    return lhs.second > rhs.second;
+  };
+  std::stable_sort(&sorted_freq[0], &sorted_freq[0] + sorted_freq.size(), by_count);
+  CodeTable table;
+  table.total_chars = histogram.total;
+  assign_code_lengths(sorted_freq, 0, sorted_freq.size(), 0, table);
+  limit_code_lengths(table);
+  return table;
+}
+
+size_t duhanina::encoded_bit_count(const Histogram& histogram, const CodeTable& table)
+{
+  size_t bits = 0;
+  for (size_t i = 0; i < ALPHABET_SIZE; i++)
+  {
+    if (histogram.counts[i] != 0 && table.code_lengths[i] == 0)
+    {
+      throw std::runtime_error("INVALID_CODES");
+    }
+    bits += histogram.counts[i] * table.code_lengths[i];
+  }
+  return bits;
+}
+
+void duhanina::encode_symbols(const char* data, size_t count, const CanonicalCodes& codes, BitWriter& writer)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    unsigned char symbol = symbol_index(data[i]);
+    if (codes.lengths[symbol] == 0)
+    {
+      throw std::runtime_error("INVALID_CODES");
+    }
+    writer.write(codes.codes[symbol], codes.lengths[symbol]);
+  }
+}
+
+void duhanina::decode_bits(BitReader& reader, size_t bit_count, const CanonicalCodes& codes, std::ostream& out)
+{
+  std::string decoded;
+  decoded.reserve(BLOCK_SIZE);
+  size_t consumed = 0;
+  while (consumed < bit_count)
+  {
+    std::uint16_t entry = codes.lookup[reader.peek(LOOKUP_BITS)];
+    unsigned length = entry & 0xFF;
+    unsigned char symbol = static_cast< unsigned char >(entry >> 8);
+    if (entry == 0)
+    {
+      for (length = LOOKUP_BITS + 1; length <= codes.max_length; length++)
+      {
+        std::uint64_t index = reader.peek(length) - codes.first_code[length];
+        if (index < codes.counts[length])
+        {
+          symbol = codes.sorted_symbols[codes.offsets[length] + index];
+          break;
+        }
+      }
+      if (length > codes.max_length)
+      {
+        throw std::runtime_error("INVALID_CODES");
+      }
+    }
+    consumed += length;
+    if (consumed > bit_count)
+    {
+      throw std::runtime_error("INVALID_CODES");
+    }
+    reader.skip(length);
+    decoded.push_back(static_cast< char >(symbol));
+    if (decoded.size() == BLOCK_SIZE)
+    {
+      out.write(decoded.data(), decoded.size());
+      decoded.clear();
+    }
+  }
+  out.write(decoded.data(), decoded.size());
+}
+
+size_t duhanina::file_size(std::istream& in)
+{
+  in.seekg(0, std::ios::end);
+  size_t size = in.tellg();
+  in.seekg(0, std::ios::beg);
+  return size;
+}
+
+unsigned duhanina::default_threads()
+{
+  return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+bool duhanina::is_container(std::istream& in)
+{
+  char magic[sizeof(CONTAINER_MAGIC)] = {};
+  in.seekg(0, std::ios::beg);
+  in.read(magic, sizeof(magic));
+  bool result = in && std::equal(magic, magic + sizeof(magic), CONTAINER_MAGIC);
+  in.clear();
+  in.seekg(0, std::ios::beg);
+  return result;
+}
+
+size_t duhanina::read_bit_count(std::istream& in)
+{
+  size_t size = file_size(in);
+  char header[sizeof(std::uint64_t)];
+  if (size < sizeof(header) || !in.read(header, sizeof(header)))
+  {
+    throw std::runtime_error("INVALID_HEADER");
+  }
+  size_t bit_count = read_word(header);
+  if ((size - sizeof(header)) < bit_count / 8 + (bit_count % 8 != 0))
+  {
+    throw std::runtime_error("TRUNCATED_FILE");
+  }
+  return bit_count;
+}
+
+duhanina::Container duhanina::read_container(std::istream& in)
+{
+  size_t size = file_size(in);
+  if (size < CONTAINER_HEADER_SIZE)
+  {
+    throw std::runtime_error("INVALID_HEADER");
+  }
+  char header[CONTAINER_HEADER_SIZE];
+  in.read(header, sizeof(header));
+  Container container;
+  container.block_size = read_word(header + 8);
+  container.total_chars = read_word(header + 16);
+  std::uint64_t block_count = read_word(header + 24);
+  if (container.block_size == 0 || block_count != (container.total_chars + container.block_size - 1) / container.block_size)
+  {
+    throw std::runtime_error("INVALID_HEADER");
+  }
+  if (block_count > (size - CONTAINER_HEADER_SIZE) / BLOCK_ENTRY_SIZE)
+  {
+    throw std::runtime_error("TRUNCATED_FILE");
+  }
+  std::uint64_t data_start = CONTAINER_HEADER_SIZE + block_count * BLOCK_ENTRY_SIZE;
+  char entry_data[BLOCK_ENTRY_SIZE];
+  for (size_t i = 0; i < block_count; i++)
+  {
+    in.read(entry_data, sizeof(entry_data));
+    BlockEntry entry = { read_word(entry_data), read_word(entry_data + 8), read_word(entry_data + 16), read_word(entry_data + 24) };
+    if (entry.offset < data_start || entry.offset > size || entry.byte_count > size - entry.offset)
+    {
+      throw std::runtime_error("TRUNCATED_FILE");
+    }
+    size_t table_size = entry.has_table ? ALPHABET_SIZE : 0;
+    if (entry.byte_count < table_size || (entry.byte_count - table_size) < entry.bit_count / 8 + (entry.bit_count % 8 != 0))
+    {
+      throw std::runtime_error("TRUNCATED_FILE");
+    }
+    container.blocks.push_back(entry);
+  }
+  return container;
+}
+
+size_t duhanina::container_size(const CachedHistogram& cached, const CodeTable& table)
+{
+  size_t size = CONTAINER_HEADER_SIZE;
+  for (size_t i = 0; i < cached.blocks.size(); i++)
+  {
+    size += BLOCK_ENTRY_SIZE + block_payload_size(cached.blocks[i], table);
+  }
+  return size;
+}
+
+size_t duhanina::write_container(std::istream& in, size_t total_chars, const CodeTable& table, std::ostream& out, unsigned threads)
+{
+  CanonicalCodes codes(table);
+  size_t block_count = (total_chars + CONTAINER_BLOCK_SIZE - 1) / CONTAINER_BLOCK_SIZE;
+  size_t compressed_size = CONTAINER_HEADER_SIZE + block_count * BLOCK_ENTRY_SIZE;
+  out.write(CONTAINER_MAGIC, sizeof(CONTAINER_MAGIC));
+  write_word(out, CONTAINER_BLOCK_SIZE);
+  write_word(out, total_chars);
+  write_word(out, block_count);
+  DynamicArray< BlockEntry > entries;
+  const char empty_entry[BLOCK_ENTRY_SIZE] = {};
+  for (size_t i = 0; i < block_count; i++)
+  {
+    entries.push_back(BlockEntry());
+    out.write(empty_entry, sizeof(empty_entry));
+  }
+  size_t batch = 4 * threads;
+  DynamicArray< std::string > texts;
+  DynamicArray< std::string > payloads;
+  for (size_t i = 0; i < batch; i++)
+  {
+    texts.push_back(std::string());
+    payloads.push_back(std::string());
+  }
+  for (size_t start = 0; start < block_count; start += batch)
+  {
+    size_t count = std::min(batch, block_count - start);
+    for (size_t i = 0; i < count; i++)
+    {
+      texts[i].resize(std::min(CONTAINER_BLOCK_SIZE, total_chars - (start + i) * CONTAINER_BLOCK_SIZE));
+      if (!in.read(&texts[i][0], texts[i].size()))
+      {
+        throw std::runtime_error("FILE_NOT_FOUND");
+      }
+    }
+    run_parallel(count, threads, [&](size_t i)
+    {
+      encode_block(texts[i], table, codes, entries[start + i], payloads[i]);
+    });
+    for (size_t i = 0; i < count; i++)
+    {
+      entries[start + i].offset = compressed_size;
+      out.write(payloads[i].data(), payloads[i].size());
+      compressed_size += payloads[i].size();
+    }
+  }
+  out.seekp(CONTAINER_HEADER_SIZE);
+  for (size_t i = 0; i < block_count; i++)
+  {
+    write_word(out, entries[i].offset);
+    write_word(out, entries[i].byte_count);
+    write_word(out, entries[i].bit_count);
+    write_word(out, entries[i].has_table);
+  }
+  return compressed_size;
+}
+
+void duhanina::decode_container(std::istream& in, const Container& container, size_t first, size_t last, const CodeTable& table, std::ostream& out, unsigned threads)
+{
+  CanonicalCodes codes(table);
+  size_t block_size = container.block_size;
+  size_t first_block = first / block_size;
+  size_t last_block = (last + block_size - 1) / block_size;
+  size_t batch = 4 * threads;
+  DynamicArray< std::string > payloads;
+  DynamicArray< std::string > texts;
+  for (size_t i = 0; i < batch; i++)
+  {
+    payloads.push_back(std::string());
+    texts.push_back(std::string());
+  }
+  for (size_t start = first_block; start < last_block; start += batch)
+  {
+    size_t count = std::min(batch, last_block - start);
+    for (size_t i = 0; i < count; i++)
+    {
+      const BlockEntry& entry = container.blocks[start + i];
+      payloads[i].resize(entry.byte_count);
+      in.seekg(entry.offset);
+      if (!in.read(&payloads[i][0], entry.byte_count))
+      {
+        throw std::runtime_error("TRUNCATED_FILE");
+      }
+    }
+    run_parallel(count, threads, [&](size_t i)
+    {
+      size_t block_first = (start + i) * block_size;
+      size_t expected = std::min< size_t >(block_size, container.total_chars - block_first);
+      decode_block(payloads[i], container.blocks[start + i], codes, expected, texts[i]);
+    });
+    for (size_t i = 0; i < count; i++)
+    {
+      size_t block_first = (start + i) * block_size;
+      size_t from = std::max(first, block_first) - block_first;
+      size_t to = std::min(last, block_first + texts[i].size()) - block_first;
+      out.write(texts[i].data() + from, to - from);
+    }
+  }
+}
@@ -0,0 +1,130 @@
+#ifndef CODEC_HPP
+#define CODEC_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <sys/stat.h>
+#include <array.hpp>
+#include "shannonFano.hpp"
+
+namespace duhanina
+{
+  const size_t ALPHABET_SIZE = 256;
+  const unsigned MAX_CODE_LENGTH = 32;
+  const unsigned LOOKUP_BITS = 11;
+  const size_t BLOCK_SIZE = 65536;
+  const size_t CONTAINER_BLOCK_SIZE = 1 << 20;
+  const char CONTAINER_MAGIC[8] = { 'S', 'F', 'A', 'N', 'O', 'v', '2', '\0' };
+  const size_t CONTAINER_HEADER_SIZE = 32;
+  const size_t BLOCK_ENTRY_SIZE = 32;
+
+  struct CanonicalCodes
+  {
+    explicit CanonicalCodes(const CodeTable& table);
+
+    std::uint32_t codes[ALPHABET_SIZE];
+    unsigned char lengths[ALPHABET_SIZE];
+    unsigned max_length;
+    std::uint64_t first_code[MAX_CODE_LENGTH + 1];
+    std::uint32_t counts[MAX_CODE_LENGTH + 1];
+    std::uint32_t offsets[MAX_CODE_LENGTH + 1];
+    unsigned char sorted_symbols[ALPHABET_SIZE];
+    std::uint16_t lookup[static_cast< size_t >(1) << LOOKUP_BITS];
+  };
+
+  class BitWriter
+  {
+  public:
+    explicit BitWriter(std::ostream& out);
+    void write(std::uint32_t code, unsigned length);
+    void flush();
+    size_t bit_count() const;
+
+  private:
+    std::ostream& out_;
+    std::string bytes_;
+    std::uint64_t buffer_;
+    unsigned count_;
+    size_t total_;
+
+    void write_bytes();
+  };
+
+  class BitReader
+  {
+  public:
+    explicit BitReader(std::istream& in);
+    BitReader(const char* data, size_t size);
+    std::uint32_t peek(unsigned length);
+    void skip(unsigned length);
+
+  private:
+    std::istream* in_;
+    std::string bytes_;
+    const char* data_;
+    size_t size_;
+    size_t pos_;
+    std::uint64_t buffer_;
+    unsigned count_;
+  };
+
+  struct Histogram
+  {
+    size_t counts[ALPHABET_SIZE] = {};
+    size_t total = 0;
+  };
+
+  struct CachedHistogram
+  {
+    dev_t device = 0;
+    ino_t inode = 0;
+    time_t mtime_sec = 0;
+    long mtime_nsec = 0;
+    off_t size = 0;
+    Histogram histogram;
+    DynamicArray< Histogram > blocks;
+  };
+
+  struct BlockEntry
+  {
+    std::uint64_t offset;
+    std::uint64_t byte_count;
+    std::uint64_t bit_count;
+    std::uint64_t has_table;
+  };
+
+  struct Container
+  {
+    std::uint64_t block_size;
+    std::uint64_t total_chars;
+    DynamicArray< BlockEntry > blocks;
+  };
+
+  unsigned char symbol_index(char c);
+  void limit_code_lengths(CodeTable& table);
+  bool is_prefix_code(const CodeTable& table);
+  size_t symbol_count(const CodeTable& table);
+  std::string code_string(std::uint32_t code, unsigned length);
+
+  void add_counts(const char* data, size_t size, Histogram& histogram);
+  CachedHistogram cached_histogram(str_t filename);
+  Histogram file_histogram(str_t filename);
+  bool same_histogram(const Histogram& lhs, const Histogram& rhs);
+  CodeTable build_code_table(const Histogram& histogram);
+
+  size_t encoded_bit_count(const Histogram& histogram, const CodeTable& table);
+  void encode_symbols(const char* data, size_t count, const CanonicalCodes& codes, BitWriter& writer);
+  void decode_bits(BitReader& reader, size_t bit_count, const CanonicalCodes& codes, std::ostream& out);
+
+  unsigned default_threads();
+  size_t file_size(std::istream& in);
+  size_t container_size(const CachedHistogram& cached, const CodeTable& table);
+  size_t write_container(std::istream& in, size_t total_chars, const CodeTable& table, std::ostream& out, unsigned threads);
+  bool is_container(std::istream& in);
+  size_t read_bit_count(std::istream& in);
+  Container read_container(std::istream& in);
+  void decode_container(std::istream& in, const Container& container, size_t first, size_t last, const CodeTable& table, std::ostream& out, unsigned threads);
+}
+
+#endif
@@ -0,0 +1,180 @@
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include <sstream>
+#include "codec.hpp"
+
+namespace
+{
+  duhanina::CodeTable make_table(const std::string& text)
+  {
+    duhanina::Histogram histogram;
+    duhanina::add_counts(text.data(), text.size(), histogram);
+    return duhanina::build_code_table(histogram);
+  }
+
+  std::string encode(const std::string& text, const duhanina::CodeTable& table, size_t& bits)
+  {
+    std::ostringstream out;
+    duhanina::BitWriter writer(out);
+    duhanina::encode_symbols(text.data(), text.size(), duhanina::CanonicalCodes(table), writer);
+    writer.flush();
+    bits = writer.bit_count();
+    return out.str();
+  }
+
+  std::string decode(const std::string& packed, size_t bits, const duhanina::CodeTable& table)
+  {
+    std::ostringstream out;
+    duhanina::BitReader reader(packed.data(), packed.size());
+    duhanina::decode_bits(reader, bits, duhanina::CanonicalCodes(table), out);
+    return out.str();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(interleaved_histogram_test)
+{
+  std::string text = "abracadabra, the quick brown fox\n";
+  for (size_t size = 0; size <= text.size(); size++)
+  {
+    duhanina::Histogram histogram;
+    duhanina::add_counts(text.data(), size, histogram);
+    BOOST_TEST(histogram.total == size);
+    for (size_t c = 0; c < duhanina::ALPHABET_SIZE; c++)
+    {
+      size_t expected = 0;
+      for (size_t i = 0; i < size; i++)
+      {
+        expected += duhanina::symbol_index(text[i]) == c;
+      }
+      BOOST_TEST(histogram.counts[c] == expected);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(code_table_errors_test)
+{
+  duhanina::Histogram empty;
+  BOOST_CHECK_THROW(duhanina::build_code_table(empty), std::runtime_error);
+  duhanina::Histogram single;
+  duhanina::add_counts("aaaa", 4, single);
+  BOOST_CHECK_THROW(duhanina::build_code_table(single), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(canonical_codes_test)
+{
+  duhanina::CodeTable table;
+  table.code_lengths['a'] = 1;
+  table.code_lengths['b'] = 2;
+  table.code_lengths['c'] = 3;
+  table.code_lengths['d'] = 3;
+  duhanina::CanonicalCodes codes(table);
+  BOOST_TEST(duhanina::code_string(codes.codes['a'], codes.lengths['a']) == "0");
+  BOOST_TEST(duhanina::code_string(codes.codes['b'], codes.lengths['b']) == "10");
+  BOOST_TEST(duhanina::code_string(codes.codes['c'], codes.lengths['c']) == "110");
+  BOOST_TEST(duhanina::code_string(codes.codes['d'], codes.lengths['d']) == "111");
+  BOOST_TEST(codes.max_length == 3u);
+  BOOST_TEST(duhanina::is_prefix_code(table));
+  table.code_lengths['e'] = 3;
+  BOOST_TEST(!duhanina::is_prefix_code(table));
+}
+
+BOOST_AUTO_TEST_CASE(limit_code_lengths_test)
+{
+  duhanina::CodeTable table;
+  for (size_t i = 0; i < 40; i++)
+  {
+    table.code_lengths[i] = i + 1;
+  }
+  table.code_lengths[40] = 40;
+  BOOST_TEST(!duhanina::is_prefix_code(table));
+  duhanina::limit_code_lengths(table);
+  for (size_t i = 0; i <= 40; i++)
+  {
+    BOOST_TEST(table.code_lengths[i] != 0);
+    BOOST_TEST(table.code_lengths[i] <= duhanina::MAX_CODE_LENGTH);
+  }
+  BOOST_TEST(duhanina::symbol_count(table) == 41u);
+  BOOST_TEST(duhanina::is_prefix_code(table));
+}
+
+BOOST_AUTO_TEST_CASE(skewed_round_trip_test)
+{
+  std::string text;
+  size_t prev = 1;
+  size_t count = 1;
+  for (size_t c = 0; c < 40; c++)
+  {
+    text.append(count, static_cast< char >('0' + c));
+    size_t next = prev + count;
+    prev = count;
+    count = next;
+    if (count > 100000)
+    {
+      count = 1;
+      prev = 1;
+    }
+  }
+  duhanina::CodeTable table = make_table(text);
+  BOOST_TEST(duhanina::is_prefix_code(table));
+  size_t bits = 0;
+  std::string packed = encode(text, table, bits);
+  BOOST_TEST(decode(packed, bits, table) == text);
+}
+
+BOOST_AUTO_TEST_CASE(lookup_decoder_test)
+{
+  duhanina::CodeTable table;
+  for (size_t i = 0; i < 31; i++)
+  {
+    table.code_lengths['A' + i] = i + 1;
+  }
+  table.code_lengths['A' + 31] = 31;
+  BOOST_TEST(duhanina::is_prefix_code(table));
+  duhanina::CanonicalCodes codes(table);
+  BOOST_TEST(codes.max_length == 31u);
+  std::string text;
+  for (size_t i = 0; i < 32; i++)
+  {
+    text += static_cast< char >('A' + 31 - i);
+    text += static_cast< char >('A' + i);
+  }
+  size_t bits = 0;
+  std::string packed = encode(text, table, bits);
+  BOOST_TEST(decode(packed, bits, table) == text);
+  BOOST_CHECK_THROW(decode(packed, bits - 1, table), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(bit_buffers_boundary_test)
+{
+  std::mt19937 random(7);
+  std::string text;
+  for (size_t i = 0; i < 3 * duhanina::BLOCK_SIZE + 17; i++)
+  {
+    text += static_cast< char >('a' + random() % 26);
+  }
+  duhanina::CodeTable table = make_table(text);
+  std::ostringstream out;
+  duhanina::BitWriter writer(out);
+  duhanina::encode_symbols(text.data(), text.size(), duhanina::CanonicalCodes(table), writer);
+  BOOST_TEST(out.str().size() >= duhanina::BLOCK_SIZE);
+  writer.flush();
+  std::string packed = out.str();
+  BOOST_TEST(packed.size() == (writer.bit_count() + 7) / 8);
+  std::istringstream in(packed);
+  duhanina::BitReader reader(in);
+  std::ostringstream decoded;
+  duhanina::decode_bits(reader, writer.bit_count(), duhanina::CanonicalCodes(table), decoded);
+  BOOST_TEST(decoded.str() == text);
+}
+
+BOOST_AUTO_TEST_CASE(bit_count_header_test)
+{
+  std::string header(sizeof(size_t), '\0');
+  header[0] = 16;
+  std::istringstream truncated(header + "\xff");
+  BOOST_CHECK_THROW(duhanina::read_bit_count(truncated), std::runtime_error);
+  std::istringstream complete(header + "\xff\x80");
+  BOOST_TEST(duhanina::read_bit_count(complete) == 16u);
+  std::istringstream short_header(header.substr(1));
+  BOOST_CHECK_THROW(duhanina::read_bit_count(short_header), std::runtime_error);
+}
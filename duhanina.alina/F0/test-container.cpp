@@ -0,0 +1,174 @@
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include "codec.hpp"
+#include "shannonFano.hpp"
+
+namespace
+{
+  std::string make_text(size_t size, unsigned seed)
+  {
+    std::mt19937 random(seed);
+    std::string text(size, '\0');
+    for (size_t i = 0; i < size; i++)
+    {
+      size_t block = i / duhanina::CONTAINER_BLOCK_SIZE;
+      text[i] = static_cast< char >(block % 2 == 0 ? 'a' + random() % 8 : '0' + random() % 10);
+    }
+    return text;
+  }
+
+  void write_file(const std::string& filename, const std::string& text)
+  {
+    std::ofstream out(filename, std::ios::binary);
+    out.write(text.data(), text.size());
+  }
+
+  std::string read_file(const std::string& filename)
+  {
+    std::ifstream in(filename, std::ios::binary);
+    std::ostringstream out;
+    out << in.rdbuf();
+    return out.str();
+  }
+
+  duhanina::CodeTable make_table(const std::string& text)
+  {
+    duhanina::Histogram histogram;
+    duhanina::add_counts(text.data(), text.size(), histogram);
+    return duhanina::build_code_table(histogram);
+  }
+
+  std::string write_container(const std::string& text, const duhanina::CodeTable& table, unsigned threads)
+  {
+    std::istringstream in(text);
+    std::stringstream out;
+    size_t size = duhanina::write_container(in, text.size(), table, out, threads);
+    BOOST_TEST(size == out.str().size());
+    return out.str();
+  }
+
+  std::string decode_container(const std::string& packed, const duhanina::CodeTable& table, size_t first, size_t last, unsigned threads)
+  {
+    std::istringstream in(packed);
+    BOOST_TEST(duhanina::is_container(in));
+    duhanina::Container container = duhanina::read_container(in);
+    std::ostringstream out;
+    duhanina::decode_container(in, container, first, last, table, out, threads);
+    return out.str();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(container_layout_test)
+{
+  std::string text = make_text(2 * duhanina::CONTAINER_BLOCK_SIZE + 1000, 1);
+  duhanina::CodeTable table = make_table(text);
+  std::string packed = write_container(text, table, 1);
+  BOOST_TEST(std::equal(packed.data(), packed.data() + sizeof(duhanina::CONTAINER_MAGIC), duhanina::CONTAINER_MAGIC));
+  std::istringstream in(packed);
+  duhanina::Container container = duhanina::read_container(in);
+  BOOST_TEST(container.block_size == duhanina::CONTAINER_BLOCK_SIZE);
+  BOOST_TEST(container.total_chars == text.size());
+  BOOST_TEST(container.blocks.size() == 3u);
+  BOOST_TEST(container.blocks[0].offset == duhanina::CONTAINER_HEADER_SIZE + 3 * duhanina::BLOCK_ENTRY_SIZE);
+  BOOST_TEST(container.blocks[1].has_table == 1u);
+  std::string truncated = packed.substr(0, packed.size() - 1);
+  std::istringstream truncated_in(truncated);
+  BOOST_CHECK_THROW(duhanina::read_container(truncated_in), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_container_test)
+{
+  std::string text = make_text(5 * duhanina::CONTAINER_BLOCK_SIZE + 12345, 2);
+  duhanina::CodeTable table = make_table(text);
+  std::string serial = write_container(text, table, 1);
+  BOOST_TEST(write_container(text, table, 2) == serial);
+  BOOST_TEST(write_container(text, table, 4) == serial);
+  BOOST_TEST(decode_container(serial, table, 0, text.size(), 1) == text);
+  BOOST_TEST(decode_container(serial, table, 0, text.size(), 4) == text);
+}
+
+BOOST_AUTO_TEST_CASE(decode_range_test)
+{
+  std::string text = make_text(2 * duhanina::CONTAINER_BLOCK_SIZE + 77, 3);
+  duhanina::CodeTable table = make_table(text);
+  std::string packed = write_container(text, table, 2);
+  size_t boundary = duhanina::CONTAINER_BLOCK_SIZE;
+  BOOST_TEST(decode_container(packed, table, boundary - 10, boundary + 10, 2) == text.substr(boundary - 10, 20));
+  BOOST_TEST(decode_container(packed, table, boundary, boundary + 1, 1) == text.substr(boundary, 1));
+  BOOST_TEST(decode_container(packed, table, boundary - 1, boundary, 1) == text.substr(boundary - 1, 1));
+  BOOST_TEST(decode_container(packed, table, 5, 2 * boundary + 50, 3) == text.substr(5, 2 * boundary + 45));
+  BOOST_TEST(decode_container(packed, table, 42, 42, 1).empty());
+}
+
+BOOST_AUTO_TEST_CASE(container_size_test)
+{
+  std::string filename = "test-container-size.txt";
+  std::string text = make_text(3 * duhanina::CONTAINER_BLOCK_SIZE + 5, 4);
+  write_file(filename, text);
+  duhanina::CachedHistogram cached = duhanina::cached_histogram(filename);
+  duhanina::CodeTable table = duhanina::build_code_table(cached.histogram);
+  BOOST_TEST(cached.blocks.size() == 4u);
+  BOOST_TEST(duhanina::container_size(cached, table) == write_container(text, table, 1).size());
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(histogram_cache_test)
+{
+  std::string filename = "test-histogram-cache.txt";
+  write_file(filename, "aab");
+  duhanina::Histogram first = duhanina::file_histogram(filename);
+  BOOST_TEST(first.total == 3u);
+  BOOST_TEST(first.counts['a'] == 2u);
+  duhanina::CachedHistogram cached = duhanina::cached_histogram(filename);
+  BOOST_TEST(duhanina::same_histogram(cached.histogram, first));
+  BOOST_TEST(cached.blocks.size() == 1u);
+
+  write_file(filename, "bba");
+  duhanina::Histogram changed = duhanina::file_histogram(filename);
+  BOOST_TEST(changed.counts['b'] == 2u);
+  BOOST_TEST(!duhanina::same_histogram(changed, first));
+
+  std::string other = "test-histogram-cache-other.txt";
+  write_file(other, "ccc");
+  std::rename(other.c_str(), filename.c_str());
+  duhanina::CachedHistogram replaced = duhanina::cached_histogram(filename);
+  BOOST_TEST(replaced.inode != cached.inode);
+  BOOST_TEST(replaced.histogram.counts['c'] == 3u);
+  std::remove(filename.c_str());
+  BOOST_CHECK_THROW(duhanina::file_histogram(filename), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(round_trip_test)
+{
+  std::ostringstream out;
+  std::string text = make_text(duhanina::CONTAINER_BLOCK_SIZE + 3, 5);
+  write_file("test-round-trip.txt", text);
+  duhanina::build_codes("test-round-trip.txt", "round_trip", out);
+  duhanina::encode_file("test-round-trip.txt", "test-round-trip.sfano", "round_trip", out);
+  duhanina::decode_file("test-round-trip.sfano", "test-round-trip-out.txt", "round_trip", out);
+  BOOST_TEST(read_file("test-round-trip-out.txt") == text);
+  duhanina::decode_range("test-round-trip.sfano", "test-round-trip-out.txt", "round_trip", 1, 10, out);
+  BOOST_TEST(read_file("test-round-trip-out.txt") == text.substr(1, 10));
+
+  write_file("test-single.txt", "aaaaaaa");
+  BOOST_CHECK_THROW(duhanina::build_codes("test-single.txt", "single", out), std::runtime_error);
+  duhanina::encode_file("test-single.txt", "test-single.sfano", "round_trip", out);
+  duhanina::decode_file("test-single.sfano", "test-single-out.txt", "round_trip", out);
+  BOOST_TEST(read_file("test-single-out.txt") == "aaaaaaa");
+
+  write_file("test-empty.txt", "");
+  BOOST_CHECK_THROW(duhanina::build_codes("test-empty.txt", "empty", out), std::runtime_error);
+  duhanina::encode_file("test-empty.txt", "test-empty.sfano", "round_trip", out);
+  duhanina::decode_file("test-empty.sfano", "test-empty-out.txt", "round_trip", out);
+  BOOST_TEST(read_file("test-empty-out.txt").empty());
+
+  const char* files[] = { "test-round-trip.txt", "test-round-trip.sfano", "test-round-trip-out.txt", "test-single.txt",
+    "test-single.sfano", "test-single-out.txt", "test-empty.txt", "test-empty.sfano", "test-empty-out.txt" };
+  for (const char* file: files)
+  {
+    std::remove(file);
+  }
+}
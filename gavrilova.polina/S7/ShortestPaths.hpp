@@ -0,0 +1,337 @@
+#ifndef SHORTEST_PATHS_HPP
+#define SHORTEST_PATHS_HPP
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "HashTable.hpp"
+#include "WeightedGraph.hpp"
+
+namespace gavrilova {
+
+  template < typename Value >
+  class RadixHeap {
+  public:
+    using key_type = unsigned long long;
+    using value_type = std::pair< key_type, Value >;
+
+    RadixHeap();
+
+    void push(key_type key, const Value& value);
+    const value_type& top();
+    void pop();
+    void clear() noexcept;
+
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+
+  private:
+    static constexpr size_t buckets_count_ = std::numeric_limits< key_type >::digits + 1;
+
+    std::vector< value_type > buckets_[buckets_count_];
+    key_type last_;
+    size_t size_;
+
+    static size_t bucket_index(key_type key, key_type last) noexcept;
+    void redistribute();
+  };
+
+  template < typename Vertex, typename Weight >
+  class ShortestPathWorkspace {
+  public:
+    using graph_type = WeightedGraph< Vertex, Weight >;
+    using distance_type = unsigned long long;
+
+    ShortestPathWorkspace();
+
+    bool find_path(const graph_type& graph, const Vertex& from, const Vertex& to,
+        std::vector< Vertex >& path, distance_type& distance);
+    void find_distances(const graph_type& graph, const Vertex& from,
+        std::vector< std::pair< Vertex, distance_type > >& distances);
+
+  private:
+    enum Side {
+      FORWARD,
+      BACKWARD
+    };
+
+    bool is_cached_;
+    size_t revision_;
+    std::vector< Vertex > names_;
+    HashTable< Vertex, size_t > indices_;
+    std::vector< size_t > offsets_[2];
+    std::vector< size_t > targets_[2];
+    std::vector< Weight > weights_[2];
+
+    size_t epoch_;
+    distance_type best_;
+    size_t meeting_;
+    std::vector< size_t > stamps_[2];
+    std::vector< distance_type > distances_[2];
+    std::vector< size_t > parents_[2];
+    RadixHeap< size_t > heaps_[2];
+
+    void prepare(const graph_type& graph);
+    void build_side(const HashTable< Vertex, typename graph_type::adjacency_list >& edges, Side side);
+    size_t index_of(const Vertex& vertex) const;
+    bool is_reached(Side side, size_t vertex) const noexcept;
+    void reach(Side side, size_t vertex, distance_type distance, size_t parent);
+    void settle_next(Side side);
+  };
+
+  template < typename Value >
+  RadixHeap< Value >::RadixHeap():
+    buckets_(),
+    last_(0),
+    size_(0)
+  {}
+
+  template < typename Value >
+  void RadixHeap< Value >::push(key_type key, const Value& value)
+  {
+    if (key < last_) {
+      throw std::invalid_argument("Radix heap key is below the last extracted key");
+    }
+    buckets_[bucket_index(key, last_)].emplace_back(key, value);
+    ++size_;
+  }
+
+  template < typename Value >
+  const typename RadixHeap< Value >::value_type& RadixHeap< Value >::top()
+  {
+    if (empty()) {
+      throw std::out_of_range("Radix heap is empty");
+    }
+    if (buckets_[0].empty()) {
+      redistribute();
+    }
+    return buckets_[0].back();
+  }
+
+  template < typename Value >
+  void RadixHeap< Value >::pop()
+  {
+    top();
+    buckets_[0].pop_back();
+    --size_;
+  }
+
+  template < typename Value >
+  void RadixHeap< Value >::clear() noexcept
+  {
+    for (size_t i = 0; i < buckets_count_; ++i) {
+      buckets_[i].clear();
+    }
+    last_ = 0;
+    size_ = 0;
+  }
+
+  template < typename Value >
+  bool RadixHeap< Value >::empty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  template < typename Value >
+  size_t RadixHeap< Value >::size() const noexcept
+  {
+    return size_;
+  }
+
+  template < typename Value >
+  size_t RadixHeap< Value >::bucket_index(key_type key, key_type last) noexcept
+  {
+    size_t index = 0;
+    for (key_type diff = key ^ last; diff != 0; diff >>= 1) {
+      ++index;
+    }
+    return index;
+  }
+
+  template < typename Value >
+  void RadixHeap< Value >::redistribute()
+  {
+    size_t source = 1;
+    while (buckets_[source].empty()) {
+      ++source;
+    }
+    std::vector< value_type >& bucket = buckets_[source];
+    last_ = bucket[0].first;
+    for (size_t i = 1; i < bucket.size(); ++i) {
+      if (bucket[i].first < last_) {
+        last_ = bucket[i].first;
+      }
+    }
+    for (size_t i = 0; i < bucket.size(); ++i) {
+      buckets_[bucket_index(bucket[i].first, last_)].push_back(bucket[i]);
+    }
+    bucket.clear();
+  }
+
+  template < typename Vertex, typename Weight >
+  ShortestPathWorkspace< Vertex, Weight >::ShortestPathWorkspace():
+    is_cached_(false),
+    revision_(0),
+    epoch_(0),
+    best_(0),
+    meeting_(0)
+  {}
+
+  template < typename Vertex, typename Weight >
+  bool ShortestPathWorkspace< Vertex, Weight >::find_path(const graph_type& graph, const Vertex& from,
+      const Vertex& to, std::vector< Vertex >& path, distance_type& distance)
+  {
+    prepare(graph);
+    size_t source = index_of(from);
+    size_t target = index_of(to);
+    path.clear();
+    if (source == target) {
+      path.push_back(names_[source]);
+      distance = 0;
+      return true;
+    }
+    reach(FORWARD, source, 0, source);
+    reach(BACKWARD, target, 0, target);
+    while (!heaps_[FORWARD].empty() && !heaps_[BACKWARD].empty()) {
+      distance_type forward_top = heaps_[FORWARD].top().first;
+      distance_type backward_top = heaps_[BACKWARD].top().first;
+      if (forward_top + backward_top >= best_) {
+        break;
+      }
+      settle_next(backward_top < forward_top ? BACKWARD : FORWARD);
+    }
+    if (best_ == std::numeric_limits< distance_type >::max()) {
+      return false;
+    }
+
+    for (size_t i = meeting_; i != source; i = parents_[FORWARD][i]) {
+      path.push_back(names_[i]);
+    }
+    path.push_back(names_[source]);
+    std::reverse(path.begin(), path.end());
+    for (size_t i = meeting_; i != target; ) {
+      i = parents_[BACKWARD][i];
+      path.push_back(names_[i]);
+    }
+    distance = best_;
+    return true;
+  }
+
+  template < typename Vertex, typename Weight >
+  void ShortestPathWorkspace< Vertex, Weight >::find_distances(const graph_type& graph, const Vertex& from,
+      std::vector< std::pair< Vertex, distance_type > >& distances)
+  {
+    prepare(graph);
+    size_t source = index_of(from);
+    reach(FORWARD, source, 0, source);
+    while (!heaps_[FORWARD].empty()) {
+      settle_next(FORWARD);
+    }
+    distances.clear();
+    for (size_t i = 0; i < names_.size(); ++i) {
+      if (is_reached(FORWARD, i)) {
+        distances.emplace_back(names_[i], distances_[FORWARD][i]);
+      }
+    }
+  }
+
+  template < typename Vertex, typename Weight >
+  void ShortestPathWorkspace< Vertex, Weight >::prepare(const graph_type& graph)
+  {
+    if (!is_cached_ || revision_ != graph.revision()) {
+      names_.clear();
+      indices_.clear();
+      for (const auto& entry: graph.outbound_edges_) {
+        indices_.insert({entry.first, names_.size()});
+        names_.push_back(entry.first);
+      }
+      build_side(graph.outbound_edges_, FORWARD);
+      build_side(graph.inbound_edges_, BACKWARD);
+      for (size_t side = 0; side < 2; ++side) {
+        if (stamps_[side].size() < names_.size()) {
+          stamps_[side].resize(names_.size(), 0);
+          distances_[side].resize(names_.size());
+          parents_[side].resize(names_.size());
+        }
+      }
+      revision_ = graph.revision();
+      is_cached_ = true;
+    }
+    ++epoch_;
+    best_ = std::numeric_limits< distance_type >::max();
+    heaps_[FORWARD].clear();
+    heaps_[BACKWARD].clear();
+  }
+
+  template < typename Vertex, typename Weight >
+  void ShortestPathWorkspace< Vertex, Weight >::build_side(
+      const HashTable< Vertex, typename graph_type::adjacency_list >& edges, Side side)
+  {
+    offsets_[side].assign(names_.size() + 1, 0);
+    targets_[side].clear();
+    weights_[side].clear();
+    for (size_t i = 0; i < names_.size(); ++i) {
+      auto it = edges.find(names_[i]);
+      if (it != edges.end()) {
+        for (const auto& edge: it->second) {
+          targets_[side].push_back(indices_.at(edge.first));
+          weights_[side].push_back(edge.second);
+        }
+      }
+      offsets_[side][i + 1] = targets_[side].size();
+    }
+  }
+
+  template < typename Vertex, typename Weight >
+  size_t ShortestPathWorkspace< Vertex, Weight >::index_of(const Vertex& vertex) const
+  {
+    auto it = indices_.find(vertex);
+    if (it == indices_.end()) {
+      throw std::out_of_range("Vertex not found");
+    }
+    return it->second;
+  }
+
+  template < typename Vertex, typename Weight >
+  bool ShortestPathWorkspace< Vertex, Weight >::is_reached(Side side, size_t vertex) const noexcept
+  {
+    return stamps_[side][vertex] == epoch_;
+  }
+
+  template < typename Vertex, typename Weight >
+  void ShortestPathWorkspace< Vertex, Weight >::reach(Side side, size_t vertex, distance_type distance, size_t parent)
+  {
+    stamps_[side][vertex] = epoch_;
+    distances_[side][vertex] = distance;
+    parents_[side][vertex] = parent;
+    heaps_[side].push(distance, vertex);
+  }
+
+  template < typename Vertex, typename Weight >
+  void ShortestPathWorkspace< Vertex, Weight >::settle_next(Side side)
+  {
+    auto entry = heaps_[side].top();
+    heaps_[side].pop();
+    size_t vertex = entry.second;
+    if (entry.first != distances_[side][vertex]) {
+      return;
+    }
+    Side other = side == FORWARD ? BACKWARD : FORWARD;
+    for (size_t i = offsets_[side][vertex]; i < offsets_[side][vertex + 1]; ++i) {
+      size_t next = targets_[side][i];
+      distance_type next_distance = entry.first + weights_[side][i];
+      if (!is_reached(side, next) || next_distance < distances_[side][next]) {
+        reach(side, next, next_distance, vertex);
+      }
+      if (is_reached(other, next) && distances_[side][next] + distances_[other][next] < best_) {
+        best_ = distances_[side][next] + distances_[other][next];
+        meeting_ = next;
+      }
+    }
+  }
+
+}
+
+#endif
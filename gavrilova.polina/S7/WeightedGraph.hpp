@@ -9,6 +9,9 @@
 
 namespace gavrilova {
 
+  template < typename Vertex, typename Weight >
+  class ShortestPathWorkspace;
+
   template < typename Vertex, typename Weight = unsigned >
   class WeightedGraph {
   public:
@@ -29,11 +32,17 @@ namespace gavrilova {
     adjacency_list get_inbound_edges(const Vertex& v) const;
     size_t vertex_count() const;
     size_t edge_count() const;
+    size_t revision() const;
 
   private:
+    friend class ShortestPathWorkspace< Vertex, Weight >;
+
     HashTable< Vertex, adjacency_list > outbound_edges_;
     HashTable< Vertex, adjacency_list > inbound_edges_;
     size_t edges_count_ = 0;
+    size_t revision_ = 0;
+
+    static size_t next_revision();
 
     bool remove_edge_from_list(adjacency_list& edges, const Vertex& target, Weight weight);
     void sort_edges(adjacency_list& edges) const;
@@ -56,6 +65,7 @@ namespace gavrilova {
     if (outbound_edges_.find(v) == outbound_edges_.end()) {
       outbound_edges_.insert({v, adjacency_list()});
       inbound_edges_.insert({v, adjacency_list()});
+      revision_ = next_revision();
     }
   }
 
@@ -67,14 +77,21 @@ namespace gavrilova {
     outbound_edges_[from].emplace_back(to, weight);
     inbound_edges_[to].emplace_back(from, weight);
     edges_count_++;
+    revision_ = next_revision();
   }
 
   template < typename Vertex, typename Weight >
   bool WeightedGraph< Vertex, Weight >::remove_edge(const Vertex& from, const Vertex& to, Weight weight)
   {
-    if (remove_edge_from_list(outbound_edges_[from], to, weight)) {
-      remove_edge_from_list(inbound_edges_[to], from, weight);
+    auto outbound = outbound_edges_.find(from);
+    auto inbound = inbound_edges_.find(to);
+    if (outbound == outbound_edges_.end() || inbound == inbound_edges_.end()) {
+      return false;
+    }
+    if (remove_edge_from_list(outbound->second, to, weight)) {
+      remove_edge_from_list(inbound->second, from, weight);
       edges_count_--;
+      revision_ = next_revision();
       return true;
     }
     return false;
@@ -142,6 +159,19 @@ namespace gavrilova {
     return edges_count_;
   }
 
+  template < typename Vertex, typename Weight >
+  size_t WeightedGraph< Vertex, Weight >::revision() const
+  {
+    return revision_;
+  }
+
+  template < typename Vertex, typename Weight >
+  size_t WeightedGraph< Vertex, Weight >::next_revision()
+  {
+    static size_t last_revision = 0;
+    return ++last_revision;
+  }
+
   template < typename Vertex, typename Weight >
   bool WeightedGraph< Vertex, Weight >::remove_edge_from_list(
       adjacency_list& edges, const Vertex& target, Weight weight)
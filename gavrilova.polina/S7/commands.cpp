@@ -1,4 +1,5 @@
 #include "commands.hpp"
+#include <algorithm>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -225,6 +226,46 @@ void gavrilova::extract(std::istream& in, GraphsCollection& graphs)
   graphs[new_graph_name] = extract_graph(it_old->second, vertices_to_extract);
 }
 
+void gavrilova::path(std::ostream& out, std::istream& in, const GraphsCollection& graphs, PathWorkspace& workspace)
+{
+  std::string graph_name, v_from, v_to;
+  if (!(in >> graph_name >> v_from >> v_to)) {
+    throw std::invalid_argument("Invalid input in path");
+  }
+  auto it = graphs.find(graph_name);
+  if (it == graphs.cend() || !it->second.has_vertex(v_from) || !it->second.has_vertex(v_to)) {
+    throw std::invalid_argument("Graph or vertex not found");
+  }
+  std::vector< std::string > route;
+  PathWorkspace::distance_type length = 0;
+  if (!workspace.find_path(it->second, v_from, v_to, route, length)) {
+    throw std::invalid_argument("Path not found");
+  }
+  out << length;
+  for (size_t i = 0; i < route.size(); ++i) {
+    out << " " << route[i];
+  }
+  out << "\n";
+}
+
+void gavrilova::distances(std::ostream& out, std::istream& in, const GraphsCollection& graphs, PathWorkspace& workspace)
+{
+  std::string graph_name, v_from;
+  if (!(in >> graph_name >> v_from)) {
+    throw std::invalid_argument("Invalid input in distances");
+  }
+  auto it = graphs.find(graph_name);
+  if (it == graphs.cend() || !it->second.has_vertex(v_from)) {
+    throw std::invalid_argument("Graph or vertex not found");
+  }
+  std::vector< std::pair< std::string, PathWorkspace::distance_type > > reached;
+  workspace.find_distances(it->second, v_from, reached);
+  std::sort(reached.begin(), reached.end());
+  for (size_t i = 0; i < reached.size(); ++i) {
+    out << reached[i].first << " " << reached[i].second << "\n";
+  }
+}
+
 void gavrilova::readGraphsFromFile(std::istream& in, GraphsCollection& graphs)
 {
   std::string line;
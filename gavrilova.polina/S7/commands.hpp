@@ -4,12 +4,14 @@
 #include <iostream>
 #include <string>
 #include "HashTable.hpp"
+#include "ShortestPaths.hpp"
 #include "WeightedGraph.hpp"
 
 namespace gavrilova {
 
   using Graph = WeightedGraph< std::string, unsigned int >;
   using GraphsCollection = HashTable< std::string, Graph >;
+  using PathWorkspace = ShortestPathWorkspace< std::string, unsigned int >;
 
   void graphs(std::ostream& out, const GraphsCollection& graphs);
   void vertexes(std::ostream& out, std::istream& in, const GraphsCollection& graphs);
@@ -20,6 +22,8 @@ namespace gavrilova {
   void create(std::istream& in, GraphsCollection& graphs);
   void merge(std::istream& in, GraphsCollection& graphs);
   void extract(std::istream& in, GraphsCollection& graphs);
+  void path(std::ostream& out, std::istream& in, const GraphsCollection& graphs, PathWorkspace& workspace);
+  void distances(std::ostream& out, std::istream& in, const GraphsCollection& graphs, PathWorkspace& workspace);
 
   void readGraphsFromFile(std::istream& in, GraphsCollection& graphs);
 
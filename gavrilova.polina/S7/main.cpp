@@ -28,6 +28,7 @@ int main(int argc, char* argv[])
   GraphsCollection graphs_collection;
   readGraphsFromFile(file, graphs_collection);
 
+  PathWorkspace path_workspace;
   HashTable< std::string, std::function< void() > > commands;
 
   commands["graphs"] = std::bind(graphs, std::ref(std::cout), std::cref(graphs_collection));
@@ -39,6 +40,10 @@ int main(int argc, char* argv[])
   commands["create"] = std::bind(create, std::ref(std::cin), std::ref(graphs_collection));
   commands["merge"] = std::bind(merge, std::ref(std::cin), std::ref(graphs_collection));
   commands["extract"] = std::bind(extract, std::ref(std::cin), std::ref(graphs_collection));
+  commands["path"] = std::bind(path, std::ref(std::cout), std::ref(std::cin), std::cref(graphs_collection),
+      std::ref(path_workspace));
+  commands["distances"] = std::bind(distances, std::ref(std::cout), std::ref(std::cin), std::cref(graphs_collection),
+      std::ref(path_workspace));
 
   std::string command_str;
   while (std::cin >> command_str) {
@@ -0,0 +1,147 @@
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <vector>
+#include "ShortestPaths.hpp"
+
+namespace {
+  using TestGraph = gavrilova::WeightedGraph< std::string, unsigned >;
+  using TestWorkspace = gavrilova::ShortestPathWorkspace< std::string, unsigned >;
+
+  TestGraph make_graph()
+  {
+    TestGraph graph;
+    graph.add_edge("a", "b", 4);
+    graph.add_edge("a", "c", 1);
+    graph.add_edge("c", "b", 2);
+    graph.add_edge("b", "d", 5);
+    graph.add_edge("c", "d", 8);
+    graph.add_edge("d", "e", 3);
+    graph.add_vertex("f");
+    return graph;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(ShortestPathsTest)
+
+BOOST_AUTO_TEST_CASE(TestRadixHeapOrder)
+{
+  gavrilova::RadixHeap< int > heap;
+  heap.push(7, 0);
+  heap.push(3, 1);
+  heap.push(3, 2);
+  heap.push(12, 3);
+  BOOST_TEST(heap.size() == 4);
+  BOOST_TEST(heap.top().first == 3);
+  heap.pop();
+  BOOST_TEST(heap.top().first == 3);
+  heap.pop();
+  heap.push(5, 4);
+  BOOST_TEST(heap.top().first == 5);
+  heap.pop();
+  BOOST_TEST(heap.top().first == 7);
+  heap.pop();
+  BOOST_TEST(heap.top().first == 12);
+  heap.pop();
+  BOOST_TEST(heap.empty());
+  BOOST_CHECK_THROW(heap.top(), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(TestRadixHeapMonotone)
+{
+  gavrilova::RadixHeap< int > heap;
+  heap.push(10, 0);
+  heap.pop();
+  BOOST_CHECK_THROW(heap.push(9, 1), std::invalid_argument);
+  heap.clear();
+  heap.push(9, 1);
+  BOOST_TEST(heap.top().first == 9);
+}
+
+BOOST_AUTO_TEST_CASE(TestFindPath)
+{
+  TestGraph graph = make_graph();
+  TestWorkspace workspace;
+  std::vector< std::string > path;
+  TestWorkspace::distance_type distance = 0;
+
+  BOOST_TEST(workspace.find_path(graph, "a", "e", path, distance));
+  BOOST_TEST(distance == 11);
+  BOOST_TEST((path == std::vector< std::string >{"a", "c", "b", "d", "e"}));
+
+  BOOST_TEST(workspace.find_path(graph, "b", "b", path, distance));
+  BOOST_TEST(distance == 0);
+  BOOST_TEST(path.size() == 1);
+
+  BOOST_TEST(!workspace.find_path(graph, "e", "a", path, distance));
+  BOOST_TEST(!workspace.find_path(graph, "a", "f", path, distance));
+  BOOST_CHECK_THROW(workspace.find_path(graph, "a", "x", path, distance), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(TestFindDistances)
+{
+  TestGraph graph = make_graph();
+  TestWorkspace workspace;
+  std::vector< std::pair< std::string, TestWorkspace::distance_type > > distances;
+
+  workspace.find_distances(graph, "c", distances);
+  BOOST_TEST(distances.size() == 4);
+  for (const auto& entry: distances) {
+    if (entry.first == "c") {
+      BOOST_TEST(entry.second == 0);
+    } else if (entry.first == "b") {
+      BOOST_TEST(entry.second == 2);
+    } else if (entry.first == "d") {
+      BOOST_TEST(entry.second == 7);
+    } else {
+      BOOST_TEST(entry.first == "e");
+      BOOST_TEST(entry.second == 10);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestWorkspaceFollowsGraphChanges)
+{
+  TestGraph graph = make_graph();
+  TestWorkspace workspace;
+  std::vector< std::string > path;
+  TestWorkspace::distance_type distance = 0;
+
+  BOOST_TEST(workspace.find_path(graph, "a", "d", path, distance));
+  BOOST_TEST(distance == 8);
+
+  graph.add_edge("a", "d", 2);
+  BOOST_TEST(workspace.find_path(graph, "a", "d", path, distance));
+  BOOST_TEST(distance == 2);
+
+  graph.remove_edge("a", "d", 2);
+  BOOST_TEST(workspace.find_path(graph, "a", "d", path, distance));
+  BOOST_TEST(distance == 8);
+
+  TestGraph other;
+  other.add_edge("a", "d", 1);
+  BOOST_TEST(workspace.find_path(other, "a", "d", path, distance));
+  BOOST_TEST(distance == 1);
+}
+
+BOOST_AUTO_TEST_CASE(TestWorkspaceAfterFailedRemove)
+{
+  TestGraph graph;
+  graph.add_edge("a", "b", 1);
+  graph.add_edge("b", "c", 2);
+  TestWorkspace workspace;
+  std::vector< std::pair< std::string, TestWorkspace::distance_type > > distances;
+
+  workspace.find_distances(graph, "a", distances);
+  BOOST_TEST(distances.size() == 3);
+
+  BOOST_TEST(!graph.remove_edge("zz", "a", 1));
+  BOOST_TEST(!graph.remove_edge("a", "zz", 1));
+  BOOST_TEST(!graph.has_vertex("zz"));
+  BOOST_TEST(graph.vertex_count() == 3);
+  BOOST_CHECK_THROW(workspace.find_distances(graph, "zz", distances), std::out_of_range);
+
+  workspace.find_distances(graph, "b", distances);
+  BOOST_TEST(distances.size() == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
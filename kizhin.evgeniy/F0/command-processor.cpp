@@ -11,10 +11,12 @@
 #include <tuple>
 #include <map.hpp>
 #include "freq-dict.hpp"
+#include "corpus-loader.hpp"
+#include "wildcard-index.hpp"
 
 namespace kizhin {
-  bool isSatisfied(const std::string& str, const std::string& regexp);
   std::string wordAndSizeToString(const WordAndSize&);
+  std::string rankedWordToString(const WordAndSize*);
   float getFreq(const FrequencyDictionary&, const WordAndSize&);
   void outWordInfo(std::ostream&, const FrequencyDictionary&, const WordAndSize&);
 }
@@ -193,12 +195,12 @@ void kizhin::CommandProcessor::handleInter(const CmdArgs& args) const
     err_ << "Unknown dictionary: " << args[state_.count(args[0])] << '\n';
     return;
   }
-  const FrequencyDictionary first = loadDictionary(state_[args[0]]);
-  const FrequencyDictionary second = loadDictionary(state_[args[1]]);
+  const FrequencyDictionary& first = loadDictionary(state_[args[0]]);
+  const FrequencyDictionary& second = loadDictionary(state_[args[1]]);
   std::set< std::string > intersection{};
   const auto ins = std::inserter(intersection, intersection.end());
-  const WordSet& firstW = first.wordSet;
-  const WordSet& secondW = second.wordSet;
+  const WordSet& firstW = first.wordSet();
+  const WordSet& secondW = second.wordSet();
   const auto beg = firstW.begin();
   std::set_intersection(beg, firstW.end(), secondW.begin(), secondW.end(), ins);
   WordMap result{};
@@ -208,7 +210,8 @@ void kizhin::CommandProcessor::handleInter(const CmdArgs& args) const
   static const auto getFirst = std::bind(&WordMap::value_type::first, _1);
   const auto interPtr = std::addressof(intersection);
   const auto contains = std::bind(count, interPtr, std::bind(getFirst, _1));
-  std::copy_if(first.wordMap.begin(), first.wordMap.end(), inserter, contains);
+  const WordMap& firstMap = first.wordMap();
+  std::copy_if(firstMap.begin(), firstMap.end(), inserter, contains);
   using OutIt = std::ostream_iterator< std::string >;
   std::transform(result.begin(), result.end(), OutIt{ out_, "\n" }, wordAndSizeToString);
 }
@@ -223,13 +226,13 @@ void kizhin::CommandProcessor::handleDiff(const CmdArgs& args) const
     err_ << "Unknown dictionary: " << args[state_.count(args[0])] << '\n';
     return;
   }
-  const FrequencyDictionary first = loadDictionary(state_[args[0]]);
-  const FrequencyDictionary second = loadDictionary(state_[args[1]]);
+  const FrequencyDictionary& first = loadDictionary(state_[args[0]]);
+  const FrequencyDictionary& second = loadDictionary(state_[args[1]]);
   using std::placeholders::_1;
   std::set< std::string > difference{};
   const auto ins = std::inserter(difference, difference.end());
-  const WordSet& firstW = first.wordSet;
-  const WordSet& secondW = second.wordSet;
+  const WordSet& firstW = first.wordSet();
+  const WordSet& secondW = second.wordSet();
   std::set_difference(firstW.begin(), firstW.end(), secondW.begin(), secondW.end(), ins);
   WordMap result{};
   const auto inserter = std::inserter(result, result.end());
@@ -237,7 +240,8 @@ void kizhin::CommandProcessor::handleDiff(const CmdArgs& args) const
   static const auto getFirst = std::bind(&WordMap::value_type::first, _1);
   const auto diffPtr = std::addressof(difference);
   const auto contains = std::bind(count, diffPtr, std::bind(getFirst, _1));
-  std::copy_if(first.wordMap.begin(), first.wordMap.end(), inserter, contains);
+  const WordMap& firstMap = first.wordMap();
+  std::copy_if(firstMap.begin(), firstMap.end(), inserter, contains);
   using OutIt = std::ostream_iterator< std::string >;
   std::transform(result.begin(), result.end(), OutIt{ out_, "\n" }, wordAndSizeToString);
 }
@@ -251,8 +255,8 @@ void kizhin::CommandProcessor::handleStat(const CmdArgs& args) const
     err_ << "Unknown dictionary: " << args[0] << '\n';
     return;
   }
-  const FrequencyDictionary dict = loadDictionary(state_.at(args[0]));
-  const SizeSet& freqDict = dict.sizeSet;
+  const FrequencyDictionary& dict = loadDictionary(state_.at(args[0]));
+  const SizeSet& freqDict = dict.sizeSet();
   if (freqDict.empty()) {
     out_ << "Dictionary is empty\n";
     return;
@@ -262,7 +266,7 @@ void kizhin::CommandProcessor::handleStat(const CmdArgs& args) const
   out_ << std::setw(titleWidth) << std::left << "Unique words";
   out_ << std::setw(countWidth) << std::left << freqDict.size() << '\n';
   out_ << std::setw(titleWidth) << std::left << "Total words";
-  out_ << std::setw(countWidth) << std::left << dict.total << '\n';
+  out_ << std::setw(countWidth) << std::left << dict.total() << '\n';
   out_ << std::setw(titleWidth) << std::left << "Most frequent";
   out_ << std::setw(countWidth) << std::left << freqDict.begin()->second;
   using std::placeholders::_1;
@@ -293,12 +297,10 @@ void kizhin::CommandProcessor::handleTop(const CmdArgs& args) const
     return;
   }
   const std::size_t count = args.size() == 2 ? std::stoull(args[1]) : 5;
-  const FrequencyDictionary dict = loadDictionary(state_[args[0]]);
-  const SizeSet& freqDict = dict.sizeSet;
-  const bool beforeEnd = count < freqDict.size();
-  const auto end = beforeEnd ? std::next(freqDict.begin(), count) : freqDict.end();
+  const FrequencyDictionary& dict = loadDictionary(state_[args[0]]);
+  const WordRanking top = topWords(dict, count);
   using OutIt = std::ostream_iterator< std::string >;
-  std::transform(freqDict.begin(), end, OutIt{ out_, "\n" }, wordAndSizeToString);
+  std::transform(top.begin(), top.end(), OutIt{ out_, "\n" }, rankedWordToString);
 }
 
 void kizhin::CommandProcessor::handleBot(const CmdArgs& args) const
@@ -311,12 +313,10 @@ void kizhin::CommandProcessor::handleBot(const CmdArgs& args) const
     return;
   }
   const std::size_t count = args.size() == 2 ? std::stoull(args[1]) : 5;
-  FrequencyDictionary dict = loadDictionary(state_[args[0]]);
-  const SizeSet& freqDict = dict.sizeSet;
-  const bool beforeEnd = count < freqDict.size();
-  const auto beg = beforeEnd ? std::next(freqDict.rbegin(), count) : freqDict.rend();
+  const FrequencyDictionary& dict = loadDictionary(state_[args[0]]);
+  const WordRanking bot = botWords(dict, count);
   using OutIt = std::ostream_iterator< std::string >;
-  std::transform(beg.base(), freqDict.end(), OutIt{ out_, "\n" }, wordAndSizeToString);
+  std::transform(bot.begin(), bot.end(), OutIt{ out_, "\n" }, rankedWordToString);
 }
 
 void kizhin::CommandProcessor::handleRange(const CmdArgs& args) const
@@ -335,10 +335,10 @@ void kizhin::CommandProcessor::handleRange(const CmdArgs& args) const
     err_ << "Requirements: 0.0 <= min <= max <= 1.0\n";
     return;
   }
-  const FrequencyDictionary dict = loadDictionary(state_[args[0]]);
-  const SizeSet& freqDict = dict.sizeSet;
-  const auto begin = freqDict.upper_bound({ "", max * dict.total });
-  const auto end = freqDict.lower_bound({ "", min * dict.total });
+  const FrequencyDictionary& dict = loadDictionary(state_[args[0]]);
+  const SizeSet& freqDict = dict.sizeSet();
+  const auto begin = freqDict.upper_bound({ "", max * dict.total() });
+  const auto end = freqDict.lower_bound({ "", min * dict.total() });
   using std::placeholders::_1;
   const auto printer = std::bind(&outWordInfo, std::ref(out_), std::cref(dict), _1);
   std::for_each(begin, end, printer);
@@ -353,17 +353,10 @@ void kizhin::CommandProcessor::handleFind(const CmdArgs& args) const
     err_ << "Unknown dictionary: " << args[0] << '\n';
     return;
   }
-  const FrequencyDictionary dict = loadDictionary(state_.at(args[0]));
-  const WordMap& wordMap = dict.wordMap;
-  WordMap result{};
-  using std::placeholders::_1;
-  const auto inserter = std::inserter(result, result.end());
-  static const auto getFirst = std::bind(&WordMap::value_type::first, _1);
-  static const auto validator = std::addressof(isSatisfied);
-  const auto isRight = std::bind(validator, std::bind(getFirst, _1), std::cref(args[1]));
-  std::copy_if(wordMap.begin(), wordMap.end(), inserter, isRight);
+  const FrequencyDictionary& dict = loadDictionary(state_.at(args[0]));
+  const WordRanking found = dict.wildcardIndex().find(args[1]);
   using OutIt = std::ostream_iterator< std::string >;
-  std::transform(result.begin(), result.end(), OutIt{ out_, "\n" }, wordAndSizeToString);
+  std::transform(found.begin(), found.end(), OutIt{ out_, "\n" }, rankedWordToString);
 }
 
 void kizhin::CommandProcessor::outDictionary(const State::key_type& dictionary) const
@@ -378,33 +371,22 @@ void kizhin::CommandProcessor::outDictionary(const State::key_type& dictionary)
   out_ << '\n';
 }
 
-kizhin::FrequencyDictionary kizhin::CommandProcessor::loadDictionary(
+const kizhin::FrequencyDictionary& kizhin::CommandProcessor::loadDictionary(
     const std::vector< std::string >& files) const
 {
-  FrequencyDictionary result{};
-  using std::placeholders::_1;
-  const auto expander = std::bind(std::addressof(expandDictionary), _1, std::ref(result));
-  std::vector< std::ifstream > fins(files.begin(), files.end());
-  std::for_each(fins.begin(), fins.end(), expander);
-  return result;
-}
-
-bool kizhin::isSatisfied(const std::string& str, const std::string& reg)
-{
-  auto strPos = str.begin();
-  auto regPos = reg.begin();
-  std::tie(strPos, regPos) = std::mismatch(strPos, str.end(), regPos, reg.end());
-  while (strPos != str.end() && regPos != reg.end()) {
-    if (*regPos == '*') {
-      strPos = std::find(strPos, str.end(), *(++regPos));
-    } else {
-      return false;
-    }
-    std::tie(strPos, regPos) = std::mismatch(strPos, str.end(), regPos, reg.end());
+  std::vector< FileStamp > stamps{};
+  stamps.reserve(files.size());
+  std::transform(files.begin(), files.end(), std::back_inserter(stamps), getFileStamp);
+  if (loaded_[recent_].files != files) {
+    recent_ = 1 - recent_;
+  }
+  LoadedDictionary& loaded = loaded_[recent_];
+  if (loaded.files != files || loaded.stamps.empty() || loaded.stamps != stamps) {
+    loaded.dict = loadCorpus(files);
+    loaded.files = files;
+    loaded.stamps = std::move(stamps);
   }
-  const bool isRegEnd = regPos == reg.end();
-  const bool doesMathcAny = (*regPos == '*' && std::next(regPos) == reg.end());
-  return strPos == str.end() && (isRegEnd || doesMathcAny);
+  return loaded.dict;
 }
 
 std::string kizhin::wordAndSizeToString(const WordAndSize& val)
@@ -412,9 +394,14 @@ std::string kizhin::wordAndSizeToString(const WordAndSize& val)
   return std::to_string(val.second) + '\t' + val.first;
 }
 
+std::string kizhin::rankedWordToString(const WordAndSize* val)
+{
+  return wordAndSizeToString(*val);
+}
+
 float kizhin::getFreq(const FrequencyDictionary& dict, const WordAndSize& word)
 {
-  return static_cast< float >(word.second) / dict.total;
+  return static_cast< float >(word.second) / dict.total();
 };
 
 void kizhin::outWordInfo(std::ostream& out, const FrequencyDictionary& dict,
@@ -1,12 +1,14 @@
 #ifndef SPBSPU_LABS_2025_TP_A_KIZHIN_EVGENIY_F0_COMMAND_PROCESSOR_HPP
 #define SPBSPU_LABS_2025_TP_A_KIZHIN_EVGENIY_F0_COMMAND_PROCESSOR_HPP
 
+#include <array>
 #include <iosfwd>
 #include <string>
 #include <utility>
 #include <vector>
 #include "freq-dict.hpp"
 #include "state.hpp"
+#include "word-cache.hpp"
 
 namespace kizhin {
   class CommandProcessor
@@ -17,11 +19,19 @@ namespace kizhin {
 
   private:
     using CmdArgs = std::vector< std::string >;
+    struct LoadedDictionary
+    {
+      std::vector< std::string > files;
+      std::vector< FileStamp > stamps;
+      FrequencyDictionary dict;
+    };
 
     State& state_;
     std::istream& in_;
     std::ostream& out_;
     std::ostream& err_;
+    mutable std::array< LoadedDictionary, 2 > loaded_{};
+    mutable std::size_t recent_ = 1;
 
     std::pair< std::string, CmdArgs > parseCommand(const std::string&) const;
     void printPrompt();
@@ -43,7 +53,7 @@ namespace kizhin {
     void handleFind(const CmdArgs&) const;
 
     void outDictionary(const State::key_type&) const;
-    FrequencyDictionary loadDictionary(const std::vector< std::string >&) const;
+    const FrequencyDictionary& loadDictionary(const std::vector< std::string >&) const;
   };
 }
 
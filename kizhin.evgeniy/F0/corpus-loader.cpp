@@ -0,0 +1,171 @@
+#include "corpus-loader.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <system_error>
+#include <thread>
+#include "word-cache.hpp"
+
+namespace kizhin {
+  constexpr std::size_t chunkSize = std::size_t(8) << 20;
+
+  struct Chunk
+  {
+    std::size_t file;
+    std::size_t first;
+    std::size_t last;
+  };
+
+  template < typename Task >
+  void runParallel(std::size_t, std::size_t, const Task&);
+  bool isSpace(char) noexcept;
+  void countChunk(const std::string&, const Chunk&, FrequencyDictionary&);
+  void mergeInto(FrequencyDictionary&, const FrequencyDictionary&);
+  void reduceParts(std::vector< FrequencyDictionary >&, std::size_t, std::size_t, std::size_t);
+}
+
+kizhin::FrequencyDictionary kizhin::loadCorpus(const std::vector< std::string >& files,
+    std::size_t threads)
+{
+  if (threads == 0) {
+    threads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  std::vector< FrequencyDictionary > fileParts(files.size());
+  std::vector< char > cached(files.size());
+  runParallel(files.size(), threads, [&files, &fileParts, &cached](std::size_t i)
+  {
+    cached[i] = loadCachedWords(files[i], fileParts[i]);
+  });
+
+  std::vector< Chunk > chunks{};
+  std::vector< std::size_t > firstChunk(files.size() + 1);
+  std::vector< FileStamp > stamps(files.size());
+  for (std::size_t i = 0; i != files.size(); ++i) {
+    firstChunk[i] = chunks.size();
+    if (cached[i]) {
+      continue;
+    }
+    stamps[i] = getFileStamp(files[i]);
+    const std::size_t size = stamps[i].size;
+    for (std::size_t first = 0; first < size; first += chunkSize) {
+      chunks.push_back({ i, first, std::min(size, first + chunkSize) });
+    }
+  }
+  firstChunk[files.size()] = chunks.size();
+  std::vector< FrequencyDictionary > chunkParts(chunks.size());
+  runParallel(chunks.size(), threads, [&files, &chunks, &chunkParts](std::size_t i)
+  {
+    countChunk(files[chunks[i].file], chunks[i], chunkParts[i]);
+  });
+  for (std::size_t i = 0; i != files.size(); ++i) {
+    const std::size_t first = firstChunk[i];
+    const std::size_t last = firstChunk[i + 1];
+    if (first == last) {
+      continue;
+    }
+    reduceParts(chunkParts, first, last, threads);
+    fileParts[i] = std::move(chunkParts[first]);
+    saveCachedWords(files[i], stamps[i], fileParts[i]);
+  }
+  if (fileParts.empty()) {
+    return FrequencyDictionary{};
+  }
+  reduceParts(fileParts, 0, fileParts.size(), threads);
+  return std::move(fileParts.front());
+}
+
+template < typename Task >
+void kizhin::runParallel(std::size_t count, std::size_t threads, const Task& task)
+{
+  std::atomic< std::size_t > next(0);
+  std::exception_ptr error{};
+  std::atomic_flag hasError = ATOMIC_FLAG_INIT;
+  auto worker = [&task, &next, &error, &hasError, count]() -> void
+  {
+    for (std::size_t i = next++; i < count; i = next++) {
+      try {
+        task(i);
+      } catch (...) {
+        if (!hasError.test_and_set()) {
+          error = std::current_exception();
+        }
+        next = count;
+      }
+    }
+  };
+  const std::size_t helpers = std::min(threads, std::max(count, std::size_t(1))) - 1;
+  std::unique_ptr< std::thread[] > pool(new std::thread[helpers]);
+  std::size_t started = 0;
+  try {
+    for (; started != helpers; ++started) {
+      pool[started] = std::thread(worker);
+    }
+  } catch (const std::system_error&) {
+  } catch (...) {
+    next = count;
+    for (std::size_t i = 0; i != started; ++i) {
+      pool[i].join();
+    }
+    throw;
+  }
+  worker();
+  for (std::size_t i = 0; i != started; ++i) {
+    pool[i].join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+bool kizhin::isSpace(char c) noexcept
+{
+  return std::isspace(static_cast< unsigned char >(c));
+}
+
+void kizhin::countChunk(const std::string& filename, const Chunk& chunk, FrequencyDictionary& dict)
+{
+  std::ifstream in(filename, std::ios::binary);
+  const std::size_t from = chunk.first == 0 ? 0 : chunk.first - 1;
+  in.seekg(from);
+  std::string text(chunk.last - from, '\0');
+  in.read(&text[0], text.size());
+  text.resize(in.gcount());
+  for (char c = 0; !text.empty() && !isSpace(text.back()) && in.get(c) && !isSpace(c);) {
+    text.push_back(c);
+  }
+  auto pos = text.cbegin();
+  if (chunk.first != 0) {
+    pos = std::find_if(pos, text.cend(), isSpace);
+  }
+  while (pos != text.cend()) {
+    const auto wordBegin = std::find_if_not(pos, text.cend(), isSpace);
+    pos = std::find_if(wordBegin, text.cend(), isSpace);
+    if (wordBegin != pos) {
+      dict.append(std::string(wordBegin, pos));
+    }
+  }
+}
+
+void kizhin::mergeInto(FrequencyDictionary& dest, const FrequencyDictionary& src)
+{
+  for (const auto& word: src.counts()) {
+    dest.append(word.first, word.second);
+  }
+}
+
+void kizhin::reduceParts(std::vector< FrequencyDictionary >& parts, std::size_t first,
+    std::size_t last, std::size_t threads)
+{
+  for (std::size_t step = 1; first + step < last; step *= 2) {
+    const std::size_t pairs = (last - first - step + 2 * step - 1) / (2 * step);
+    runParallel(pairs, threads, [&parts, first, step](std::size_t i)
+    {
+      const std::size_t dest = first + 2 * step * i;
+      mergeInto(parts[dest], parts[dest + step]);
+      parts[dest + step] = FrequencyDictionary{};
+    });
+  }
+}
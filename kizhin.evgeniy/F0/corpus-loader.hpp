@@ -0,0 +1,12 @@
+#ifndef SPBSPU_LABS_2025_TP_A_KIZHIN_EVGENIY_F0_CORPUS_LOADER_HPP
+#define SPBSPU_LABS_2025_TP_A_KIZHIN_EVGENIY_F0_CORPUS_LOADER_HPP
+
+#include <string>
+#include <vector>
+#include "freq-dict.hpp"
+
+namespace kizhin {
+  FrequencyDictionary loadCorpus(const std::vector< std::string >& files, std::size_t threads = 0);
+}
+
+#endif
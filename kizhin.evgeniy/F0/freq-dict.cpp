@@ -3,9 +3,10 @@
 #include <fstream>
 #include <functional>
 #include <iterator>
+#include "wildcard-index.hpp"
 
 namespace kizhin {
-  void appendWord(FrequencyDictionary&, const std::string&);
+  WordRanking rankAll(const FrequencyDictionary&);
 }
 
 bool kizhin::SizeDescendingComp::operator()(const WordAndSize& lhs,
@@ -17,26 +18,125 @@ bool kizhin::SizeDescendingComp::operator()(const WordAndSize& lhs,
   return lhs.first < rhs.first;
 }
 
+bool kizhin::SizeDescendingComp::operator()(const WordAndSize* lhs,
+    const WordAndSize* rhs) const
+{
+  return (*this)(*lhs, *rhs);
+}
+
+bool kizhin::FrequencyDictionary::empty() const noexcept
+{
+  return counts_.empty();
+}
+
+std::size_t kizhin::FrequencyDictionary::size() const noexcept
+{
+  return counts_.size();
+}
+
+std::size_t kizhin::FrequencyDictionary::total() const noexcept
+{
+  return total_;
+}
+
+void kizhin::FrequencyDictionary::append(const std::string& word, std::size_t count)
+{
+  counts_[word] += count;
+  total_ += count;
+  invalidate();
+}
+
+const kizhin::WordCounts& kizhin::FrequencyDictionary::counts() const noexcept
+{
+  return counts_;
+}
+
+const kizhin::WordMap& kizhin::FrequencyDictionary::wordMap() const
+{
+  if (!hasWordMap_) {
+    wordMap_ = WordMap(counts_.begin(), counts_.end());
+    hasWordMap_ = true;
+  }
+  return wordMap_;
+}
+
+const kizhin::WordSet& kizhin::FrequencyDictionary::wordSet() const
+{
+  if (!hasWordSet_) {
+    const WordMap& words = wordMap();
+    wordSet_.clear();
+    for (const auto& word: words) {
+      wordSet_.emplace_hint(wordSet_.end(), word.first);
+    }
+    hasWordSet_ = true;
+  }
+  return wordSet_;
+}
+
+const kizhin::SizeSet& kizhin::FrequencyDictionary::sizeSet() const
+{
+  if (!hasSizeSet_) {
+    sizeSet_ = SizeSet(counts_.begin(), counts_.end());
+    hasSizeSet_ = true;
+  }
+  return sizeSet_;
+}
+
+const kizhin::WildcardIndex& kizhin::FrequencyDictionary::wildcardIndex() const
+{
+  if (!wildcardIndex_) {
+    wildcardIndex_ = std::make_shared< const WildcardIndex >(wordMap());
+  }
+  return *wildcardIndex_;
+}
+
+void kizhin::FrequencyDictionary::invalidate() noexcept
+{
+  hasWordMap_ = false;
+  hasWordSet_ = false;
+  hasSizeSet_ = false;
+  wildcardIndex_.reset();
+}
+
 void kizhin::expandDictionary(std::istream& in, FrequencyDictionary& dict)
 {
   using InIt = std::istream_iterator< std::string >;
-  using std::placeholders::_1;
-  const auto appender = std::bind(std::addressof(appendWord), std::ref(dict), _1);
-  std::for_each(InIt{ in }, InIt{}, appender);
+  for (InIt it{ in }; it != InIt{}; ++it) {
+    dict.append(*it);
+  }
 }
 
-void kizhin::appendWord(FrequencyDictionary& dict, const std::string& word)
+kizhin::WordRanking kizhin::topWords(const FrequencyDictionary& dict, std::size_t count)
 {
-  WordMap& wordMap = dict.wordMap;
-  WordSet& wordSet = dict.wordSet;
-  SizeSet& sizeSet = dict.sizeSet;
-  if (!wordMap.count(word)) {
-    wordMap[word] = 0;
-    wordSet.insert(word);
+  WordRanking result = rankAll(dict);
+  const SizeDescendingComp comp{};
+  if (count < result.size()) {
+    std::nth_element(result.begin(), result.begin() + count, result.end(), comp);
+    result.resize(count);
   }
-  std::size_t& wordCount = wordMap.at(word);
-  sizeSet.erase({ word, wordCount });
-  sizeSet.insert({ word, ++wordCount });
-  ++dict.total;
+  std::sort(result.begin(), result.end(), comp);
+  return result;
 }
 
+kizhin::WordRanking kizhin::botWords(const FrequencyDictionary& dict, std::size_t count)
+{
+  WordRanking result = rankAll(dict);
+  const SizeDescendingComp comp{};
+  if (count < result.size()) {
+    const auto first = result.end() - count;
+    std::nth_element(result.begin(), first, result.end(), comp);
+    result.erase(result.begin(), first);
+  }
+  std::sort(result.begin(), result.end(), comp);
+  return result;
+}
+
+kizhin::WordRanking kizhin::rankAll(const FrequencyDictionary& dict)
+{
+  WordRanking result{};
+  result.reserve(dict.size());
+  for (const auto& word: dict.counts()) {
+    result.push_back(std::addressof(word));
+  }
+  return result;
+}
@@ -2,32 +2,68 @@
 #define SPBSPU_LABS_2025_TP_A_KIZHIN_EVGENIY_F0_FREQ_DICT_HPP
 
 #include <iosfwd>
+#include <memory>
 #include <set>
 #include <string>
+#include <vector>
 #include <map.hpp>
+#include <unordered-map.hpp>
 
 namespace kizhin {
+  using WordCounts = UnorderedMap< std::string, std::size_t >;
   using WordMap = Map< std::string, std::size_t >;
   using WordSet = std::set< std::string >;
   using WordAndSize = std::pair< const std::string, std::size_t >;
+  using WordRanking = std::vector< const WordAndSize* >;
   struct SizeDescendingComp;
   using SizeSet = std::set< WordAndSize, SizeDescendingComp >;
 
   struct SizeDescendingComp
   {
     bool operator()(const WordAndSize&, const WordAndSize&) const;
+    bool operator()(const WordAndSize*, const WordAndSize*) const;
   };
 
-  struct FrequencyDictionary
+  class WildcardIndex;
+
+  class FrequencyDictionary
   {
-    WordMap wordMap{};
-    WordSet wordSet{};
-    SizeSet sizeSet{};
-    std::size_t total = 0;
+  public:
+    FrequencyDictionary() = default;
+    FrequencyDictionary(const FrequencyDictionary&) = delete;
+    FrequencyDictionary(FrequencyDictionary&&) = default;
+    FrequencyDictionary& operator=(const FrequencyDictionary&) = delete;
+    FrequencyDictionary& operator=(FrequencyDictionary&&) = default;
+
+    bool empty() const noexcept;
+    std::size_t size() const noexcept;
+    std::size_t total() const noexcept;
+
+    void append(const std::string&, std::size_t = 1);
+
+    const WordCounts& counts() const noexcept;
+    const WordMap& wordMap() const;
+    const WordSet& wordSet() const;
+    const SizeSet& sizeSet() const;
+    const WildcardIndex& wildcardIndex() const;
+
+  private:
+    WordCounts counts_{};
+    std::size_t total_ = 0;
+    mutable WordMap wordMap_{};
+    mutable WordSet wordSet_{};
+    mutable SizeSet sizeSet_{};
+    mutable std::shared_ptr< const WildcardIndex > wildcardIndex_{};
+    mutable bool hasWordMap_ = false;
+    mutable bool hasWordSet_ = false;
+    mutable bool hasSizeSet_ = false;
+
+    void invalidate() noexcept;
   };
 
   void expandDictionary(std::istream&, FrequencyDictionary&);
+  WordRanking topWords(const FrequencyDictionary&, std::size_t);
+  WordRanking botWords(const FrequencyDictionary&, std::size_t);
 }
 
 #endif
-
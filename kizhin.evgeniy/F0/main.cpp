@@ -1,6 +1,7 @@
 #include <fstream>
 #include <iostream>
 #include "command-processor.hpp"
+#include "word-cache.hpp"
 
 namespace kizhin {
   void outHelp(std::ostream&, const char*);
@@ -52,6 +53,7 @@ void kizhin::outHelp(std::ostream& out, const char* exec)
   out << '\n';
   out << "State Information:" << '\n';
   out << "  Program state is automatically saved to: " << getStateFile() << '\n';
+  out << "  Per-file word counts are cached in: " << getCacheDir() << '\n';
   out << "  Default state directory locations:" << '\n';
   out << "    1. $XDG_STATE_HOME/freq_dict.state" << '\n';
   out << "    2. $HOME/.local/state/freq_dict.state" << '\n';
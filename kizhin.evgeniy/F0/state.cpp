@@ -6,7 +6,6 @@
 #include <iterator>
 
 namespace kizhin {
-  std::string getStateDir();
   void saveDict(std::ostream&, State::const_reference);
 }
 
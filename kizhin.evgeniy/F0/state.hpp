@@ -8,6 +8,7 @@
 
 namespace kizhin {
   using State = Map< std::string, std::vector< std::string > >;
+  std::string getStateDir();
   std::string getStateFile();
   void saveState(std::ostream&, const State&);
   State loadState(std::istream&);
@@ -0,0 +1,77 @@
+#include <boost/test/unit_test.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include "command-processor.hpp"
+#include "test-state-dir.hpp"
+
+namespace {
+  void writeFile(const std::string& filename, const std::string& data, long mtime)
+  {
+    {
+      std::ofstream out(filename, std::ios::binary);
+      out.write(data.data(), data.size());
+    }
+    struct timeval times[2] = { { mtime, 0 }, { mtime, 0 } };
+    BOOST_REQUIRE(::utimes(filename.c_str(), times) == 0);
+  }
+
+  std::string run(kizhin::CommandProcessor& processor, std::istringstream& in,
+      std::ostringstream& out, const std::string& commands)
+  {
+    in.clear();
+    in.str(commands);
+    out.str("");
+    processor.processCommands();
+    return out.str();
+  }
+
+  bool contains(const std::string& str, const std::string& part)
+  {
+    return str.find(part) != std::string::npos;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(loaded_dictionaries);
+
+BOOST_AUTO_TEST_CASE(two_slot_cache)
+{
+  kizhin::StateDir state{};
+  const std::string a = state.path + "/a.txt";
+  const std::string b = state.path + "/b.txt";
+  const std::string c = state.path + "/c.txt";
+  writeFile(a, "one one two", 1000000);
+  writeFile(b, "three four four", 1000000);
+  writeFile(c, "five", 1000000);
+  kizhin::State dicts{};
+  dicts["A"] = { a };
+  dicts["B"] = { b };
+  dicts["C"] = { c };
+  std::istringstream in{};
+  std::ostringstream out{};
+  std::ostringstream err{};
+  kizhin::CommandProcessor processor(dicts, in, out, err);
+  BOOST_TEST(contains(run(processor, in, out, "top A 1\ntop B 1\n"), "2\tfour"));
+  BOOST_TEST(contains(out.str(), "2\tone"));
+
+  writeFile(a, "six six ten", 1000000);
+  const std::string hit = run(processor, in, out, "top A 1\n");
+  BOOST_TEST(contains(hit, "2\tone"));
+  BOOST_TEST(contains(run(processor, in, out, "inter A B\ndiff A B\n"), "1\ttwo"));
+
+  BOOST_REQUIRE(::setenv("XDG_STATE_HOME", (state.path + "/fresh").c_str(), 1) == 0);
+  BOOST_REQUIRE(::mkdir((state.path + "/fresh").c_str(), 0755) == 0);
+  run(processor, in, out, "top B 1\ntop C 1\n");
+  const std::string evicted = run(processor, in, out, "top A 1\n");
+  BOOST_TEST(contains(evicted, "2\tsix"));
+  BOOST_TEST(!contains(evicted, "2\tone"));
+
+  writeFile(a, "seven seven", 1000001);
+  BOOST_TEST(contains(run(processor, in, out, "top A 1\n"), "2\tseven"));
+  BOOST_TEST(err.str().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,160 @@
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include "corpus-loader.hpp"
+#include "word-cache.hpp"
+#include "test-state-dir.hpp"
+
+namespace {
+  using WordDump = std::map< std::string, std::size_t >;
+
+  constexpr std::size_t chunkSize = std::size_t(8) << 20;
+
+  void writeFile(const std::string& filename, const std::string& data)
+  {
+    std::ofstream out(filename, std::ios::binary);
+    out.write(data.data(), data.size());
+  }
+
+  WordDump dump(const kizhin::FrequencyDictionary& dict)
+  {
+    return WordDump(dict.counts().begin(), dict.counts().end());
+  }
+
+  WordDump serialCounts(const std::vector< std::string >& files)
+  {
+    kizhin::FrequencyDictionary dict{};
+    for (const auto& file: files) {
+      std::ifstream in(file, std::ios::binary);
+      kizhin::expandDictionary(in, dict);
+    }
+    return dump(dict);
+  }
+
+  std::string straddlingText()
+  {
+    std::string text{};
+    const std::string words[] = { "alpha", "beta\n", "gamma\t", "delta  " };
+    for (std::size_t i = 0; text.size() < 2 * chunkSize + 100; ++i) {
+      text += words[i % 4];
+      if (i % 4 == 0) {
+        text += ' ';
+      }
+    }
+    text.replace(chunkSize - 4, 8, " SPLIT! ");
+    text.replace(2 * chunkSize - 1, 3, " x ");
+    return text;
+  }
+
+  void setMtime(const std::string& filename, long seconds)
+  {
+    struct timeval times[2] = { { seconds, 0 }, { seconds, 0 } };
+    BOOST_REQUIRE(::utimes(filename.c_str(), times) == 0);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(corpus_loader);
+
+BOOST_AUTO_TEST_CASE(chunk_boundaries)
+{
+  kizhin::StateDir state{};
+  const std::string filename = state.path + "/big.txt";
+  writeFile(filename, straddlingText());
+  const std::vector< std::string > files{ filename };
+  const WordDump expected = serialCounts(files);
+  BOOST_TEST(expected.count("SPLIT!") == 1);
+  BOOST_TEST((dump(kizhin::loadCorpus(files, 1)) == expected));
+  BOOST_TEST(kizhin::removeTree(kizhin::getCacheDir()));
+  BOOST_TEST((dump(kizhin::loadCorpus(files, 4)) == expected));
+}
+
+BOOST_AUTO_TEST_CASE(several_files)
+{
+  kizhin::StateDir state{};
+  const std::vector< std::string > files{ state.path + "/a.txt", state.path + "/b.txt",
+    state.path + "/missing.txt", state.path + "/empty.txt" };
+  writeFile(files[0], "one two two\nthree");
+  writeFile(files[1], "  two three three\n\n");
+  writeFile(files[3], "");
+  const WordDump expected = serialCounts(files);
+  const kizhin::FrequencyDictionary dict = kizhin::loadCorpus(files, 3);
+  BOOST_TEST((dump(dict) == expected));
+  BOOST_TEST(dict.total() == 7);
+  BOOST_TEST(kizhin::loadCorpus({}, 2).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END();
+
+BOOST_AUTO_TEST_SUITE(word_cache);
+
+BOOST_AUTO_TEST_CASE(cache_hit)
+{
+  kizhin::StateDir state{};
+  const std::string filename = state.path + "/words.txt";
+  writeFile(filename, "red green red");
+  kizhin::FrequencyDictionary dict{};
+  BOOST_TEST(!kizhin::loadCachedWords(filename, dict));
+  kizhin::loadCorpus({ filename }, 1);
+  BOOST_TEST(kizhin::loadCachedWords(filename, dict));
+  BOOST_TEST((dump(dict) == WordDump{ { "green", 1 }, { "red", 2 } }));
+}
+
+BOOST_AUTO_TEST_CASE(mtime_invalidation)
+{
+  kizhin::StateDir state{};
+  const std::string filename = state.path + "/words.txt";
+  writeFile(filename, "red green red");
+  setMtime(filename, 1000000);
+  kizhin::loadCorpus({ filename }, 1);
+  writeFile(filename, "red green red");
+  setMtime(filename, 1000001);
+  kizhin::FrequencyDictionary dict{};
+  BOOST_TEST(!kizhin::loadCachedWords(filename, dict));
+  writeFile(filename, "big bluer big");
+  setMtime(filename, 1000001);
+  BOOST_TEST((dump(kizhin::loadCorpus({ filename }, 1)) == WordDump{ { "big", 2 }, { "bluer", 1 } }));
+}
+
+BOOST_AUTO_TEST_CASE(stamp_taken_before_reading)
+{
+  kizhin::StateDir state{};
+  const std::string filename = state.path + "/words.txt";
+  writeFile(filename, "red green red");
+  setMtime(filename, 1000000);
+  const kizhin::FileStamp stamp = kizhin::getFileStamp(filename);
+  const kizhin::FrequencyDictionary counted = kizhin::loadCorpus({ filename }, 1);
+  writeFile(filename, "big bluer big");
+  setMtime(filename, 1000001);
+  kizhin::saveCachedWords(filename, stamp, counted);
+  kizhin::FrequencyDictionary dict{};
+  BOOST_TEST(!kizhin::loadCachedWords(filename, dict));
+  BOOST_TEST((dump(kizhin::loadCorpus({ filename }, 1)) == WordDump{ { "big", 2 }, { "bluer", 1 } }));
+}
+
+BOOST_AUTO_TEST_CASE(inode_invalidation)
+{
+  kizhin::StateDir state{};
+  const std::string filename = state.path + "/words.txt";
+  const std::string replacement = state.path + "/replacement.txt";
+  writeFile(filename, "red green red");
+  setMtime(filename, 1000000);
+  const kizhin::FileStamp before = kizhin::getFileStamp(filename);
+  kizhin::loadCorpus({ filename }, 1);
+  writeFile(replacement, "big bluer big");
+  setMtime(replacement, 1000000);
+  BOOST_REQUIRE(std::rename(replacement.c_str(), filename.c_str()) == 0);
+  const kizhin::FileStamp after = kizhin::getFileStamp(filename);
+  BOOST_TEST(after.size == before.size);
+  BOOST_TEST(after.mtime == before.mtime);
+  BOOST_TEST(after.inode != before.inode);
+  kizhin::FrequencyDictionary dict{};
+  BOOST_TEST(!kizhin::loadCachedWords(filename, dict));
+  BOOST_TEST((dump(kizhin::loadCorpus({ filename }, 1)) == WordDump{ { "big", 2 }, { "bluer", 1 } }));
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,130 @@
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "freq-dict.hpp"
+#include "wildcard-index.hpp"
+
+namespace {
+  using Ranking = std::vector< std::pair< std::string, std::size_t > >;
+
+  kizhin::FrequencyDictionary makeDictionary(const std::string& text)
+  {
+    std::istringstream in(text);
+    kizhin::FrequencyDictionary dict{};
+    kizhin::expandDictionary(in, dict);
+    return dict;
+  }
+
+  kizhin::FrequencyDictionary randomDictionary(unsigned seed, std::size_t words)
+  {
+    std::mt19937 random(seed);
+    kizhin::FrequencyDictionary dict{};
+    for (std::size_t i = 0; i != words; ++i) {
+      std::string word(1 + random() % 6, 'a');
+      for (char& c: word) {
+        c = "abcde"[random() % 5];
+      }
+      dict.append(word, 1 + random() % 4);
+    }
+    return dict;
+  }
+
+  Ranking dump(const kizhin::WordRanking& ranking)
+  {
+    Ranking result{};
+    for (const auto* word: ranking) {
+      result.emplace_back(word->first, word->second);
+    }
+    return result;
+  }
+
+  Ranking sortedAll(const kizhin::FrequencyDictionary& dict)
+  {
+    kizhin::WordRanking all{};
+    for (const auto& word: dict.counts()) {
+      all.push_back(std::addressof(word));
+    }
+    std::sort(all.begin(), all.end(), kizhin::SizeDescendingComp{});
+    return dump(all);
+  }
+
+  Ranking scanMatches(const kizhin::FrequencyDictionary& dict, const std::string& regexp)
+  {
+    Ranking result{};
+    for (const auto& word: dict.wordMap()) {
+      if (kizhin::isSatisfied(word.first, regexp)) {
+        result.emplace_back(word.first, word.second);
+      }
+    }
+    return result;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(ranking);
+
+BOOST_AUTO_TEST_CASE(top_and_bot_order)
+{
+  const kizhin::FrequencyDictionary dict = makeDictionary("b a c b a d b e e");
+  const Ranking top = dump(kizhin::topWords(dict, 3));
+  BOOST_TEST((top == Ranking{ { "b", 3 }, { "a", 2 }, { "e", 2 } }));
+  const Ranking bot = dump(kizhin::botWords(dict, 3));
+  BOOST_TEST((bot == Ranking{ { "e", 2 }, { "c", 1 }, { "d", 1 } }));
+  BOOST_TEST(kizhin::topWords(dict, 10).size() == 5);
+  BOOST_TEST(kizhin::botWords(dict, 0).empty());
+  BOOST_TEST(kizhin::topWords(kizhin::FrequencyDictionary{}, 5).empty());
+}
+
+BOOST_AUTO_TEST_CASE(ties_match_full_sort)
+{
+  const kizhin::FrequencyDictionary dict = randomDictionary(17, 2000);
+  const Ranking all = sortedAll(dict);
+  for (std::size_t count: { std::size_t(0), std::size_t(1), std::size_t(7), std::size_t(100), all.size() }) {
+    const Ranking top(all.begin(), all.begin() + count);
+    const Ranking bot(all.end() - count, all.end());
+    BOOST_TEST((dump(kizhin::topWords(dict, count)) == top));
+    BOOST_TEST((dump(kizhin::botWords(dict, count)) == bot));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(views_follow_append)
+{
+  kizhin::FrequencyDictionary dict = makeDictionary("b a b");
+  BOOST_TEST(dict.wordMap().size() == 2);
+  BOOST_TEST(dict.sizeSet().begin()->first == "b");
+  dict.append("a", 2);
+  dict.append("c");
+  BOOST_TEST(dict.total() == 6);
+  BOOST_TEST(dict.wordMap().size() == 3);
+  BOOST_TEST(dict.wordSet().count("c") == 1);
+  BOOST_TEST(dict.sizeSet().begin()->first == "a");
+  BOOST_TEST((dump(kizhin::topWords(dict, 1)) == Ranking{ { "a", 3 } }));
+}
+
+BOOST_AUTO_TEST_SUITE_END();
+
+BOOST_AUTO_TEST_SUITE(wildcard_index);
+
+BOOST_AUTO_TEST_CASE(matches_scan)
+{
+  const kizhin::FrequencyDictionary dict = randomDictionary(23, 3000);
+  const std::vector< std::string > patterns = { "*", "a", "abc", "a*", "*e", "a*e", "*bcd*", "ab*cd*e",
+    "*a*b*c*", "**", "a**b", "*abcde*", "zzz", "", "ab*", "*dd", "c*c*c", "*aaa", "eee*" };
+  for (const auto& pattern: patterns) {
+    const Ranking found = dump(dict.wildcardIndex().find(pattern));
+    BOOST_TEST((found == scanMatches(dict, pattern)), "pattern: " << pattern);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(rebuilt_after_append)
+{
+  kizhin::FrequencyDictionary dict = makeDictionary("apple apply ample");
+  BOOST_TEST(dict.wildcardIndex().find("app*").size() == 2);
+  dict.append("applet");
+  BOOST_TEST((dump(dict.wildcardIndex().find("app*")) == scanMatches(dict, "app*")));
+  BOOST_TEST(dict.wildcardIndex().find("app*").size() == 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,46 @@
+#ifndef SPBSPU_LABS_2025_TP_A_KIZHIN_EVGENIY_F0_TEST_STATE_DIR_HPP
+#define SPBSPU_LABS_2025_TP_A_KIZHIN_EVGENIY_F0_TEST_STATE_DIR_HPP
+
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <ftw.h>
+
+namespace kizhin {
+  inline int removeEntry(const char* path, const struct stat*, int, struct FTW*)
+  {
+    return std::remove(path);
+  }
+
+  inline bool removeTree(const std::string& path)
+  {
+    return ::nftw(path.c_str(), removeEntry, 16, FTW_DEPTH | FTW_PHYS) == 0;
+  }
+
+  struct StateDir
+  {
+    StateDir()
+    {
+      char dir[] = "/tmp/kizhin-f0-XXXXXX";
+      if (!::mkdtemp(dir)) {
+        throw std::runtime_error("Failed to create state directory");
+      }
+      path = dir;
+      if (::setenv("XDG_STATE_HOME", path.c_str(), 1) != 0) {
+        removeTree(path);
+        throw std::runtime_error("Failed to set XDG_STATE_HOME");
+      }
+    }
+    StateDir(const StateDir&) = delete;
+    StateDir& operator=(const StateDir&) = delete;
+    ~StateDir()
+    {
+      BOOST_CHECK(removeTree(path));
+    }
+    std::string path;
+  };
+}
+
+#endif
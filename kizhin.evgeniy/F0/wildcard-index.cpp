@@ -0,0 +1,178 @@
+#include "wildcard-index.hpp"
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+
+namespace kizhin {
+  constexpr std::size_t gramSize = 3;
+
+  std::uint32_t trigramKey(std::string::const_iterator) noexcept;
+  void intersectWith(std::vector< std::uint32_t >&, const std::vector< std::uint32_t >&);
+}
+
+kizhin::WildcardIndex::WildcardIndex(const WordMap& words)
+{
+  words_.reserve(words.size());
+  reversed_.reserve(words.size());
+  for (const auto& word: words) {
+    const std::uint32_t id = words_.size();
+    words_.push_back(std::addressof(word));
+    reversed_.emplace_back(std::string(word.first.rbegin(), word.first.rend()), id);
+    if (word.first.size() < gramSize) {
+      continue;
+    }
+    for (auto it = word.first.cbegin(); it + gramSize <= word.first.cend(); ++it) {
+      Postings& postings = trigrams_[trigramKey(it)];
+      if (postings.empty() || postings.back() != id) {
+        postings.push_back(id);
+      }
+    }
+  }
+  std::sort(reversed_.begin(), reversed_.end());
+}
+
+kizhin::WordRanking kizhin::WildcardIndex::find(const std::string& regexp) const
+{
+  const std::size_t firstStar = regexp.find('*');
+  const std::size_t lastStar = regexp.rfind('*');
+  std::size_t first = 0;
+  std::size_t last = 0;
+  std::tie(first, last) = prefixRange(regexp.substr(0, firstStar));
+  Postings candidates{};
+  bool restricted = false;
+  if (firstStar != std::string::npos && lastStar + 1 != regexp.size()) {
+    candidates = suffixMatches(regexp.substr(lastStar + 1), first, last);
+    restricted = true;
+  }
+  for (std::size_t pos = firstStar; pos < lastStar && first != last;) {
+    const std::size_t next = regexp.find('*', pos + 1);
+    const std::string fragment = regexp.substr(pos + 1, next - pos - 1);
+    if (!fragmentMatches(fragment, candidates, restricted, first, last)) {
+      return WordRanking{};
+    }
+    pos = next;
+  }
+  WordRanking result{};
+  const auto verify = [this, &regexp, &result](std::size_t i) -> void
+  {
+    if (isSatisfied(words_[i]->first, regexp)) {
+      result.push_back(words_[i]);
+    }
+  };
+  if (restricted) {
+    std::for_each(candidates.begin(), candidates.end(), verify);
+  } else {
+    for (std::size_t i = first; i != last; ++i) {
+      verify(i);
+    }
+  }
+  return result;
+}
+
+std::pair< std::size_t, std::size_t > kizhin::WildcardIndex::prefixRange(
+    const std::string& prefix) const
+{
+  const auto less = [](const WordAndSize* word, const std::string& key) -> bool
+  {
+    return word->first.compare(0, key.size(), key) < 0;
+  };
+  const auto greater = [](const std::string& key, const WordAndSize* word) -> bool
+  {
+    return word->first.compare(0, key.size(), key) > 0;
+  };
+  const auto lower = std::lower_bound(words_.begin(), words_.end(), prefix, less);
+  const auto upper = std::upper_bound(lower, words_.end(), prefix, greater);
+  return { lower - words_.begin(), upper - words_.begin() };
+}
+
+kizhin::WildcardIndex::Postings kizhin::WildcardIndex::suffixMatches(
+    const std::string& suffix, std::size_t first, std::size_t last) const
+{
+  const std::string key(suffix.rbegin(), suffix.rend());
+  const auto less = [](const ReversedKey& word, const std::string& key) -> bool
+  {
+    return word.first.compare(0, key.size(), key) < 0;
+  };
+  const auto greater = [](const std::string& key, const ReversedKey& word) -> bool
+  {
+    return word.first.compare(0, key.size(), key) > 0;
+  };
+  const auto lower = std::lower_bound(reversed_.begin(), reversed_.end(), key, less);
+  const auto upper = std::upper_bound(lower, reversed_.end(), key, greater);
+  Postings result{};
+  for (auto it = lower; it != upper; ++it) {
+    if (it->second >= first && it->second < last) {
+      result.push_back(it->second);
+    }
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+bool kizhin::WildcardIndex::fragmentMatches(const std::string& fragment, Postings& candidates,
+    bool& restricted, std::size_t first, std::size_t last) const
+{
+  if (fragment.size() < gramSize) {
+    return true;
+  }
+  std::vector< const Postings* > lists{};
+  for (auto it = fragment.cbegin(); it + gramSize <= fragment.cend(); ++it) {
+    const auto pos = trigrams_.find(trigramKey(it));
+    if (pos == trigrams_.end()) {
+      return false;
+    }
+    lists.push_back(std::addressof(pos->second));
+  }
+  const auto bySize = [](const Postings* lhs, const Postings* rhs) -> bool
+  {
+    return lhs->size() < rhs->size();
+  };
+  std::sort(lists.begin(), lists.end(), bySize);
+  for (const Postings* postings: lists) {
+    if (restricted) {
+      intersectWith(candidates, *postings);
+    } else {
+      const auto lower = std::lower_bound(postings->begin(), postings->end(), first);
+      const auto upper = std::lower_bound(lower, postings->end(), last);
+      candidates.assign(lower, upper);
+      restricted = true;
+    }
+    if (candidates.empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::uint32_t kizhin::trigramKey(std::string::const_iterator it) noexcept
+{
+  const auto byte = [](char c) -> std::uint32_t
+  {
+    return static_cast< unsigned char >(c);
+  };
+  return (byte(it[0]) << 16) | (byte(it[1]) << 8) | byte(it[2]);
+}
+
+void kizhin::intersectWith(std::vector< std::uint32_t >& dest, const std::vector< std::uint32_t >& src)
+{
+  const auto end = std::set_intersection(dest.begin(), dest.end(), src.begin(), src.end(), dest.begin());
+  dest.erase(end, dest.end());
+}
+
+bool kizhin::isSatisfied(const std::string& str, const std::string& reg)
+{
+  auto strPos = str.begin();
+  auto regPos = reg.begin();
+  std::tie(strPos, regPos) = std::mismatch(strPos, str.end(), regPos, reg.end());
+  while (strPos != str.end() && regPos != reg.end()) {
+    if (*regPos == '*') {
+      strPos = std::find(strPos, str.end(), *(++regPos));
+    } else {
+      return false;
+    }
+    std::tie(strPos, regPos) = std::mismatch(strPos, str.end(), regPos, reg.end());
+  }
+  const bool isRegEnd = regPos == reg.end();
+  const bool doesMathcAny = !isRegEnd && *regPos == '*' && std::next(regPos) == reg.end();
+  return strPos == str.end() && (isRegEnd || doesMathcAny);
+}
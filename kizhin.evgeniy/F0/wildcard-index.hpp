@@ -0,0 +1,35 @@
+#ifndef SPBSPU_LABS_2025_TP_A_KIZHIN_EVGENIY_F0_WILDCARD_INDEX_HPP
+#define SPBSPU_LABS_2025_TP_A_KIZHIN_EVGENIY_F0_WILDCARD_INDEX_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <unordered-map.hpp>
+#include "freq-dict.hpp"
+
+namespace kizhin {
+  bool isSatisfied(const std::string& str, const std::string& regexp);
+
+  class WildcardIndex
+  {
+  public:
+    explicit WildcardIndex(const WordMap&);
+
+    WordRanking find(const std::string& regexp) const;
+
+  private:
+    using Postings = std::vector< std::uint32_t >;
+    using ReversedKey = std::pair< std::string, std::uint32_t >;
+
+    WordRanking words_{};
+    std::vector< ReversedKey > reversed_{};
+    UnorderedMap< std::uint32_t, Postings > trigrams_{};
+
+    std::pair< std::size_t, std::size_t > prefixRange(const std::string&) const;
+    Postings suffixMatches(const std::string&, std::size_t, std::size_t) const;
+    bool fragmentMatches(const std::string&, Postings&, bool&, std::size_t, std::size_t) const;
+  };
+}
+
+#endif
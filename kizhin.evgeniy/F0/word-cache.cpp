@@ -0,0 +1,178 @@
+#include "word-cache.hpp"
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <vector>
+#include <sys/stat.h>
+#include <mapped-file.hpp>
+#include "state.hpp"
+
+namespace kizhin {
+  using Word = std::uint64_t;
+
+  constexpr char cacheMagic[4] = { 'F', 'D', 'W', 'C' };
+  constexpr std::uint32_t cacheVersion = 2;
+
+  struct CacheHeader
+  {
+    char magic[4];
+    std::uint32_t version;
+    Word size;
+    Word mtime;
+    Word inode;
+    Word pathLength;
+    Word wordCount;
+  };
+
+  FileStamp makeFileStamp(const struct stat&) noexcept;
+  std::string canonicalPath(const std::string&);
+  std::string cacheFileFor(const std::string&);
+  bool expandFromCache(const MappedFile&, const std::string&, const struct stat&, FrequencyDictionary&);
+  void saveCache(const std::string&, const std::string&, const FileStamp&, const WordMap&);
+  std::size_t padding(std::size_t) noexcept;
+}
+
+std::string kizhin::getCacheDir()
+{
+  return getStateDir() + "/freq_dict.cache";
+}
+
+bool kizhin::operator==(const FileStamp& lhs, const FileStamp& rhs) noexcept
+{
+  return lhs.size == rhs.size && lhs.mtime == rhs.mtime && lhs.inode == rhs.inode;
+}
+
+kizhin::FileStamp kizhin::getFileStamp(const std::string& filename)
+{
+  struct stat info{};
+  if (::stat(filename.c_str(), &info) == -1) {
+    return FileStamp{};
+  }
+  return makeFileStamp(info);
+}
+
+bool kizhin::loadCachedWords(const std::string& filename, FrequencyDictionary& dict)
+{
+  struct stat info{};
+  if (::stat(filename.c_str(), &info) == -1) {
+    return false;
+  }
+  const std::string path = canonicalPath(filename);
+  return expandFromCache(MappedFile(cacheFileFor(path), std::nothrow), path, info, dict);
+}
+
+void kizhin::saveCachedWords(const std::string& filename, const FileStamp& stamp,
+    const FrequencyDictionary& dict)
+{
+  const std::string path = canonicalPath(filename);
+  saveCache(cacheFileFor(path), path, stamp, dict.wordMap());
+}
+
+kizhin::FileStamp kizhin::makeFileStamp(const struct stat& info) noexcept
+{
+  const Word seconds = static_cast< Word >(info.st_mtim.tv_sec);
+  const Word mtime = seconds * 1000000000 + static_cast< Word >(info.st_mtim.tv_nsec);
+  return { static_cast< Word >(info.st_size), mtime, static_cast< Word >(info.st_ino) };
+}
+
+std::string kizhin::canonicalPath(const std::string& filename)
+{
+  char resolved[PATH_MAX]{};
+  return ::realpath(filename.c_str(), resolved) ? resolved : filename;
+}
+
+std::string kizhin::cacheFileFor(const std::string& path)
+{
+  std::ostringstream name{};
+  name << getCacheDir() << '/' << std::hex << std::hash< std::string >{}(path) << ".wcache";
+  return name.str();
+}
+
+bool kizhin::expandFromCache(const MappedFile& file, const std::string& path,
+    const struct stat& info, FrequencyDictionary& dict)
+{
+  const char* data = file.data();
+  const std::size_t size = file.size();
+  if (size < sizeof(CacheHeader)) {
+    return false;
+  }
+  CacheHeader header{};
+  std::memcpy(std::addressof(header), data, sizeof(header));
+  const FileStamp stamp = makeFileStamp(info);
+  const bool sameSource = header.size == stamp.size && header.mtime == stamp.mtime && header.inode == stamp.inode;
+  if (std::memcmp(header.magic, cacheMagic, sizeof(cacheMagic)) != 0 || header.version != cacheVersion || !sameSource) {
+    return false;
+  }
+  std::size_t pos = sizeof(header);
+  if (header.pathLength != path.size() || size - pos < path.size() + padding(path.size())) {
+    return false;
+  }
+  if (path.compare(0, path.size(), data + pos, path.size()) != 0) {
+    return false;
+  }
+  pos += path.size() + padding(path.size());
+  const std::size_t words = (size - pos) / sizeof(Word);
+  if (words == 0 || header.wordCount > (words - 1) / 2) {
+    return false;
+  }
+  const Word* offsets = reinterpret_cast< const Word* >(data + pos);
+  const Word* counts = offsets + header.wordCount + 1;
+  const char* chars = reinterpret_cast< const char* >(counts + header.wordCount);
+  const std::size_t charsSize = size - (chars - data);
+  if (offsets[header.wordCount] > charsSize) {
+    return false;
+  }
+  for (std::size_t i = 0; i != header.wordCount; ++i) {
+    if (offsets[i] > offsets[i + 1] || offsets[i + 1] > charsSize) {
+      return false;
+    }
+  }
+  for (std::size_t i = 0; i != header.wordCount; ++i) {
+    dict.append(std::string(chars + offsets[i], offsets[i + 1] - offsets[i]), counts[i]);
+  }
+  return true;
+}
+
+void kizhin::saveCache(const std::string& cacheFile, const std::string& path,
+    const FileStamp& stamp, const WordMap& counts)
+{
+  ::mkdir(getCacheDir().c_str(), 0755);
+  const std::string tmpFile = cacheFile + ".tmp";
+  std::ofstream out(tmpFile, std::ios::binary);
+  if (!out) {
+    return;
+  }
+  const CacheHeader header{ { cacheMagic[0], cacheMagic[1], cacheMagic[2], cacheMagic[3] }, cacheVersion,
+    stamp.size, stamp.mtime, stamp.inode, path.size(), counts.size() };
+  out.write(reinterpret_cast< const char* >(std::addressof(header)), sizeof(header));
+  const char zeros[sizeof(Word)]{};
+  out.write(path.data(), path.size());
+  out.write(zeros, padding(path.size()));
+  std::vector< Word > offsets{ 0 };
+  std::vector< Word > sizes{};
+  offsets.reserve(counts.size() + 1);
+  sizes.reserve(counts.size());
+  for (const auto& word: counts) {
+    offsets.push_back(offsets.back() + word.first.size());
+    sizes.push_back(word.second);
+  }
+  out.write(reinterpret_cast< const char* >(offsets.data()), offsets.size() * sizeof(Word));
+  out.write(reinterpret_cast< const char* >(sizes.data()), sizes.size() * sizeof(Word));
+  for (const auto& word: counts) {
+    out.write(word.first.data(), word.first.size());
+  }
+  out.close();
+  if (!out || std::rename(tmpFile.c_str(), cacheFile.c_str()) != 0) {
+    std::remove(tmpFile.c_str());
+  }
+}
+
+std::size_t kizhin::padding(std::size_t size) noexcept
+{
+  return (sizeof(Word) - size % sizeof(Word)) % sizeof(Word);
+}
@@ -0,0 +1,23 @@
+#ifndef SPBSPU_LABS_2025_TP_A_KIZHIN_EVGENIY_F0_WORD_CACHE_HPP
+#define SPBSPU_LABS_2025_TP_A_KIZHIN_EVGENIY_F0_WORD_CACHE_HPP
+
+#include <cstdint>
+#include <string>
+#include "freq-dict.hpp"
+
+namespace kizhin {
+  struct FileStamp
+  {
+    std::uint64_t size = 0;
+    std::uint64_t mtime = 0;
+    std::uint64_t inode = 0;
+  };
+  bool operator==(const FileStamp&, const FileStamp&) noexcept;
+  FileStamp getFileStamp(const std::string& filename);
+
+  std::string getCacheDir();
+  bool loadCachedWords(const std::string& filename, FrequencyDictionary&);
+  void saveCachedWords(const std::string& filename, const FileStamp&, const FrequencyDictionary&);
+}
+
+#endif
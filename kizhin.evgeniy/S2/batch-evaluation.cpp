@@ -0,0 +1,146 @@
+#include "batch-evaluation.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <buffer.hpp>
+#include "io-utils.hpp"
+
+namespace kizhin {
+  using number_type = PostfixExpression::number_type;
+
+  struct LineBlock
+  {
+    Buffer< std::string > lines;
+    Buffer< number_type > results;
+    std::exception_ptr error;
+  };
+
+  number_type evaluateLine(const std::string&);
+  void evaluateBlock(LineBlock&);
+  bool readBlock(std::istream&, LineBlock&, std::size_t);
+  std::size_t readWave(std::istream&, Buffer< LineBlock >&, std::size_t);
+  void evaluateWave(Buffer< LineBlock >&, std::size_t, std::size_t);
+}
+
+kizhin::ForwardList< kizhin::PostfixExpression::number_type > kizhin::evaluateSerial(
+    std::istream& in)
+{
+  std::string current;
+  ForwardList< number_type > results;
+  while (std::getline(in, current)) {
+    if (!current.empty()) {
+      results.pushFront(evaluateLine(current));
+    }
+  }
+  return results;
+}
+
+kizhin::ForwardList< kizhin::PostfixExpression::number_type > kizhin::evaluateBatch(
+    std::istream& in, const BatchOptions& options)
+{
+  std::size_t threads = options.threads;
+  if (threads == 0) {
+    threads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  const std::size_t blockSize = std::max(options.blockSize, std::size_t(1));
+  const std::size_t waveSize = threads * std::max(options.blocksPerWave, std::size_t(1));
+  ForwardList< number_type > results;
+  Buffer< LineBlock > wave(waveSize, LineBlock{});
+  std::size_t filled = readWave(in, wave, blockSize);
+  while (filled != 0) {
+    evaluateWave(wave, filled, threads);
+    for (auto it = wave.begin(), end = wave.begin() + filled; it != end; ++it) {
+      if (it->error) {
+        std::rethrow_exception(it->error);
+      }
+      for (const number_type value: it->results) {
+        results.pushFront(value);
+      }
+    }
+    filled = readWave(in, wave, blockSize);
+  }
+  return results;
+}
+
+kizhin::PostfixExpression::number_type kizhin::evaluateLine(const std::string& line)
+{
+  std::stringstream stream(line);
+  return inputPostfixExpression(stream).evaluate();
+}
+
+void kizhin::evaluateBlock(LineBlock& block)
+{
+  try {
+    for (const std::string& line: block.lines) {
+      block.results.pushBack(evaluateLine(line));
+    }
+  } catch (...) {
+    block.error = std::current_exception();
+  }
+}
+
+bool kizhin::readBlock(std::istream& in, LineBlock& block, const std::size_t blockSize)
+{
+  block.lines.clear();
+  block.results.clear();
+  block.error = nullptr;
+  std::string current;
+  while (block.lines.size() != blockSize && std::getline(in, current)) {
+    if (!current.empty()) {
+      block.lines.pushBack(std::move(current));
+    }
+  }
+  return !block.lines.empty();
+}
+
+std::size_t kizhin::readWave(std::istream& in, Buffer< LineBlock >& wave,
+    const std::size_t blockSize)
+{
+  std::size_t filled = 0;
+  for (auto it = wave.begin(); it != wave.end() && readBlock(in, *it, blockSize); ++it) {
+    ++filled;
+  }
+  return filled;
+}
+
+void kizhin::evaluateWave(Buffer< LineBlock >& wave, const std::size_t filled,
+    const std::size_t threads)
+{
+  std::atomic< std::size_t > next(0);
+  std::atomic< std::size_t > firstError(std::numeric_limits< std::size_t >::max());
+  auto worker = [&wave, &next, &firstError, filled]() -> void
+  {
+    for (std::size_t i = next++; i < filled; i = next++) {
+      if (i > firstError.load(std::memory_order_relaxed)) {
+        continue;
+      }
+      LineBlock& block = *(wave.begin() + i);
+      evaluateBlock(block);
+      if (block.error) {
+        std::size_t expected = firstError.load();
+        while (i < expected && !firstError.compare_exchange_weak(expected, i)) {
+        }
+      }
+    }
+  };
+  const std::size_t helpers = std::min(threads, filled) - 1;
+  std::unique_ptr< std::thread[] > pool(new std::thread[helpers]);
+  std::size_t started = 0;
+  try {
+    for (; started != helpers; ++started) {
+      pool[started] = std::thread(worker);
+    }
+  } catch (const std::system_error&) {
+  }
+  worker();
+  for (std::size_t i = 0; i != started; ++i) {
+    pool[i].join();
+  }
+}
@@ -0,0 +1,24 @@
+#ifndef SPBSPU_LABS_2025_AADS_A_KIZHIN_EVGENIY_S2_BATCH_EVALUATION_HPP
+#define SPBSPU_LABS_2025_AADS_A_KIZHIN_EVGENIY_S2_BATCH_EVALUATION_HPP
+
+#include <cstddef>
+#include <iosfwd>
+#include <forward-list.hpp>
+#include "postfix-expression.hpp"
+
+namespace kizhin {
+  struct BatchOptions;
+
+  ForwardList< PostfixExpression::number_type > evaluateSerial(std::istream&);
+  ForwardList< PostfixExpression::number_type > evaluateBatch(std::istream&,
+      const BatchOptions&);
+}
+
+struct kizhin::BatchOptions
+{
+  std::size_t threads = 0;
+  std::size_t blockSize = 4096;
+  std::size_t blocksPerWave = 4;
+};
+
+#endif
@@ -1,35 +1,34 @@
+#include <cstring>
 #include <fstream>
 #include <iostream>
-#include <sstream>
 #include <stdexcept>
 #include <forward-list.hpp>
-#include "io-utils.hpp"
-#include "postfix-expression.hpp"
+#include "batch-evaluation.hpp"
 
 int main(int argc, char** argv)
 {
   using namespace kizhin;
   try {
-    if (argc > 2) {
-      std::cerr << "Usage: " << argv[0] << " [filename]\n";
+    const bool batch = argc > 1 && std::strcmp(argv[1], "--batch") == 0;
+    const int firstFile = batch ? 2 : 1;
+    if (argc > firstFile + 1) {
+      std::cerr << "Usage: " << argv[0] << " [--batch] [filename]\n";
       return 1;
     }
     std::ifstream fin;
-    if (argc == 2) {
-      std::string filePath = argv[1];
+    if (argc == firstFile + 1) {
+      std::string filePath = argv[firstFile];
       fin.open(filePath);
       if (!fin) {
         throw std::logic_error("Failed to open file: " + filePath);
       }
     }
     std::istream& in = fin.is_open() ? fin : std::cin;
-    std::string current;
     ForwardList< PostfixExpression::number_type > results;
-    while (std::getline(in, current)) {
-      if (!current.empty()) {
-        std::stringstream stream(current);
-        results.pushFront(inputPostfixExpression(stream).evaluate());
-      }
+    if (batch) {
+      results = evaluateBatch(in, BatchOptions{});
+    } else {
+      results = evaluateSerial(in);
     }
     if (!results.empty()) {
       std::cout << results.front();
@@ -0,0 +1,81 @@
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include "batch-evaluation.hpp"
+
+namespace {
+  std::string makeInput(const std::size_t lines)
+  {
+    std::string result;
+    for (std::size_t i = 0; i != lines; ++i) {
+      result += "( " + std::to_string(i) + " + 2 ) * 3 - " + std::to_string(i % 7) + "\n";
+      if (i % 5 == 0) {
+        result += "\n";
+      }
+    }
+    return result;
+  }
+
+  std::string evaluationError(std::string (*evaluate)(const std::string&),
+      const std::string& input)
+  {
+    try {
+      evaluate(input);
+    } catch (const std::exception& e) {
+      return e.what();
+    }
+    return "";
+  }
+
+  std::string serialResults(const std::string& input)
+  {
+    std::istringstream in(input);
+    std::ostringstream out;
+    for (const auto value: kizhin::evaluateSerial(in)) {
+      out << value << ' ';
+    }
+    return out.str();
+  }
+
+  std::string batchResults(const std::string& input)
+  {
+    std::istringstream in(input);
+    kizhin::BatchOptions options;
+    options.threads = 4;
+    options.blockSize = 3;
+    options.blocksPerWave = 2;
+    std::ostringstream out;
+    for (const auto value: kizhin::evaluateBatch(in, options)) {
+      out << value << ' ';
+    }
+    return out.str();
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(batch_evaluation);
+
+BOOST_AUTO_TEST_CASE(empty_input)
+{
+  BOOST_TEST(batchResults("").empty());
+  BOOST_TEST(batchResults("\n\n\n").empty());
+}
+
+BOOST_AUTO_TEST_CASE(matches_serial_order)
+{
+  const std::string input = makeInput(100);
+  BOOST_TEST(batchResults(input) == serialResults(input));
+}
+
+BOOST_AUTO_TEST_CASE(reports_first_error)
+{
+  std::string input = makeInput(20);
+  input += "1 / 0\n";
+  input += makeInput(20);
+  input += "9223372036854775807 + 1\n";
+  const std::string expected = evaluationError(serialResults, input);
+  BOOST_TEST(!expected.empty());
+  BOOST_TEST(evaluationError(batchResults, input) == expected);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -62,12 +62,12 @@ void kizhin::outVertexes(const GraphContainer& graphs, std::ostream& out,
   if (!(in >> graphName)) {
     throw std::logic_error("Falied to input key");
   }
-  VertexContainer vertexes = getVertices(graphs.at(graphName));
+  const Graph::VertexCounter& vertexes = graphs.at(graphName).vertices();
   if (vertexes.empty()) {
     out << '\n';
   }
-  for (const Vertex& vertex: vertexes) {
-    out << vertex << '\n';
+  for (const auto& vertex: vertexes) {
+    out << vertex.first << '\n';
   }
 }
 
@@ -83,7 +83,7 @@ void kizhin::outOutbound(const GraphContainer& graphs, std::ostream& out,
   if (graph.empty()) {
     throw std::logic_error("Empty graph");
   }
-  SortedGraph outbounds = getOutbound(graph, vertex);
+  SortedGraph outbounds = graph.outbound(vertex);
   if (outbounds.empty()) {
     out << '\n';
   }
@@ -109,7 +109,7 @@ void kizhin::outInbound(const GraphContainer& graphs, std::ostream& out, std::is
   if (graph.empty()) {
     throw std::logic_error("Empty graph");
   }
-  SortedGraph inbounds = getInbound(graph, vertex);
+  SortedGraph inbounds = graph.inbound(vertex);
   if (inbounds.empty()) {
     out << '\n';
   }
@@ -134,7 +134,7 @@ void kizhin::bindEdge(GraphContainer& graphs, std::istream& in)
     throw std::logic_error("Falied to input key");
   }
   Graph& target = graphs.at(graphName);
-  target[{ from, to }].insert(weight);
+  target.bind({ from, to }, weight);
 }
 
 void kizhin::cutEdge(GraphContainer& graphs, std::istream& in)
@@ -147,19 +147,7 @@ void kizhin::cutEdge(GraphContainer& graphs, std::istream& in)
     throw std::logic_error("Falied to input key");
   }
   Graph& graph = graphs.at(graphName);
-  auto edgePos = graph.find({ from, to });
-  if (edgePos == graph.end()) {
-    throw std::logic_error("Failed to find edge");
-  }
-  WeightContiner& weights = edgePos->second;
-  auto weightPos = weights.find(weight);
-  if (weightPos == weights.end()) {
-    throw std::logic_error("Failed to find weight");
-  }
-  weights.erase(weightPos);
-  if (weights.empty()) {
-    graph.erase(edgePos);
-  }
+  graph.cut({ from, to }, weight);
   if (graph.empty()) {
     graphs.erase(graphName);
   }
@@ -178,7 +166,7 @@ void kizhin::create(GraphContainer& graphs, std::istream& in)
   }
   Vertex current{};
   while (graph.size() != vertexCount && (in >> current)) {
-    graph[{ current, current }];
+    graph.bind({ current, current }, WeightContiner{});
   }
   if (graph.size() != vertexCount) {
     throw std::logic_error("Failed to input vertexes");
@@ -197,13 +185,7 @@ void kizhin::merge(GraphContainer& graphs, std::istream& in)
   if (!graphs.count(firstSrc) || !graphs.count(secondSrc) || graphs.count(dest)) {
     throw std::logic_error("Falied to perform merge");
   }
-  Graph result = graphs[firstSrc];
-  for (const auto& edge: graphs[secondSrc]) {
-    const VertexPair& vertexes = edge.first;
-    const WeightContiner& weights = edge.second;
-    result[vertexes].insert(weights.begin(), weights.end());
-  }
-  result.insert(graphs[secondSrc].begin(), graphs[secondSrc].end());
+  Graph result = unite(graphs[firstSrc], graphs[secondSrc]);
   graphs[dest] = std::move(result);
 }
 
@@ -231,7 +213,7 @@ void kizhin::extract(GraphContainer& graphs, std::istream& in)
   for (const auto& edge: src) {
     const VertexPair& srcVertexes = edge.first;
     if (vertexes.count(srcVertexes.from) && vertexes.count(srcVertexes.to)) {
-      result.insert(edge);
+      result.bind(srcVertexes, edge.second);
     }
   }
   graphs.insert({ std::move(dest), std::move(result) });
@@ -0,0 +1,219 @@
+#include "graph-file.hpp"
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+#include <mapped-file.hpp>
+
+namespace kizhin {
+  using Word = std::uint64_t;
+
+  constexpr char fileMagic[4] = { 'G', 'R', 'P', 'H' };
+  constexpr std::uint32_t fileVersion = 1;
+
+  struct FileHeader
+  {
+    char magic[4];
+    std::uint32_t version;
+    Word stringCount;
+    Word graphCount;
+  };
+
+  struct GraphHeader
+  {
+    Word name;
+    Word vertexCount;
+    Word edgeCount;
+  };
+
+  std::size_t wordsLeft(const MappedFile&, std::size_t) noexcept;
+  const Word* wordsAt(const MappedFile&, std::size_t&, std::size_t);
+  std::vector< std::string > readStringTable(const MappedFile&, std::size_t&, Word);
+  void readGraph(const MappedFile&, std::size_t&, const std::vector< std::string >&, GraphContainer&);
+  void writeWords(std::ostream&, const std::vector< Word >&);
+}
+
+std::size_t kizhin::wordsLeft(const MappedFile& file, std::size_t pos) noexcept
+{
+  return (file.size() - pos) / sizeof(Word);
+}
+
+const kizhin::Word* kizhin::wordsAt(const MappedFile& file, std::size_t& pos, std::size_t count)
+{
+  if (count > wordsLeft(file, pos)) {
+    throw std::runtime_error("Failed to read graph file: unexpected end of data");
+  }
+  const Word* result = reinterpret_cast< const Word* >(file.data() + pos);
+  pos += count * sizeof(Word);
+  return result;
+}
+
+std::vector< std::string > kizhin::readStringTable(const MappedFile& file, std::size_t& pos, Word count)
+{
+  if (count >= wordsLeft(file, pos)) {
+    throw std::runtime_error("Failed to read graph file: unexpected end of data");
+  }
+  const Word* offsets = wordsAt(file, pos, count + 1);
+  const Word charsSize = offsets[count];
+  if (charsSize > file.size() - pos) {
+    throw std::runtime_error("Failed to read graph file: unexpected end of data");
+  }
+  const char* chars = file.data() + pos;
+  pos += charsSize + (sizeof(Word) - charsSize % sizeof(Word)) % sizeof(Word);
+  if (pos > file.size()) {
+    throw std::runtime_error("Failed to read graph file: unexpected end of data");
+  }
+  std::vector< std::string > result{};
+  result.reserve(count);
+  for (std::size_t i = 0; i != count; ++i) {
+    if (offsets[i] > offsets[i + 1] || offsets[i + 1] > charsSize) {
+      throw std::runtime_error("Failed to read graph file: bad string table");
+    }
+    result.emplace_back(chars + offsets[i], offsets[i + 1] - offsets[i]);
+  }
+  return result;
+}
+
+void kizhin::readGraph(const MappedFile& file, std::size_t& pos,
+    const std::vector< std::string >& strings, GraphContainer& dest)
+{
+  GraphHeader header{};
+  std::memcpy(std::addressof(header), wordsAt(file, pos, sizeof(header) / sizeof(Word)), sizeof(header));
+  const std::size_t left = wordsLeft(file, pos);
+  if (header.vertexCount >= left || header.edgeCount > left / 2) {
+    throw std::runtime_error("Failed to read graph file: unexpected end of data");
+  }
+  const std::size_t vertexCount = header.vertexCount;
+  const Word* names = wordsAt(file, pos, vertexCount);
+  const Word* offsets = wordsAt(file, pos, vertexCount + 1);
+  const Word* targets = wordsAt(file, pos, header.edgeCount);
+  const Word* weights = wordsAt(file, pos, header.edgeCount);
+  if (header.name >= strings.size() || offsets[vertexCount] != header.edgeCount) {
+    throw std::runtime_error("Failed to read graph file: bad graph record");
+  }
+  Graph result{};
+  for (std::size_t i = 0; i != vertexCount; ++i) {
+    if (names[i] >= strings.size() || offsets[i] > offsets[i + 1] || offsets[i + 1] > header.edgeCount) {
+      throw std::runtime_error("Failed to read graph file: bad graph record");
+    }
+    for (Word first = offsets[i]; first != offsets[i + 1];) {
+      if (targets[first] >= vertexCount || names[targets[first]] >= strings.size()) {
+        throw std::runtime_error("Failed to read graph file: bad graph record");
+      }
+      Word last = first;
+      WeightContiner run{};
+      for (; last != offsets[i + 1] && targets[last] == targets[first]; ++last) {
+        run.insert(run.end(), weights[last]);
+      }
+      result.bind({ strings[names[i]], strings[names[targets[first]]] }, run);
+      first = last;
+    }
+  }
+  dest[strings[header.name]] = std::move(result);
+}
+
+void kizhin::writeWords(std::ostream& out, const std::vector< Word >& words)
+{
+  out.write(reinterpret_cast< const char* >(words.data()), words.size() * sizeof(Word));
+}
+
+bool kizhin::isBinaryGraphFile(std::istream& in)
+{
+  char head[sizeof(fileMagic)]{};
+  const auto start = in.tellg();
+  in.read(head, sizeof(head));
+  const bool result = in && std::memcmp(head, fileMagic, sizeof(fileMagic)) == 0;
+  in.clear();
+  in.seekg(start);
+  return result;
+}
+
+kizhin::GraphContainer kizhin::loadBinaryGraphs(const std::string& filename)
+{
+  const MappedFile file(filename);
+  FileHeader header{};
+  if (file.size() < sizeof(header)) {
+    throw std::runtime_error("Failed to read graph file: unexpected end of data");
+  }
+  std::memcpy(std::addressof(header), file.data(), sizeof(header));
+  if (std::memcmp(header.magic, fileMagic, sizeof(fileMagic)) != 0 || header.version != fileVersion) {
+    throw std::runtime_error("Failed to read graph file: unsupported format");
+  }
+  std::size_t pos = sizeof(header);
+  const std::vector< std::string > strings = readStringTable(file, pos, header.stringCount);
+  GraphContainer result{};
+  for (std::size_t g = 0; g != header.graphCount; ++g) {
+    readGraph(file, pos, strings, result);
+  }
+  return result;
+}
+
+void kizhin::saveBinaryGraphs(std::ostream& out, const GraphContainer& graphs)
+{
+  std::map< std::string, Word > ids{};
+  std::vector< const std::string* > strings{};
+  const auto intern = [&ids, &strings](const std::string& str) -> Word
+  {
+    const auto inserted = ids.emplace(str, strings.size());
+    if (inserted.second) {
+      strings.push_back(std::addressof(inserted.first->first));
+    }
+    return inserted.first->second;
+  };
+  for (const auto& graph: graphs) {
+    intern(graph.first);
+    for (const auto& vertex: graph.second.vertices()) {
+      intern(vertex.first);
+    }
+  }
+
+  const FileHeader header{ { fileMagic[0], fileMagic[1], fileMagic[2], fileMagic[3] }, fileVersion,
+    strings.size(), graphs.size() };
+  out.write(reinterpret_cast< const char* >(std::addressof(header)), sizeof(header));
+  std::vector< Word > stringOffsets{ 0 };
+  for (const std::string* str: strings) {
+    stringOffsets.push_back(stringOffsets.back() + str->size());
+  }
+  writeWords(out, stringOffsets);
+  for (const std::string* str: strings) {
+    out.write(str->data(), str->size());
+  }
+  const char padding[sizeof(Word)]{};
+  out.write(padding, (sizeof(Word) - stringOffsets.back() % sizeof(Word)) % sizeof(Word));
+
+  for (const auto& graph: graphs) {
+    const Graph::VertexCounter& vertices = graph.second.vertices();
+    std::map< Vertex, Word > indices{};
+    std::vector< Word > names{};
+    for (const auto& vertex: vertices) {
+      indices.emplace_hint(indices.end(), vertex.first, names.size());
+      names.push_back(ids.at(vertex.first));
+    }
+    std::vector< Word > offsets{ 0 };
+    std::vector< Word > targets{};
+    std::vector< Word > weights{};
+    for (const auto& vertex: vertices) {
+      for (const auto& edge: graph.second.outbound(vertex.first)) {
+        const Word target = indices.at(edge.first.to);
+        for (Weight weight: edge.second) {
+          targets.push_back(target);
+          weights.push_back(weight);
+        }
+      }
+      offsets.push_back(targets.size());
+    }
+    const GraphHeader graphHeader{ ids.at(graph.first), names.size(), targets.size() };
+    out.write(reinterpret_cast< const char* >(std::addressof(graphHeader)), sizeof(graphHeader));
+    writeWords(out, names);
+    writeWords(out, offsets);
+    writeWords(out, targets);
+    writeWords(out, weights);
+  }
+  if (!out) {
+    throw std::runtime_error("Failed to write graph file");
+  }
+}
@@ -0,0 +1,13 @@
+#ifndef SPBSPU_LABS_2025_AADS_A_KIZHIN_EVGENIY_S7_GRAPH_FILE_HPP
+#define SPBSPU_LABS_2025_AADS_A_KIZHIN_EVGENIY_S7_GRAPH_FILE_HPP
+
+#include <iosfwd>
+#include "command-processor.hpp"
+
+namespace kizhin {
+  bool isBinaryGraphFile(std::istream&);
+  GraphContainer loadBinaryGraphs(const std::string& filename);
+  void saveBinaryGraphs(std::ostream&, const GraphContainer&);
+}
+
+#endif
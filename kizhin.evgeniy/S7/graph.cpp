@@ -1,29 +1,16 @@
 #include "graph.hpp"
 #include <algorithm>
+#include <iterator>
+#include <stdexcept>
 #include <tuple>
 #include <boost/hash2/fnv1a.hpp>
 #include <boost/hash2/hash_append.hpp>
 
 namespace kizhin {
-  struct VertexEdgeFrom
-  {
-    Vertex lhs{};
-    bool operator()(Graph::const_reference rhs) const
-    {
-      const VertexPair& vertexes = rhs.first;
-      return lhs == vertexes.from;
-    }
-  };
-
-  struct VertexEdgeTo
-  {
-    Vertex lhs{};
-    bool operator()(Graph::const_reference rhs) const
-    {
-      const VertexPair& vertexes = rhs.first;
-      return lhs == vertexes.to;
-    }
-  };
+  template < typename Map >
+  const typename Map::mapped_type& findOrEmpty(const Map&, const typename Map::key_type&);
+  template < typename Set >
+  Set unite(const Set&, const Set&);
 }
 
 std::size_t std::hash< kizhin::VertexPair >::operator()(
@@ -48,30 +35,203 @@ bool kizhin::operator<(const VertexPair& lhs, const VertexPair& rhs)
   return lhsTuple < rhsTuple;
 }
 
-kizhin::VertexContainer kizhin::getVertices(const Graph& graph)
+bool kizhin::Graph::empty() const noexcept
+{
+  return edges_.empty();
+}
+
+std::size_t kizhin::Graph::size() const noexcept
+{
+  return edges_.size();
+}
+
+kizhin::Graph::const_iterator kizhin::Graph::begin() const noexcept
+{
+  return edges_.begin();
+}
+
+kizhin::Graph::const_iterator kizhin::Graph::end() const noexcept
+{
+  return edges_.end();
+}
+
+kizhin::Graph::const_iterator kizhin::Graph::find(const key_type& edge) const
 {
-  VertexContainer result;
-  for (const auto& edge: graph) {
-    const VertexPair& vertexes = edge.first;
-    result.insert(vertexes.from);
-    result.insert(vertexes.to);
+  return edges_.find(edge);
+}
+
+void kizhin::Graph::bind(const key_type& edge, Weight weight)
+{
+  emplaceEdge(edge)->second.insert(weight);
+}
+
+void kizhin::Graph::bind(const key_type& edge, const WeightContiner& weights)
+{
+  emplaceEdge(edge)->second.insert(weights.begin(), weights.end());
+}
+
+void kizhin::Graph::cut(const key_type& edge, Weight weight)
+{
+  auto edgePos = edges_.find(edge);
+  if (edgePos == edges_.end()) {
+    throw std::logic_error("Failed to find edge");
+  }
+  WeightContiner& weights = edgePos->second;
+  auto weightPos = weights.find(weight);
+  if (weightPos == weights.end()) {
+    throw std::logic_error("Failed to find weight");
+  }
+  weights.erase(weightPos);
+  if (weights.empty()) {
+    edges_.erase(edgePos);
+    unlinkEdge(edge);
   }
-  return result;
 }
 
-kizhin::SortedGraph kizhin::getOutbound(const Graph& graph, const Vertex& vertex)
+const kizhin::Graph::VertexCounter& kizhin::Graph::vertices() const noexcept
+{
+  return vertices_;
+}
+
+kizhin::SortedGraph kizhin::Graph::outbound(const Vertex& vertex) const
 {
   SortedGraph result;
-  auto out = std::inserter(result, result.end());
-  std::copy_if(graph.begin(), graph.end(), out, VertexEdgeFrom{ vertex });
+  auto targets = outbound_.find(vertex);
+  if (targets == outbound_.end()) {
+    return result;
+  }
+  for (const Vertex& to: targets->second) {
+    const VertexPair edge{ vertex, to };
+    result.emplace_hint(result.end(), edge, edges_.at(edge));
+  }
   return result;
 }
 
-kizhin::SortedGraph kizhin::getInbound(const Graph& graph, const Vertex& vertex)
+kizhin::SortedGraph kizhin::Graph::inbound(const Vertex& vertex) const
 {
   SortedGraph result;
-  auto out = std::inserter(result, result.end());
-  std::copy_if(graph.begin(), graph.end(), out, VertexEdgeTo{ vertex });
+  auto sources = inbound_.find(vertex);
+  if (sources == inbound_.end()) {
+    return result;
+  }
+  for (const Vertex& from: sources->second) {
+    const VertexPair edge{ from, vertex };
+    result.emplace_hint(result.end(), edge, edges_.at(edge));
+  }
+  return result;
+}
+
+kizhin::Graph::Edges::iterator kizhin::Graph::emplaceEdge(const key_type& edge)
+{
+  auto pos = edges_.find(edge);
+  if (pos != edges_.end()) {
+    return pos;
+  }
+  linkEdge(edge);
+  try {
+    return edges_.emplace(edge, mapped_type{}).first;
+  } catch (...) {
+    unlinkEdge(edge);
+    throw;
+  }
+}
+
+void kizhin::Graph::linkEdge(const key_type& edge)
+{
+  try {
+    outbound_[edge.from].insert(edge.to);
+    inbound_[edge.to].insert(edge.from);
+    auto fromPos = vertices_.emplace(edge.from, 0).first;
+    auto toPos = vertices_.emplace(edge.to, 0).first;
+    ++fromPos->second;
+    ++toPos->second;
+  } catch (...) {
+    pruneEdge(edge);
+    throw;
+  }
+}
+
+void kizhin::Graph::unlinkEdge(const key_type& edge) noexcept
+{
+  --vertices_.find(edge.from)->second;
+  --vertices_.find(edge.to)->second;
+  pruneEdge(edge);
+}
+
+void kizhin::Graph::pruneEdge(const key_type& edge) noexcept
+{
+  auto targets = outbound_.find(edge.from);
+  if (targets != outbound_.end()) {
+    targets->second.erase(edge.to);
+    if (targets->second.empty()) {
+      outbound_.erase(targets);
+    }
+  }
+  auto sources = inbound_.find(edge.to);
+  if (sources != inbound_.end()) {
+    sources->second.erase(edge.from);
+    if (sources->second.empty()) {
+      inbound_.erase(sources);
+    }
+  }
+  const Vertex* ends[] = { &edge.from, &edge.to };
+  for (const Vertex* vertex: ends) {
+    auto pos = vertices_.find(*vertex);
+    if (pos != vertices_.end() && pos->second == 0) {
+      vertices_.erase(pos);
+    }
+  }
+}
+
+kizhin::Graph kizhin::unite(const Graph& lhs, const Graph& rhs)
+{
+  Graph result{};
+  result.edges_.reserve(lhs.edges_.size() + rhs.edges_.size());
+  result.outbound_.reserve(lhs.outbound_.size() + rhs.outbound_.size());
+  result.inbound_.reserve(lhs.inbound_.size() + rhs.inbound_.size());
+  auto lhsPos = lhs.vertices_.begin();
+  auto rhsPos = rhs.vertices_.begin();
+  while (lhsPos != lhs.vertices_.end() || rhsPos != rhs.vertices_.end()) {
+    const bool isLhs = rhsPos == rhs.vertices_.end() ||
+        (lhsPos != lhs.vertices_.end() && lhsPos->first <= rhsPos->first);
+    const bool isRhs = lhsPos == lhs.vertices_.end() ||
+        (rhsPos != rhs.vertices_.end() && rhsPos->first <= lhsPos->first);
+    const Vertex& vertex = isLhs ? lhsPos->first : rhsPos->first;
+    VertexContainer targets = unite(findOrEmpty(lhs.outbound_, vertex), findOrEmpty(rhs.outbound_, vertex));
+    VertexContainer sources = unite(findOrEmpty(lhs.inbound_, vertex), findOrEmpty(rhs.inbound_, vertex));
+    for (const Vertex& to: targets) {
+      const VertexPair edge{ vertex, to };
+      result.edges_.emplace(edge, unite(findOrEmpty(lhs.edges_, edge), findOrEmpty(rhs.edges_, edge)));
+    }
+    result.vertices_.emplace_hint(result.vertices_.end(), vertex, targets.size() + sources.size());
+    if (!targets.empty()) {
+      result.outbound_.emplace(vertex, std::move(targets));
+    }
+    if (!sources.empty()) {
+      result.inbound_.emplace(vertex, std::move(sources));
+    }
+    if (isLhs) {
+      ++lhsPos;
+    }
+    if (isRhs) {
+      ++rhsPos;
+    }
+  }
   return result;
 }
 
+template < typename Map >
+const typename Map::mapped_type& kizhin::findOrEmpty(const Map& map, const typename Map::key_type& key)
+{
+  static const typename Map::mapped_type empty{};
+  const auto pos = map.find(key);
+  return pos == map.end() ? empty : pos->second;
+}
+
+template < typename Set >
+Set kizhin::unite(const Set& lhs, const Set& rhs)
+{
+  Set result{};
+  std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::inserter(result, result.end()));
+  return result;
+}
@@ -30,13 +30,52 @@ namespace kizhin {
   bool operator==(const VertexPair&, const VertexPair&);
   bool operator<(const VertexPair&, const VertexPair&);
 
-  using Graph = UnorderedMap< VertexPair, WeightContiner >;
   using VertexContainer = std::set< Vertex >;
-  using SortedGraph = std::map< Graph::key_type, Graph::mapped_type >;
+  using SortedGraph = std::map< VertexPair, WeightContiner >;
 
-  VertexContainer getVertices(const Graph&);
-  SortedGraph getOutbound(const Graph&, const Vertex&);
-  SortedGraph getInbound(const Graph&, const Vertex&);
+  class Graph
+  {
+  public:
+    using Edges = UnorderedMap< VertexPair, WeightContiner >;
+    using key_type = Edges::key_type;
+    using mapped_type = Edges::mapped_type;
+    using value_type = Edges::value_type;
+    using const_reference = Edges::const_reference;
+    using const_iterator = Edges::const_iterator;
+    using VertexCounter = std::map< Vertex, std::size_t >;
+
+    bool empty() const noexcept;
+    std::size_t size() const noexcept;
+
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator find(const key_type&) const;
+
+    void bind(const key_type&, Weight);
+    void bind(const key_type&, const WeightContiner&);
+    void cut(const key_type&, Weight);
+
+    const VertexCounter& vertices() const noexcept;
+    SortedGraph outbound(const Vertex&) const;
+    SortedGraph inbound(const Vertex&) const;
+
+    friend Graph unite(const Graph&, const Graph&);
+
+  private:
+    using Adjacency = UnorderedMap< Vertex, VertexContainer >;
+
+    Edges edges_{};
+    VertexCounter vertices_{};
+    Adjacency outbound_{};
+    Adjacency inbound_{};
+
+    Edges::iterator emplaceEdge(const key_type&);
+    void linkEdge(const key_type&);
+    void unlinkEdge(const key_type&) noexcept;
+    void pruneEdge(const key_type&) noexcept;
+  };
+
+  Graph unite(const Graph&, const Graph&);
 }
 
 #endif
@@ -38,7 +38,7 @@ std::istream& kizhin::operator>>(std::istream& in, Graph& dest)
     Vertex to{};
     Weight weight{};
     if (in >> from >> to >> weight) {
-      input[{ std::move(from), std::move(to) }].insert(weight);
+      input.bind({ std::move(from), std::move(to) }, weight);
     }
   }
   if (input.size() == count) {
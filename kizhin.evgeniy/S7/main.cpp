@@ -1,23 +1,41 @@
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include "graph-file.hpp"
 #include "io-utils.hpp"
 
 int main(int argc, char** argv)
 {
-  if (argc != 2 || argv[1][0] == 0) {
+  const bool isConvert = argc == 4 && std::strcmp(argv[1], "--convert") == 0;
+  if ((argc != 2 && !isConvert) || argv[1][0] == 0) {
     std::cerr << "Usage: " << argv[0] << " <filename>\n";
+    std::cerr << "       " << argv[0] << " --convert <text-file> <binary-file>\n";
     return 1;
   }
-  const char* filename = argv[1];
+  const char* filename = argv[isConvert ? 2 : 1];
   try {
-    std::ifstream in(filename);
+    std::ifstream in(filename, std::ios::binary);
     if (!in.is_open()) {
       std::cerr << "Failed to open file: " << filename << '\n';
       return 1;
     }
     using namespace kizhin;
     GraphContainer graphs{};
-    in >> graphs;
+    if (isBinaryGraphFile(in)) {
+      in.close();
+      graphs = loadBinaryGraphs(filename);
+    } else {
+      in >> graphs;
+    }
+    if (isConvert) {
+      std::ofstream out(argv[3], std::ios::binary);
+      if (!out.is_open()) {
+        std::cerr << "Failed to open file: " << argv[3] << '\n';
+        return 1;
+      }
+      saveBinaryGraphs(out, graphs);
+      return 0;
+    }
     processCommands(graphs, std::cin, std::cout);
   } catch (const std::exception& e) {
     std::cerr << e.what() << '\n';
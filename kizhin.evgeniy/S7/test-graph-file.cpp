@@ -0,0 +1,82 @@
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include "graph-file.hpp"
+#include "io-utils.hpp"
+
+namespace {
+  using kizhin::GraphContainer;
+  using GraphDump = std::map< std::string, std::pair< kizhin::Graph::VertexCounter, kizhin::SortedGraph > >;
+
+  const std::string graphText = "g1 3 a b 1 b c 2 a c 4\ng2 2 x y 7 y x 7\n";
+
+  GraphContainer readTextGraphs()
+  {
+    std::istringstream in(graphText);
+    GraphContainer graphs{};
+    in >> graphs;
+    return graphs;
+  }
+
+  std::string saveToString(const GraphContainer& graphs)
+  {
+    std::ostringstream out(std::ios::binary);
+    kizhin::saveBinaryGraphs(out, graphs);
+    return out.str();
+  }
+
+  void writeFile(const std::string& filename, const std::string& data)
+  {
+    std::ofstream out(filename, std::ios::binary);
+    out.write(data.data(), data.size());
+  }
+
+  GraphDump dump(const GraphContainer& graphs)
+  {
+    GraphDump result;
+    for (const auto& graph: graphs) {
+      auto& entry = result[graph.first];
+      entry.first = graph.second.vertices();
+      entry.second.insert(graph.second.begin(), graph.second.end());
+    }
+    return result;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(graph_file);
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+  const GraphContainer graphs = readTextGraphs();
+  BOOST_TEST(graphs.size() == 2);
+  const std::string filename = "test-graph-file.bin";
+  writeFile(filename, saveToString(graphs));
+  std::ifstream in(filename, std::ios::binary);
+  BOOST_TEST(kizhin::isBinaryGraphFile(in));
+  in.close();
+  const GraphContainer loaded = kizhin::loadBinaryGraphs(filename);
+  std::remove(filename.c_str());
+  BOOST_TEST(loaded.size() == graphs.size());
+  BOOST_TEST((dump(loaded) == dump(graphs)));
+}
+
+BOOST_AUTO_TEST_CASE(text_is_not_binary)
+{
+  std::istringstream in(graphText);
+  BOOST_TEST(!kizhin::isBinaryGraphFile(in));
+}
+
+BOOST_AUTO_TEST_CASE(truncated_file_throws)
+{
+  const std::string data = saveToString(readTextGraphs());
+  const std::string filename = "test-graph-file-truncated.bin";
+  for (std::size_t size: { std::size_t(4), std::size_t(16), data.size() / 2, data.size() - 1 }) {
+    writeFile(filename, data.substr(0, size));
+    BOOST_CHECK_THROW(kizhin::loadBinaryGraphs(filename), std::runtime_error);
+  }
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END();
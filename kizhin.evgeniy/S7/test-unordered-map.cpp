@@ -185,6 +185,19 @@ BOOST_AUTO_TEST_CASE(erase_existing_key)
   BOOST_TEST((map.find(1) == map.end()));
 }
 
+BOOST_AUTO_TEST_CASE(erase_insert_churn)
+{
+  UnorderedMapT map = { { 0, 0 } };
+  for (int i = 1; i != 1000; ++i) {
+    map.insert({ i, i });
+    map.erase(i - 1);
+  }
+  testUnorderedMapInvariants(map);
+  BOOST_TEST(map.size() == 1);
+  BOOST_TEST(map.at(999) == 999);
+  BOOST_TEST(map.bucketCount() < 16);
+}
+
 BOOST_AUTO_TEST_CASE(clear)
 {
   UnorderedMapT map = { { 1, 1 } };
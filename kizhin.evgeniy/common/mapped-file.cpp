@@ -0,0 +1,67 @@
+#include "mapped-file.hpp"
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+kizhin::MappedFile::MappedFile(const std::string& filename):
+  data_(MAP_FAILED)
+{
+  switch (map(filename)) {
+  case Status::openFailed:
+    throw std::runtime_error("Failed to open file: " + filename);
+  case Status::statFailed:
+    throw std::runtime_error("Failed to stat file: " + filename);
+  case Status::mapFailed:
+    throw std::runtime_error("Failed to map file: " + filename);
+  case Status::ok:
+    break;
+  }
+}
+
+kizhin::MappedFile::MappedFile(const std::string& filename, const std::nothrow_t&) noexcept:
+  data_(MAP_FAILED)
+{
+  map(filename);
+}
+
+kizhin::MappedFile::~MappedFile()
+{
+  if (data_ != MAP_FAILED) {
+    ::munmap(data_, size_);
+  }
+}
+
+const char* kizhin::MappedFile::data() const noexcept
+{
+  return data_ == MAP_FAILED ? nullptr : static_cast< const char* >(data_);
+}
+
+std::size_t kizhin::MappedFile::size() const noexcept
+{
+  return data_ == MAP_FAILED ? 0 : size_;
+}
+
+kizhin::MappedFile::Status kizhin::MappedFile::map(const std::string& filename) noexcept
+{
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd == -1) {
+    return Status::openFailed;
+  }
+  struct stat info{};
+  if (::fstat(fd, &info) == -1) {
+    ::close(fd);
+    return Status::statFailed;
+  }
+  const std::size_t size = static_cast< std::size_t >(info.st_size);
+  if (size != 0) {
+    data_ = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  ::close(fd);
+  if (size != 0 && data_ == MAP_FAILED) {
+    return Status::mapFailed;
+  }
+  size_ = size;
+  return Status::ok;
+}
@@ -0,0 +1,36 @@
+#ifndef SPBSPU_LABS_2025_AADS_A_KIZHIN_EVGENIY_COMMON_MAPPED_FILE_HPP
+#define SPBSPU_LABS_2025_AADS_A_KIZHIN_EVGENIY_COMMON_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <new>
+#include <string>
+
+namespace kizhin {
+  class MappedFile final
+  {
+  public:
+    explicit MappedFile(const std::string&);
+    MappedFile(const std::string&, const std::nothrow_t&) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    const char* data() const noexcept;
+    std::size_t size() const noexcept;
+
+  private:
+    void* data_;
+    std::size_t size_ = 0;
+
+    enum class Status
+    {
+      ok,
+      openFailed,
+      statFailed,
+      mapFailed,
+    };
+    Status map(const std::string&) noexcept;
+  };
+}
+
+#endif
@@ -96,6 +96,7 @@ namespace kizhin {
     Node* begin_ = nullptr;
     Node* end_ = nullptr;
     size_type size_ = 0;
+    size_type deleted_ = 0;
     float maxLoadFact_ = 0.75;
   };
 
@@ -226,6 +227,7 @@ namespace kizhin {
     begin_(std::exchange(rhs.begin_, nullptr)),
     end_(std::exchange(rhs.end_, nullptr)),
     size_(std::exchange(rhs.size_, 0)),
+    deleted_(std::exchange(rhs.deleted_, 0)),
     maxLoadFact_(rhs.maxLoadFact_)
   {}
 
@@ -349,8 +351,7 @@ namespace kizhin {
     }
     const size_type capacity = bucketCount();
     Node* curr = begin_ + hashFunc()(key) % capacity;
-    const Node* const stop = curr == begin_ ? end_ : curr - 1;
-    while (curr != stop) {
+    for (size_type probes = 0; probes != capacity && curr->state != Node::empty; ++probes) {
       pointer currVal = reinterpret_cast< pointer >(curr->value);
       if (curr->state == Node::occupied && keyEq()(currVal->first, key)) {
         return const_iterator{ curr, end_ };
@@ -373,14 +374,15 @@ namespace kizhin {
   std::pair< typename UnorderedMap< K, T, H, E >::iterator, bool > UnorderedMap< K, T, H,
       E >::emplace(Args&&... args)
   {
-    if (loadFactor() >= maxLoadFactor()) {
-      rehash(std::max< size_type >(bucketCount() * 2, 4));
+    if (size_ + deleted_ + 1 > maxLoadFactor() * bucketCount()) {
+      const bool grow = size_ + 1 > maxLoadFactor() * bucketCount() / 2;
+      rehash(grow ? std::max< size_type >(bucketCount() * 2, 4) : bucketCount());
     }
     const size_type capacity = bucketCount();
     value_type value(std::forward< Args >(args)...);
     Node* curr = begin_ + hashFunc()(value.first) % capacity;
     Node* firstDeleted = nullptr;
-    while (curr->state != Node::empty) {
+    for (size_type probes = 0; probes != capacity && curr->state != Node::empty; ++probes) {
       pointer currVal = reinterpret_cast< pointer >(curr->value);
       if (curr->state == Node::occupied && keyEq()(currVal->first, value.first)) {
         return std::make_pair(iterator{ curr, end_ }, false);
@@ -391,7 +393,11 @@ namespace kizhin {
       ++curr;
       curr = curr == end_ ? begin_ : curr;
     }
-    curr = firstDeleted ? firstDeleted : curr;
+    if (firstDeleted) {
+      curr = firstDeleted;
+      --deleted_;
+    }
+    assert(curr->state != Node::occupied && "UnorderedMap: no free bucket");
     new (reinterpret_cast< pointer >(curr->value)) value_type(std::move(value));
     curr->state = Node::occupied;
     ++size_;
@@ -459,6 +465,7 @@ namespace kizhin {
     (reinterpret_cast< pointer >(position.node_->value))->~value_type();
     ++position;
     --size_;
+    ++deleted_;
     return iterator{ position.node_, position.end_ };
   }
 
@@ -491,6 +498,7 @@ namespace kizhin {
     delete[] std::exchange(begin_, nullptr);
     end_ = nullptr;
     size_ = 0;
+    deleted_ = 0;
   }
 
   template < typename K, typename T, typename H, typename E >
@@ -500,6 +508,7 @@ namespace kizhin {
     swap(begin_, rhs.begin_);
     swap(end_, rhs.end_);
     swap(size_, rhs.size_);
+    swap(deleted_, rhs.deleted_);
     swap(maxLoadFact_, rhs.maxLoadFact_);
   }
 
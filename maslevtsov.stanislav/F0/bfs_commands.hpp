@@ -3,12 +3,13 @@
 
 #include <iostream>
 #include "graph.hpp"
+#include "path_search.hpp"
 
 namespace maslevtsov {
   using graphs_t = maslevtsov::HashTable< std::string, Graph >;
 
   void traverse_breadth_first(const graphs_t& graphs, std::istream& in, std::ostream& out);
-  void get_min_path(const graphs_t& graphs, std::istream& in, std::ostream& out);
+  void get_min_path(const graphs_t& graphs, PathSearch& search, std::istream& in, std::ostream& out);
   void get_graph_width(const graphs_t& graphs, std::istream& in, std::ostream& out);
   void get_graph_components(const graphs_t& graphs, std::istream& in, std::ostream& out);
 }
@@ -0,0 +1,69 @@
+#include "dense_graph.hpp"
+#include <algorithm>
+#include <hash_table/definition.hpp>
+#include <vector/definition.hpp>
+
+constexpr unsigned maslevtsov::DenseGraph::npos;
+
+maslevtsov::DenseGraph::DenseGraph(const HashTable< unsigned, Vector< unsigned > >& adj_list):
+  vertices_(adj_list.size()),
+  offsets_(adj_list.size() + 1),
+  neighbours_()
+{
+  size_t index = 0;
+  size_t edges_count = 0;
+  for (auto i = adj_list.cbegin(); i != adj_list.cend(); ++i) {
+    vertices_[index++] = i->first;
+    edges_count += i->second.size();
+  }
+  if (!vertices_.empty()) {
+    std::sort(&vertices_[0], &vertices_[0] + vertices_.size());
+  }
+  Vector< unsigned > neighbours(edges_count);
+  size_t pos = 0;
+  for (unsigned i = 0; i != size(); ++i) {
+    offsets_[i] = pos;
+    const Vector< unsigned >& src = adj_list.at(vertices_[i]);
+    for (auto j = src.cbegin(); j != src.cend(); ++j) {
+      neighbours[pos++] = index_of(*j);
+    }
+  }
+  offsets_[size()] = pos;
+  neighbours_.swap(neighbours);
+}
+
+unsigned maslevtsov::DenseGraph::size() const noexcept
+{
+  return vertices_.size();
+}
+
+unsigned maslevtsov::DenseGraph::index_of(unsigned vertice) const noexcept
+{
+  if (vertices_.empty()) {
+    return npos;
+  }
+  const unsigned* first = &vertices_[0];
+  const unsigned* last = first + vertices_.size();
+  const unsigned* pos = std::lower_bound(first, last, vertice);
+  return (pos != last && *pos == vertice) ? pos - first : npos;
+}
+
+unsigned maslevtsov::DenseGraph::vertice(unsigned index) const noexcept
+{
+  return vertices_[index];
+}
+
+unsigned maslevtsov::DenseGraph::degree(unsigned index) const noexcept
+{
+  return offsets_[index + 1] - offsets_[index];
+}
+
+const unsigned* maslevtsov::DenseGraph::neighbours_begin(unsigned index) const noexcept
+{
+  return neighbours_.empty() ? nullptr : &neighbours_[0] + offsets_[index];
+}
+
+const unsigned* maslevtsov::DenseGraph::neighbours_end(unsigned index) const noexcept
+{
+  return neighbours_.empty() ? nullptr : &neighbours_[0] + offsets_[index + 1];
+}
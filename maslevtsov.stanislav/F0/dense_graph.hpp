@@ -0,0 +1,30 @@
+#ifndef DENSE_GRAPH_HPP
+#define DENSE_GRAPH_HPP
+
+#include <hash_table/declaration.hpp>
+#include <vector/declaration.hpp>
+
+namespace maslevtsov {
+  class DenseGraph
+  {
+  public:
+    static constexpr unsigned npos = static_cast< unsigned >(-1);
+
+    explicit DenseGraph(const HashTable< unsigned, Vector< unsigned > >& adj_list);
+
+    unsigned size() const noexcept;
+    unsigned index_of(unsigned vertice) const noexcept;
+    unsigned vertice(unsigned index) const noexcept;
+
+    unsigned degree(unsigned index) const noexcept;
+    const unsigned* neighbours_begin(unsigned index) const noexcept;
+    const unsigned* neighbours_end(unsigned index) const noexcept;
+
+  private:
+    Vector< unsigned > vertices_;
+    Vector< size_t > offsets_;
+    Vector< unsigned > neighbours_;
+  };
+}
+
+#endif
@@ -0,0 +1,47 @@
+#include "disjoint_sets.hpp"
+#include <hash_table/definition.hpp>
+
+void maslevtsov::DisjointSets::clear() noexcept
+{
+  nodes_.clear();
+}
+
+void maslevtsov::DisjointSets::add(unsigned element)
+{
+  nodes_.insert({element, Node{element, 0}});
+}
+
+unsigned maslevtsov::DisjointSets::find(unsigned element)
+{
+  unsigned root = element;
+  for (unsigned parent = nodes_.at(root).parent; parent != root; parent = nodes_.at(root).parent) {
+    root = parent;
+  }
+  while (element != root) {
+    Node& node = nodes_.at(element);
+    element = node.parent;
+    node.parent = root;
+  }
+  return root;
+}
+
+void maslevtsov::DisjointSets::unite(unsigned element1, unsigned element2)
+{
+  add(element1);
+  add(element2);
+  unsigned root1 = find(element1);
+  unsigned root2 = find(element2);
+  if (root1 == root2) {
+    return;
+  }
+  Node& node1 = nodes_.at(root1);
+  Node& node2 = nodes_.at(root2);
+  if (node1.rank < node2.rank) {
+    node1.parent = root2;
+  } else {
+    node2.parent = root1;
+    if (node1.rank == node2.rank) {
+      ++node1.rank;
+    }
+  }
+}
@@ -0,0 +1,26 @@
+#ifndef DISJOINT_SETS_HPP
+#define DISJOINT_SETS_HPP
+
+#include <hash_table/declaration.hpp>
+
+namespace maslevtsov {
+  class DisjointSets
+  {
+  public:
+    void clear() noexcept;
+    void add(unsigned element);
+    unsigned find(unsigned element);
+    void unite(unsigned element1, unsigned element2);
+
+  private:
+    struct Node
+    {
+      unsigned parent;
+      unsigned rank;
+    };
+
+    HashTable< unsigned, Node > nodes_;
+  };
+}
+
+#endif
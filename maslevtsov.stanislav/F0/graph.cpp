@@ -1,4 +1,5 @@
 #include "graph.hpp"
+#include <algorithm>
 #include <iostream>
 #include <hash_table/definition.hpp>
 #include <vector/definition.hpp>
@@ -23,47 +24,72 @@ namespace {
     return in;
   }
 
-  maslevtsov::Vector< unsigned >::const_iterator find_neighbour(const maslevtsov::Vector< unsigned >& vertices,
-    unsigned vertice)
+  size_t find_neighbour(const maslevtsov::Vector< unsigned >& neighbours, unsigned vertice)
   {
-    for (auto i = vertices.cbegin(); i != vertices.cend(); ++i) {
-      if (vertice == *i) {
-        return i;
-      }
+    if (neighbours.empty()) {
+      return 0;
+    }
+    const unsigned* first = &neighbours[0];
+    const unsigned* last = first + neighbours.size();
+    return std::lower_bound(first, last, vertice) - first;
+  }
+
+  bool has_neighbour(const maslevtsov::Vector< unsigned >& neighbours, unsigned vertice)
+  {
+    size_t pos = find_neighbour(neighbours, vertice);
+    return (pos != neighbours.size()) && (neighbours[pos] == vertice);
+  }
+
+  void insert_neighbour(maslevtsov::Vector< unsigned >& neighbours, unsigned vertice)
+  {
+    neighbours.push_back(vertice);
+    size_t pos = neighbours.size() - 1;
+    for (; (pos != 0) && (neighbours[pos - 1] > vertice); --pos) {
+      neighbours[pos] = neighbours[pos - 1];
     }
-    return vertices.cend();
+    neighbours[pos] = vertice;
+  }
+
+  void erase_neighbour(maslevtsov::Vector< unsigned >& neighbours, unsigned vertice)
+  {
+    for (size_t i = find_neighbour(neighbours, vertice) + 1; i < neighbours.size(); ++i) {
+      neighbours[i - 1] = neighbours[i];
+    }
+    neighbours.pop_back();
   }
 }
 
 maslevtsov::Graph::Graph(const Graph& gr1, const Graph& gr2):
   Graph(gr1)
 {
-  for (auto i = gr2.adjacency_list_.begin(); i != gr2.adjacency_list_.end(); ++i) {
-    try {
-      if (i->second.empty()) {
-        add_vertice(i->first);
-      }
-      for (auto j = i->second.begin(); j != i->second.end(); ++j) {
-        add_edge(i->first, *j);
+  try {
+    for (auto i = gr2.adjacency_list_.cbegin(); i != gr2.adjacency_list_.cend(); ++i) {
+      maslevtsov::Vector< unsigned >& neighbours = adjacency_list_[i->first];
+      for (auto j = i->second.cbegin(); j != i->second.cend(); ++j) {
+        neighbours.push_back(*j);
       }
-    } catch (const std::invalid_argument&) {
-      continue;
-    } catch (...) {
-      adjacency_list_.clear();
-      throw;
     }
+    sort_adjacency();
+  } catch (...) {
+    adjacency_list_.clear();
+    throw;
   }
 }
 
 maslevtsov::Graph::Graph(const Graph& src, const maslevtsov::Vector< unsigned >& vertices):
   Graph()
 {
+  components_dirty_ = true;
+  maslevtsov::Vector< unsigned > sorted_vertices(vertices);
+  if (!sorted_vertices.empty()) {
+    std::sort(&sorted_vertices[0], &sorted_vertices[0] + sorted_vertices.size());
+  }
   for (unsigned vertice: vertices) {
     auto src_it = src.adjacency_list_.find(vertice);
     if (src_it != src.adjacency_list_.end()) {
       maslevtsov::Vector< unsigned > filtered_edges;
       for (unsigned neighbour: src_it->second) {
-        if (find_neighbour(vertices, neighbour) != vertices.cend()) {
+        if (has_neighbour(sorted_vertices, neighbour)) {
           filtered_edges.push_back(neighbour);
         }
       }
@@ -80,52 +106,119 @@ const maslevtsov::Graph::adjacency_list_t& maslevtsov::Graph::get_adj_list() con
   return adjacency_list_;
 }
 
+const maslevtsov::DenseGraph& maslevtsov::Graph::get_dense_view() const
+{
+  if (!dense_view_) {
+    dense_view_ = std::make_shared< const DenseGraph >(adjacency_list_);
+  }
+  return *dense_view_;
+}
+
+unsigned maslevtsov::Graph::get_component_id(unsigned vertice) const
+{
+  if (components_dirty_) {
+    components_.clear();
+    for (auto i = adjacency_list_.cbegin(); i != adjacency_list_.cend(); ++i) {
+      components_.add(i->first);
+      for (auto j = i->second.cbegin(); j != i->second.cend(); ++j) {
+        components_.unite(i->first, *j);
+      }
+    }
+    components_dirty_ = false;
+  }
+  return components_.find(vertice);
+}
+
 void maslevtsov::Graph::add_vertice(unsigned vertice)
 {
+  dense_view_.reset();
   if (adjacency_list_.find(vertice) != adjacency_list_.end()) {
     throw std::invalid_argument("vertice already exist");
   }
   adjacency_list_[vertice];
+  link_components(vertice, vertice);
 }
 
 void maslevtsov::Graph::add_edge(unsigned vertice1, unsigned vertice2)
 {
+  dense_view_.reset();
   auto vertice1_it = adjacency_list_.find(vertice1);
   if (vertice1_it != adjacency_list_.end()) {
-    if (find_neighbour(vertice1_it->second, vertice2) != vertice1_it->second.cend()) {
+    if (has_neighbour(vertice1_it->second, vertice2)) {
       throw std::invalid_argument("edge already exist");
     }
   }
-  adjacency_list_[vertice1].push_back(vertice2);
-  adjacency_list_[vertice2].push_back(vertice1);
+  insert_neighbour(adjacency_list_[vertice1], vertice2);
+  insert_neighbour(adjacency_list_[vertice2], vertice1);
+  link_components(vertice1, vertice2);
 }
 
 void maslevtsov::Graph::delete_vertice(unsigned vertice)
 {
+  dense_view_.reset();
+  components_dirty_ = true;
   if (adjacency_list_.find(vertice) == adjacency_list_.end()) {
     throw std::invalid_argument("non-existing vertice");
   }
   auto neighbours_it = adjacency_list_.find(vertice)->second;
   for (auto i = neighbours_it.begin(); i != neighbours_it.end(); ++i) {
     auto neighbour_it = adjacency_list_.find(*i);
-    neighbour_it->second.erase(find_neighbour(neighbour_it->second, vertice));
+    erase_neighbour(neighbour_it->second, vertice);
   }
   adjacency_list_.erase(adjacency_list_.find(vertice));
 }
 
 void maslevtsov::Graph::delete_edge(unsigned vertice1, unsigned vertice2)
 {
+  dense_view_.reset();
+  components_dirty_ = true;
   auto vertice1_it = adjacency_list_.find(vertice1);
   if (vertice1_it == adjacency_list_.end()) {
     throw std::invalid_argument("non-existing edge");
   }
 
-  if (find_neighbour(vertice1_it->second, vertice2) == vertice1_it->second.cend()) {
+  if (!has_neighbour(vertice1_it->second, vertice2)) {
     throw std::invalid_argument("non-existing edge");
   }
-  vertice1_it->second.erase(find_neighbour(vertice1_it->second, vertice2));
-  auto vertice2_it = adjacency_list_.find(vertice2);
-  vertice2_it->second.erase(find_neighbour(vertice2_it->second, vertice1));
+  erase_neighbour(vertice1_it->second, vertice2);
+  erase_neighbour(adjacency_list_.find(vertice2)->second, vertice1);
+}
+
+void maslevtsov::Graph::append_edge(unsigned vertice1, unsigned vertice2)
+{
+  adjacency_list_[vertice1].push_back(vertice2);
+  adjacency_list_[vertice2].push_back(vertice1);
+}
+
+void maslevtsov::Graph::sort_adjacency()
+{
+  dense_view_.reset();
+  components_dirty_ = true;
+  for (auto i = adjacency_list_.begin(); i != adjacency_list_.end(); ++i) {
+    maslevtsov::Vector< unsigned >& neighbours = i->second;
+    if (neighbours.empty()) {
+      continue;
+    }
+    unsigned* first = &neighbours[0];
+    std::sort(first, first + neighbours.size());
+    size_t unique_count = std::unique(first, first + neighbours.size()) - first;
+    while (neighbours.size() != unique_count) {
+      neighbours.pop_back();
+    }
+    if (has_neighbour(neighbours, i->first)) {
+      insert_neighbour(neighbours, i->first);
+    }
+  }
+}
+
+void maslevtsov::Graph::link_components(unsigned vertice1, unsigned vertice2)
+{
+  if (components_dirty_) {
+    return;
+  }
+  components_dirty_ = true;
+  components_.unite(vertice1, vertice2);
+  components_dirty_ = false;
 }
 
 std::istream& maslevtsov::operator>>(std::istream& in, Graph& gr)
@@ -144,31 +237,23 @@ std::istream& maslevtsov::operator>>(std::istream& in, Graph& gr)
       return in;
     }
     bool is_neighbour = false;
-    while (in.peek() != '\n') {
-      in >> neighbour;
-      is_neighbour = true;
-      try {
-        result.add_edge(vertice, neighbour);
-      } catch (const std::invalid_argument&) {
-        continue;
-      } catch (...) {
-        in.setstate(std::ios::failbit);
-        return in;
+    try {
+      while (in && (in.peek() != '\n')) {
+        in >> neighbour;
+        is_neighbour = true;
+        result.append_edge(vertice, neighbour);
       }
-    }
-    if (!is_neighbour) {
-      try {
-        result.add_vertice(vertice);
-      } catch (const std::invalid_argument&) {
-        continue;
-      } catch (...) {
-        in.setstate(std::ios::failbit);
-        return in;
+      if (!is_neighbour) {
+        result.adjacency_list_[vertice];
       }
+    } catch (...) {
+      in.setstate(std::ios::failbit);
+      return in;
     }
   }
   if (in) {
     try {
+      result.sort_adjacency();
       gr = result;
     } catch (...) {
       in.setstate(std::ios::failbit);
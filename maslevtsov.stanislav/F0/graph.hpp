@@ -2,8 +2,11 @@
 #define GRAPH_HPP
 
 #include <hash_table/declaration.hpp>
+#include <memory>
 #include <string>
 #include <vector/declaration.hpp>
+#include "dense_graph.hpp"
+#include "disjoint_sets.hpp"
 
 namespace maslevtsov {
   class Graph
@@ -16,6 +19,8 @@ namespace maslevtsov {
     Graph(const Graph& src, const maslevtsov::Vector< unsigned >& vertices);
 
     const adjacency_list_t& get_adj_list() const;
+    const DenseGraph& get_dense_view() const;
+    unsigned get_component_id(unsigned vertice) const;
 
     void add_vertice(unsigned vertice);
     void add_edge(unsigned vertice1, unsigned vertice2);
@@ -24,6 +29,13 @@ namespace maslevtsov {
 
   private:
     adjacency_list_t adjacency_list_;
+    mutable std::shared_ptr< const DenseGraph > dense_view_;
+    mutable DisjointSets components_;
+    mutable bool components_dirty_ = false;
+
+    void append_edge(unsigned vertice1, unsigned vertice2);
+    void sort_adjacency();
+    void link_components(unsigned vertice1, unsigned vertice2);
 
     friend std::istream& operator>>(std::istream& in, Graph& gr);
     friend std::ostream& operator<<(std::ostream& out, const Graph& gr);
@@ -44,6 +44,7 @@ int main(int argc, char** argv)
     return 1;
   }
 
+  PathSearch path_search;
   maslevtsov::HashTable< std::string, std::function< void() > > commands;
   commands["save-graphs"] = std::bind(save_graphs, std::cref(graphs), std::ref(std::cin));
   commands["open-graphs"] = std::bind(open_graphs, std::ref(graphs), std::ref(std::cin), std::ref(std::cout));
@@ -60,7 +61,8 @@ int main(int argc, char** argv)
   commands["create-subgraph"] = std::bind(create_subgraph, std::ref(graphs), std::ref(std::cin));
 
   commands["bfs"] = std::bind(traverse_breadth_first, std::cref(graphs), std::ref(std::cin), std::ref(std::cout));
-  commands["path"] = std::bind(get_min_path, std::cref(graphs), std::ref(std::cin), std::ref(std::cout));
+  commands["path"] = std::bind(get_min_path, std::cref(graphs), std::ref(path_search), std::ref(std::cin),
+    std::ref(std::cout));
   commands["width"] = std::bind(get_graph_width, std::cref(graphs), std::ref(std::cin), std::ref(std::cout));
   commands["components"] = std::bind(get_graph_components, std::cref(graphs), std::ref(std::cin), std::ref(std::cout));
 
@@ -0,0 +1,232 @@
+#include "ms_bfs.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector/definition.hpp>
+
+namespace {
+  using word_t = std::uint64_t;
+  constexpr unsigned batch_size = 64;
+
+  struct BfsWorkspace
+  {
+    explicit BfsWorkspace(unsigned size);
+
+    maslevtsov::Vector< word_t > seen;
+    maslevtsov::Vector< word_t > visit;
+    maslevtsov::Vector< word_t > next;
+  };
+
+  BfsWorkspace::BfsWorkspace(unsigned size):
+    seen(size),
+    visit(size),
+    next(size)
+  {}
+
+  struct Scope
+  {
+    const unsigned* first;
+    const unsigned* last;
+  };
+
+  void run_batch(const maslevtsov::DenseGraph& graph, Scope scope, const unsigned* sources, unsigned count,
+    BfsWorkspace& ws, size_t* result)
+  {
+    for (const unsigned* i = scope.first; i != scope.last; ++i) {
+      ws.seen[*i] = 0;
+    }
+    for (unsigned i = 0; i != count; ++i) {
+      word_t bit = word_t(1) << i;
+      ws.seen[sources[i]] |= bit;
+      ws.visit[sources[i]] |= bit;
+      result[i] = 0;
+    }
+    for (size_t level = 1;; ++level) {
+      for (const unsigned* i = scope.first; i != scope.last; ++i) {
+        word_t frontier = ws.visit[*i];
+        if (frontier) {
+          for (const unsigned* j = graph.neighbours_begin(*i); j != graph.neighbours_end(*i); ++j) {
+            ws.next[*j] |= frontier;
+          }
+        }
+      }
+      word_t reached = 0;
+      for (const unsigned* i = scope.first; i != scope.last; ++i) {
+        word_t fresh = ws.next[*i] & ~ws.seen[*i];
+        ws.next[*i] = 0;
+        ws.visit[*i] = fresh;
+        ws.seen[*i] |= fresh;
+        reached |= fresh;
+      }
+      if (!reached) {
+        return;
+      }
+      for (; reached; reached &= reached - 1) {
+        result[__builtin_ctzll(reached)] = level;
+      }
+    }
+  }
+
+  class BatchRunner
+  {
+  public:
+    BatchRunner(const maslevtsov::DenseGraph& graph, unsigned threads);
+
+    void run(Scope scope, const unsigned* sources, size_t count, size_t* result);
+
+  private:
+    const maslevtsov::DenseGraph& graph_;
+    unsigned threads_;
+    std::unique_ptr< std::unique_ptr< BfsWorkspace >[] > workspaces_;
+
+    BfsWorkspace& workspace(unsigned thread);
+  };
+
+  BatchRunner::BatchRunner(const maslevtsov::DenseGraph& graph, unsigned threads):
+    graph_(graph),
+    threads_(threads ? threads : std::max(std::thread::hardware_concurrency(), 1u)),
+    workspaces_(new std::unique_ptr< BfsWorkspace >[threads_])
+  {}
+
+  BfsWorkspace& BatchRunner::workspace(unsigned thread)
+  {
+    if (!workspaces_[thread]) {
+      workspaces_[thread].reset(new BfsWorkspace(graph_.size()));
+    }
+    return *workspaces_[thread];
+  }
+
+  void BatchRunner::run(Scope scope, const unsigned* sources, size_t count, size_t* result)
+  {
+    size_t batches = (count + batch_size - 1) / batch_size;
+    unsigned threads = std::min< size_t >(threads_, batches);
+    if (threads <= 1) {
+      BfsWorkspace& ws = workspace(0);
+      for (size_t i = 0; i < count; i += batch_size) {
+        run_batch(graph_, scope, sources + i, std::min< size_t >(batch_size, count - i), ws, result + i);
+      }
+      return;
+    }
+    for (unsigned i = 0; i != threads; ++i) {
+      workspace(i);
+    }
+    std::atomic< size_t > next_batch(0);
+    std::unique_ptr< std::exception_ptr[] > errors(new std::exception_ptr[threads]);
+    auto worker = [&](unsigned thread)
+    {
+      try {
+        for (size_t batch = next_batch++; batch < batches; batch = next_batch++) {
+          size_t first = batch * batch_size;
+          unsigned size = std::min< size_t >(batch_size, count - first);
+          run_batch(graph_, scope, sources + first, size, *workspaces_[thread], result + first);
+        }
+      } catch (...) {
+        errors[thread] = std::current_exception();
+        next_batch = batches;
+      }
+    };
+    std::unique_ptr< std::thread[] > pool(new std::thread[threads - 1]);
+    unsigned started = 0;
+    try {
+      for (; started != threads - 1; ++started) {
+        pool[started] = std::thread(worker, started + 1);
+      }
+    } catch (...) {
+      next_batch = batches;
+      for (unsigned i = 0; i != started; ++i) {
+        pool[i].join();
+      }
+      throw;
+    }
+    worker(0);
+    for (unsigned i = 0; i != started; ++i) {
+      pool[i].join();
+    }
+    for (unsigned i = 0; i != threads; ++i) {
+      if (errors[i]) {
+        std::rethrow_exception(errors[i]);
+      }
+    }
+  }
+
+  void collect_component(const maslevtsov::DenseGraph& graph, unsigned root, maslevtsov::Vector< unsigned >& dist,
+    maslevtsov::Vector< unsigned >& order, size_t& order_size)
+  {
+    size_t first = order_size;
+    dist[root] = 0;
+    order[order_size++] = root;
+    for (size_t i = first; i != order_size; ++i) {
+      unsigned current = order[i];
+      for (const unsigned* j = graph.neighbours_begin(current); j != graph.neighbours_end(current); ++j) {
+        if (dist[*j] == maslevtsov::DenseGraph::npos) {
+          dist[*j] = dist[current] + 1;
+          order[order_size++] = *j;
+        }
+      }
+    }
+  }
+
+  size_t get_component_diameter(const maslevtsov::DenseGraph& graph, BatchRunner& runner, unsigned* component,
+    size_t size, maslevtsov::Vector< unsigned >& dist)
+  {
+    if (size < 2) {
+      return 0;
+    }
+    unsigned center = component[0];
+    for (size_t i = 1; i != size; ++i) {
+      if (graph.degree(component[i]) > graph.degree(center)) {
+        center = component[i];
+      }
+    }
+    for (size_t i = 0; i != size; ++i) {
+      dist[component[i]] = maslevtsov::DenseGraph::npos;
+    }
+    size_t order_size = 0;
+    maslevtsov::Vector< unsigned > order(size);
+    collect_component(graph, center, dist, order, order_size);
+    Scope scope{&order[0], &order[0] + size};
+    maslevtsov::Vector< size_t > eccentricities(size);
+    size_t lower = dist[order[size - 1]];
+    size_t level_end = size;
+    for (size_t level = lower; level > 0 && lower < 2 * level; --level) {
+      size_t level_begin = level_end;
+      while (dist[order[level_begin - 1]] == level) {
+        --level_begin;
+      }
+      runner.run(scope, &order[level_begin], level_end - level_begin, &eccentricities[level_begin]);
+      for (size_t i = level_begin; i != level_end; ++i) {
+        lower = std::max(lower, eccentricities[i]);
+      }
+      level_end = level_begin;
+    }
+    return lower;
+  }
+}
+
+size_t maslevtsov::get_diameter(const DenseGraph& graph, unsigned threads)
+{
+  if (graph.size() == 0) {
+    return 0;
+  }
+  BatchRunner runner(graph, threads);
+  Vector< unsigned > dist(graph.size());
+  Vector< unsigned > order(graph.size());
+  for (unsigned i = 0; i != graph.size(); ++i) {
+    dist[i] = DenseGraph::npos;
+  }
+  size_t order_size = 0;
+  size_t diameter = 0;
+  for (unsigned i = 0; i != graph.size(); ++i) {
+    if (dist[i] != DenseGraph::npos) {
+      continue;
+    }
+    size_t first = order_size;
+    collect_component(graph, i, dist, order, order_size);
+    unsigned* component = &order[first];
+    diameter = std::max(diameter, get_component_diameter(graph, runner, component, order_size - first, dist));
+  }
+  return diameter;
+}
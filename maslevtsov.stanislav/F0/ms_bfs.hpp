@@ -0,0 +1,10 @@
+#ifndef MS_BFS_HPP
+#define MS_BFS_HPP
+
+#include "dense_graph.hpp"
+
+namespace maslevtsov {
+  size_t get_diameter(const DenseGraph& graph, unsigned threads = 0);
+}
+
+#endif
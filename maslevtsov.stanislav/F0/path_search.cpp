@@ -0,0 +1,97 @@
+#include "path_search.hpp"
+#include <limits>
+#include <vector/definition.hpp>
+
+maslevtsov::PathSearch::PathSearch() noexcept:
+  epoch_(0),
+  stamps_(),
+  parents_(),
+  distances_(),
+  is_backward_(),
+  queues_()
+{}
+
+bool maslevtsov::PathSearch::find_shortest_path(const DenseGraph& graph, unsigned start, unsigned goal,
+  Vector< unsigned >& path)
+{
+  prepare(graph.size());
+  if (start == goal) {
+    Vector< unsigned > result(1);
+    result[0] = graph.vertice(start);
+    path.swap(result);
+    return true;
+  }
+  visit(start, false, DenseGraph::npos, 0);
+  visit(goal, true, DenseGraph::npos, 0);
+  queues_[0][0] = start;
+  queues_[1][0] = goal;
+  size_t heads[2] = {0, 0};
+  size_t tails[2] = {1, 1};
+  const size_t not_found = std::numeric_limits< size_t >::max();
+  size_t length = not_found;
+  unsigned meet_forward = DenseGraph::npos, meet_backward = DenseGraph::npos;
+  while (length == not_found && heads[0] != tails[0] && heads[1] != tails[1]) {
+    bool side = tails[1] - heads[1] < tails[0] - heads[0];
+    size_t level_end = tails[side];
+    for (size_t i = heads[side]; i != level_end; ++i) {
+      unsigned current = queues_[side][i];
+      for (const unsigned* j = graph.neighbours_begin(current); j != graph.neighbours_end(current); ++j) {
+        if (!is_visited(*j)) {
+          visit(*j, side, current, distances_[current] + 1);
+          queues_[side][tails[side]++] = *j;
+        } else if (is_backward_[*j] != side && distances_[current] + 1 + distances_[*j] < length) {
+          length = distances_[current] + 1 + distances_[*j];
+          meet_forward = side ? *j : current;
+          meet_backward = side ? current : *j;
+        }
+      }
+    }
+    heads[side] = level_end;
+  }
+  if (length == not_found) {
+    return false;
+  }
+  Vector< unsigned > result(length + 1);
+  for (unsigned i = meet_forward; i != DenseGraph::npos; i = parents_[i]) {
+    result[distances_[i]] = graph.vertice(i);
+  }
+  for (unsigned i = meet_backward; i != DenseGraph::npos; i = parents_[i]) {
+    result[length - distances_[i]] = graph.vertice(i);
+  }
+  path.swap(result);
+  return true;
+}
+
+void maslevtsov::PathSearch::prepare(unsigned size)
+{
+  if (stamps_.size() < size) {
+    Vector< unsigned > stamps(size), parents(size), distances(size);
+    Vector< bool > is_backward(size);
+    Vector< unsigned > forward_queue(size), backward_queue(size);
+    stamps_.swap(stamps);
+    parents_.swap(parents);
+    distances_.swap(distances);
+    is_backward_.swap(is_backward);
+    queues_[0].swap(forward_queue);
+    queues_[1].swap(backward_queue);
+  }
+  if (++epoch_ == 0) {
+    for (size_t i = 0; i != stamps_.size(); ++i) {
+      stamps_[i] = 0;
+    }
+    epoch_ = 1;
+  }
+}
+
+bool maslevtsov::PathSearch::is_visited(unsigned index) const noexcept
+{
+  return stamps_[index] == epoch_;
+}
+
+void maslevtsov::PathSearch::visit(unsigned index, bool is_backward, unsigned parent, unsigned distance) noexcept
+{
+  stamps_[index] = epoch_;
+  is_backward_[index] = is_backward;
+  parents_[index] = parent;
+  distances_[index] = distance;
+}
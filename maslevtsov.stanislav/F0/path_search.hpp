@@ -0,0 +1,28 @@
+#ifndef PATH_SEARCH_HPP
+#define PATH_SEARCH_HPP
+
+#include "dense_graph.hpp"
+
+namespace maslevtsov {
+  class PathSearch
+  {
+  public:
+    PathSearch() noexcept;
+
+    bool find_shortest_path(const DenseGraph& graph, unsigned start, unsigned goal, Vector< unsigned >& path);
+
+  private:
+    unsigned epoch_;
+    Vector< unsigned > stamps_;
+    Vector< unsigned > parents_;
+    Vector< unsigned > distances_;
+    Vector< bool > is_backward_;
+    Vector< unsigned > queues_[2];
+
+    void prepare(unsigned size);
+    bool is_visited(unsigned index) const noexcept;
+    void visit(unsigned index, bool is_backward, unsigned parent, unsigned distance) noexcept;
+  };
+}
+
+#endif
@@ -0,0 +1,158 @@
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <hash_table/definition.hpp>
+#include <vector/definition.hpp>
+#include "bfs_commands.hpp"
+#include "ms_bfs.hpp"
+
+namespace {
+  constexpr size_t unreachable = static_cast< size_t >(-1);
+
+  std::vector< size_t > get_plain_distances(const maslevtsov::Graph& graph, unsigned start)
+  {
+    const maslevtsov::DenseGraph& dense = graph.get_dense_view();
+    std::vector< size_t > distances(dense.size(), unreachable);
+    std::vector< unsigned > order{dense.index_of(start)};
+    distances[order[0]] = 0;
+    for (size_t i = 0; i != order.size(); ++i) {
+      const maslevtsov::Vector< unsigned >& neighbours = graph.get_adj_list().find(dense.vertice(order[i]))->second;
+      for (unsigned neighbour: neighbours) {
+        unsigned index = dense.index_of(neighbour);
+        if (distances[index] == unreachable) {
+          distances[index] = distances[order[i]] + 1;
+          order.push_back(index);
+        }
+      }
+    }
+    return distances;
+  }
+
+  size_t get_plain_diameter(const maslevtsov::Graph& graph)
+  {
+    size_t diameter = 0;
+    for (auto i = graph.get_adj_list().cbegin(); i != graph.get_adj_list().cend(); ++i) {
+      for (size_t distance: get_plain_distances(graph, i->first)) {
+        if (distance != unreachable) {
+          diameter = std::max(diameter, distance);
+        }
+      }
+    }
+    return diameter;
+  }
+
+  maslevtsov::Graph make_random_graph(std::mt19937& random, unsigned vertices, unsigned edges)
+  {
+    maslevtsov::Graph graph;
+    for (unsigned i = 0; i != vertices; ++i) {
+      graph.add_vertice(i * 3);
+    }
+    for (unsigned i = 0; i != edges; ++i) {
+      unsigned vertice1 = random() % vertices * 3;
+      unsigned vertice2 = random() % vertices * 3;
+      try {
+        if (vertice1 != vertice2) {
+          graph.add_edge(vertice1, vertice2);
+        }
+      } catch (const std::invalid_argument&) {
+      }
+    }
+    return graph;
+  }
+
+  std::string run_path(const maslevtsov::graphs_t& graphs, maslevtsov::PathSearch& search, const std::string& args)
+  {
+    std::istringstream in(args);
+    std::ostringstream out;
+    maslevtsov::get_min_path(graphs, search, in, out);
+    return out.str();
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(width_tests)
+BOOST_AUTO_TEST_CASE(width_random_graphs_test)
+{
+  std::mt19937 random(11);
+  for (unsigned test = 0; test != 60; ++test) {
+    unsigned vertices = 1 + random() % 150;
+    maslevtsov::Graph graph = make_random_graph(random, vertices, random() % (2 * vertices));
+    size_t expected = get_plain_diameter(graph);
+    BOOST_TEST(maslevtsov::get_diameter(graph.get_dense_view(), 1) == expected);
+    BOOST_TEST(maslevtsov::get_diameter(graph.get_dense_view(), 4) == expected);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(width_wide_levels_test)
+{
+  maslevtsov::Graph graph;
+  for (unsigned i = 1; i != 300; ++i) {
+    graph.add_edge(0, i);
+    if (i > 200) {
+      graph.add_edge(i, 1000 + i);
+    }
+  }
+  graph.add_edge(1299, 2000);
+  BOOST_TEST(maslevtsov::get_diameter(graph.get_dense_view(), 1) == get_plain_diameter(graph));
+  BOOST_TEST(maslevtsov::get_diameter(graph.get_dense_view(), 3) == 5);
+  BOOST_TEST(maslevtsov::get_diameter(maslevtsov::Graph().get_dense_view()) == 0);
+}
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(path_tests)
+BOOST_AUTO_TEST_CASE(path_random_graphs_test)
+{
+  std::mt19937 random(3);
+  maslevtsov::PathSearch search;
+  for (unsigned test = 0; test != 30; ++test) {
+    unsigned vertices = 2 + random() % 60;
+    maslevtsov::graphs_t graphs;
+    graphs["g"] = make_random_graph(random, vertices, random() % (2 * vertices));
+    const maslevtsov::Graph& graph = graphs["g"];
+    const maslevtsov::DenseGraph& dense = graph.get_dense_view();
+    for (unsigned query = 0; query != 20; ++query) {
+      unsigned start = random() % vertices * 3;
+      unsigned goal = random() % vertices * 3;
+      size_t expected = get_plain_distances(graph, start)[dense.index_of(goal)];
+      std::string args = "g " + std::to_string(start) + ' ' + std::to_string(goal);
+      if (expected == unreachable) {
+        BOOST_CHECK_THROW(run_path(graphs, search, args), std::invalid_argument);
+        continue;
+      }
+      std::istringstream path(run_path(graphs, search, args));
+      std::vector< unsigned > vertices_on_path;
+      unsigned vertice = 0;
+      char delimiter = '-';
+      while (delimiter == '-' && path >> vertice) {
+        vertices_on_path.push_back(vertice);
+        delimiter = path.get();
+      }
+      size_t length = 0;
+      path >> length;
+      BOOST_TEST(length == expected);
+      BOOST_REQUIRE(vertices_on_path.size() == expected + 1);
+      BOOST_TEST(vertices_on_path.front() == start);
+      BOOST_TEST(vertices_on_path.back() == goal);
+      for (size_t i = 1; i != vertices_on_path.size(); ++i) {
+        const maslevtsov::Vector< unsigned >& neighbours = graph.get_adj_list().find(vertices_on_path[i - 1])->second;
+        BOOST_TEST((std::find(neighbours.cbegin(), neighbours.cend(), vertices_on_path[i]) != neighbours.cend()));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(path_edge_cases_test)
+{
+  maslevtsov::PathSearch search;
+  maslevtsov::graphs_t graphs;
+  graphs["g"].add_edge(1, 2);
+  graphs["g"].add_vertice(5);
+  BOOST_TEST(run_path(graphs, search, "g 5 5") == "5 0\n");
+  BOOST_TEST(run_path(graphs, search, "g 2 1") == "2-1 1\n");
+  BOOST_CHECK_THROW(run_path(graphs, search, "g 1 5"), std::invalid_argument);
+  BOOST_CHECK_THROW(run_path(graphs, search, "g 1 9"), std::invalid_argument);
+  BOOST_CHECK_THROW(run_path(graphs, search, "h 1 2"), std::invalid_argument);
+}
+BOOST_AUTO_TEST_SUITE_END()
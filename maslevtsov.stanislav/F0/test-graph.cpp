@@ -0,0 +1,123 @@
+#include <boost/test/unit_test.hpp>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <hash_table/definition.hpp>
+#include <vector/definition.hpp>
+#include "graph.hpp"
+
+namespace {
+  using reference_t = std::map< unsigned, std::set< unsigned > >;
+
+  void add_reference_edge(reference_t& reference, unsigned vertice1, unsigned vertice2)
+  {
+    reference[vertice1].insert(vertice2);
+    reference[vertice2].insert(vertice1);
+  }
+
+  std::map< unsigned, unsigned > get_reference_components(const reference_t& reference)
+  {
+    std::map< unsigned, unsigned > components;
+    for (auto i = reference.cbegin(); i != reference.cend(); ++i) {
+      if (components.count(i->first)) {
+        continue;
+      }
+      std::vector< unsigned > to_visit{i->first};
+      components[i->first] = i->first;
+      while (!to_visit.empty()) {
+        unsigned current = to_visit.back();
+        to_visit.pop_back();
+        for (unsigned neighbour: reference.at(current)) {
+          if (components.insert({neighbour, i->first}).second) {
+            to_visit.push_back(neighbour);
+          }
+        }
+      }
+    }
+    return components;
+  }
+
+  void check_graph(const maslevtsov::Graph& graph, const reference_t& reference)
+  {
+    const maslevtsov::Graph::adjacency_list_t& adj_list = graph.get_adj_list();
+    BOOST_TEST(adj_list.size() == reference.size());
+    for (auto i = reference.cbegin(); i != reference.cend(); ++i) {
+      auto adj_it = adj_list.find(i->first);
+      BOOST_REQUIRE(adj_it != adj_list.end());
+      std::vector< unsigned > neighbours(adj_it->second.cbegin(), adj_it->second.cend());
+      BOOST_TEST((neighbours == std::vector< unsigned >(i->second.cbegin(), i->second.cend())));
+    }
+    std::map< unsigned, unsigned > components = get_reference_components(reference);
+    for (auto i = reference.cbegin(); i != reference.cend(); ++i) {
+      for (auto j = reference.cbegin(); j != reference.cend(); ++j) {
+        bool is_same = graph.get_component_id(i->first) == graph.get_component_id(j->first);
+        BOOST_TEST(is_same == (components[i->first] == components[j->first]));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(graph_tests)
+BOOST_AUTO_TEST_CASE(graph_random_edits_test)
+{
+  std::mt19937 random(5);
+  maslevtsov::Graph graph;
+  reference_t reference;
+  for (unsigned step = 0; step != 400; ++step) {
+    unsigned vertice1 = random() % 40;
+    unsigned vertice2 = random() % 40;
+    unsigned action = random() % 10;
+    if (action < 6 && vertice1 != vertice2 && !(reference.count(vertice1) && reference[vertice1].count(vertice2))) {
+      graph.add_edge(vertice1, vertice2);
+      add_reference_edge(reference, vertice1, vertice2);
+    } else if (action < 7 && !reference.count(vertice1)) {
+      graph.add_vertice(vertice1);
+      reference[vertice1];
+    } else if (action < 9 && reference.count(vertice1) && reference[vertice1].count(vertice2)) {
+      graph.delete_edge(vertice1, vertice2);
+      reference[vertice1].erase(vertice2);
+      reference[vertice2].erase(vertice1);
+    } else if (action == 9 && reference.count(vertice1)) {
+      graph.delete_vertice(vertice1);
+      for (unsigned neighbour: reference[vertice1]) {
+        reference[neighbour].erase(vertice1);
+      }
+      reference.erase(vertice1);
+    }
+    if (step % 20 == 0) {
+      check_graph(graph, reference);
+    }
+  }
+  check_graph(graph, reference);
+  BOOST_CHECK_THROW(graph.delete_vertice(100), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(graph_read_and_union_test)
+{
+  std::istringstream in("4\n3 : 1 2\n1 : 3\n2 : 3\n7 :\n");
+  maslevtsov::Graph graph1;
+  in >> graph1;
+  reference_t reference1;
+  add_reference_edge(reference1, 3, 1);
+  add_reference_edge(reference1, 3, 2);
+  reference1[7];
+  check_graph(graph1, reference1);
+  maslevtsov::Graph graph2;
+  graph2.add_edge(7, 1);
+  graph2.add_edge(3, 1);
+  maslevtsov::Graph united(graph1, graph2);
+  reference_t reference2 = reference1;
+  add_reference_edge(reference2, 7, 1);
+  check_graph(united, reference2);
+  maslevtsov::Vector< unsigned > vertices;
+  vertices.push_back(3);
+  vertices.push_back(7);
+  vertices.push_back(1);
+  maslevtsov::Graph subgraph(united, vertices);
+  reference_t reference3;
+  add_reference_edge(reference3, 3, 1);
+  add_reference_edge(reference3, 7, 1);
+  check_graph(subgraph, reference3);
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,310 @@
+#include "expression_cache.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <stack.hpp>
+#include "checked_operations.hpp"
+
+namespace {
+  bool is_operation(const std::string& str) noexcept
+  {
+    return str == "*" || str == "/" || str == "%" || str == "+" || str == "-";
+  }
+
+  bool is_operation(char symbol) noexcept
+  {
+    return symbol == '*' || symbol == '/' || symbol == '%' || symbol == '+' || symbol == '-';
+  }
+
+  int get_precedence(char op)
+  {
+    switch (op) {
+    case '*':
+    case '/':
+    case '%':
+      return 1;
+    case '+':
+    case '-':
+      return 2;
+    default:
+      return 3;
+    }
+  }
+
+  long long parse_operand(const std::string& str)
+  {
+    std::size_t pos = 0;
+    long long value = std::stoll(str, &pos);
+    if (pos != str.length()) {
+      throw std::invalid_argument("invalid operand");
+    }
+    return value;
+  }
+
+  std::size_t mix_hash(std::size_t seed, std::size_t value) noexcept
+  {
+    return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+  }
+
+  const std::size_t span_base = 0x100000001b3ull;
+}
+
+maslevtsov::ExpressionCache::ExpressionCache(std::size_t max_size):
+  max_size_(max_size),
+  subtrees_(),
+  spans_(),
+  sources_(),
+  powers_(),
+  results_()
+{
+  subtrees_.max_load_factor(0.5f);
+  spans_.max_load_factor(0.5f);
+}
+
+long long maslevtsov::ExpressionCache::evaluate(Queue< std::string > postfix)
+{
+  if (results_.size() > max_size_) {
+    clear();
+  }
+  Stack< std::size_t > dump;
+  while (!postfix.empty()) {
+    SubtreeKey key{0, 0, 0, 0};
+    if (is_operation(postfix.front())) {
+      if (dump.size() < 2) {
+        throw std::logic_error("invalid expression");
+      }
+      key.operation = postfix.front()[0];
+      key.right = dump.top();
+      dump.pop();
+      key.left = dump.top();
+      dump.pop();
+    } else {
+      key.value = parse_operand(postfix.front());
+    }
+    std::size_t id = intern(key);
+    if (results_[id].error) {
+      std::rethrow_exception(results_[id].error);
+    }
+    dump.push(id);
+    postfix.pop();
+  }
+  if (dump.empty()) {
+    throw std::logic_error("invalid expression");
+  }
+  return results_[dump.top()].value;
+}
+
+long long maslevtsov::ExpressionCache::evaluate(const std::string& infix)
+{
+  if (results_.size() + spans_.size() > max_size_) {
+    clear();
+  }
+  SpanParse parse{infix, split_infix(infix), Vector< std::size_t >(), Vector< std::size_t >(),
+    Vector< std::size_t >(), 0, sources_.size(), false, nullptr};
+  Vector< std::size_t > opened;
+  for (std::size_t i = 0; i != parse.tokens.size(); ++i) {
+    const InfixToken& token = parse.tokens[i];
+    parse.matches.push_back(0);
+    if (token.end - token.begin == 1 && infix[token.begin] == '(') {
+      opened.push_back(i);
+    } else if (token.end - token.begin == 1 && infix[token.begin] == ')') {
+      if (opened.empty()) {
+        throw std::logic_error("invalid expression");
+      }
+      parse.matches[opened.back()] = i;
+      opened.pop_back();
+    }
+  }
+  if (!opened.empty()) {
+    throw std::logic_error("invalid expression");
+  }
+  parse.prefixes.push_back(0);
+  for (std::size_t i = 0; i != infix.length(); ++i) {
+    parse.prefixes.push_back(parse.prefixes.back() * span_base + static_cast< unsigned char >(infix[i]) + 1);
+  }
+  while (powers_.size() <= infix.length()) {
+    powers_.push_back(powers_.empty() ? 1 : powers_.back() * span_base);
+  }
+  parse_span(parse, 0, parse.tokens.size());
+  if (parse.error) {
+    std::rethrow_exception(parse.error);
+  }
+  if (parse.operands.empty()) {
+    throw std::logic_error("invalid expression");
+  }
+  return results_[parse.operands.back()].value;
+}
+
+std::size_t maslevtsov::ExpressionCache::size() const noexcept
+{
+  return results_.size();
+}
+
+void maslevtsov::ExpressionCache::clear() noexcept
+{
+  subtrees_.clear();
+  spans_.clear();
+  sources_.clear();
+  results_.clear();
+}
+
+bool maslevtsov::ExpressionCache::SubtreeKey::operator==(const SubtreeKey& rhs) const noexcept
+{
+  return operation == rhs.operation && left == rhs.left && right == rhs.right && value == rhs.value;
+}
+
+std::size_t maslevtsov::ExpressionCache::SubtreeHash::operator()(const SubtreeKey& key) const noexcept
+{
+  std::size_t hash = std::hash< char >{}(key.operation);
+  hash = mix_hash(hash, key.left);
+  hash = mix_hash(hash, key.right);
+  return mix_hash(hash, std::hash< long long >{}(key.value));
+}
+
+std::size_t maslevtsov::ExpressionCache::SubtreeProbeHash::operator()(const SubtreeKey& key) const noexcept
+{
+  std::size_t hash = (key.left * 31 + key.right) * 31 + static_cast< unsigned char >(key.operation);
+  return mix_hash(hash, static_cast< std::size_t >(key.value) * 0xff51afd7ed558ccdull);
+}
+
+bool maslevtsov::ExpressionCache::SpanKey::operator==(const SpanKey& rhs) const noexcept
+{
+  return hash == rhs.hash && length == rhs.length;
+}
+
+std::size_t maslevtsov::ExpressionCache::SpanHash::operator()(const SpanKey& key) const noexcept
+{
+  return mix_hash(key.hash, key.length);
+}
+
+std::size_t maslevtsov::ExpressionCache::SpanProbeHash::operator()(const SpanKey& key) const noexcept
+{
+  return mix_hash(key.length, key.hash >> 32) * 0xff51afd7ed558ccdull;
+}
+
+std::size_t maslevtsov::ExpressionCache::intern(const SubtreeKey& key)
+{
+  auto it = subtrees_.find(key);
+  if (it != subtrees_.end()) {
+    return it->second;
+  }
+  SubtreeResult result{0, nullptr};
+  if (key.operation == 0) {
+    result.value = key.value;
+  } else if (results_[key.left].error) {
+    result.error = results_[key.left].error;
+  } else if (results_[key.right].error) {
+    result.error = results_[key.right].error;
+  } else {
+    try {
+      result.value = checked_operation(results_[key.left].value, results_[key.right].value, {key.operation});
+    } catch (...) {
+      result.error = std::current_exception();
+    }
+  }
+  std::size_t id = results_.size();
+  results_.push_back(result);
+  try {
+    subtrees_.insert({key, id});
+  } catch (...) {
+    results_.pop_back();
+    throw;
+  }
+  return id;
+}
+
+std::size_t maslevtsov::ExpressionCache::add_error(std::exception_ptr error)
+{
+  results_.push_back(SubtreeResult{0, error});
+  return results_.size() - 1;
+}
+
+void maslevtsov::ExpressionCache::push_operand(SpanParse& parse, std::size_t id)
+{
+  parse.operands.push_back(id);
+  if (!parse.error && results_[id].error) {
+    parse.error = results_[id].error;
+  }
+}
+
+void maslevtsov::ExpressionCache::reduce(SpanParse& parse, char operation)
+{
+  if (parse.operands.size() < 2) {
+    parse.is_broken = true;
+    push_operand(parse, add_error(std::make_exception_ptr(std::logic_error("invalid expression"))));
+    return;
+  }
+  std::size_t right = parse.operands.back();
+  parse.operands.pop_back();
+  std::size_t left = parse.operands.back();
+  parse.operands.pop_back();
+  parse.lowest = std::min(parse.lowest, parse.operands.size());
+  push_operand(parse, intern(SubtreeKey{operation, left, right, 0}));
+}
+
+maslevtsov::ExpressionCache::SpanKey maslevtsov::ExpressionCache::get_span_key(const SpanParse& parse,
+  std::size_t begin, std::size_t length) const noexcept
+{
+  return SpanKey{parse.prefixes[begin + length] - parse.prefixes[begin] * powers_[length], length};
+}
+
+void maslevtsov::ExpressionCache::parse_span(SpanParse& parse, std::size_t first, std::size_t last)
+{
+  if (first == last) {
+    return;
+  }
+  std::size_t begin = parse.tokens[first].begin;
+  std::size_t length = parse.tokens[last - 1].end - begin;
+  SpanKey key = get_span_key(parse, begin, length);
+  auto span_it = spans_.find(key);
+  bool is_free = span_it == spans_.end();
+  if (!is_free) {
+    const SpanEntry& entry = span_it->second;
+    if (parse.infix.compare(begin, length, sources_[entry.source], entry.offset, length) == 0) {
+      push_operand(parse, entry.id);
+      return;
+    }
+  }
+  std::size_t mark = parse.operands.size();
+  std::size_t lowest = parse.lowest;
+  parse.lowest = mark;
+  parse_tokens(parse, first, last);
+  if (is_free && !parse.is_broken && parse.lowest == mark && parse.operands.size() == mark + 1) {
+    if (sources_.size() == parse.source) {
+      sources_.push_back(parse.infix);
+    }
+    spans_.insert({key, SpanEntry{parse.source, begin, parse.operands.back()}});
+  }
+  parse.lowest = std::min(lowest, parse.lowest);
+}
+
+void maslevtsov::ExpressionCache::parse_tokens(SpanParse& parse, std::size_t first, std::size_t last)
+{
+  Vector< char > operations;
+  for (std::size_t i = first; i != last; ++i) {
+    const InfixToken& token = parse.tokens[i];
+    char symbol = token.end - token.begin == 1 ? parse.infix[token.begin] : '\0';
+    if (symbol == '(') {
+      parse_span(parse, i + 1, parse.matches[i]);
+      i = parse.matches[i];
+    } else if (is_operation(symbol)) {
+      while (!operations.empty() && get_precedence(operations.back()) <= get_precedence(symbol)) {
+        reduce(parse, operations.back());
+        operations.pop_back();
+      }
+      operations.push_back(symbol);
+    } else {
+      long long value = 0;
+      std::exception_ptr error = nullptr;
+      try {
+        value = parse_operand(parse.infix.substr(token.begin, token.end - token.begin));
+      } catch (const std::logic_error&) {
+        error = std::current_exception();
+      }
+      push_operand(parse, error ? add_error(error) : intern(SubtreeKey{0, 0, 0, value}));
+    }
+  }
+  while (!operations.empty()) {
+    reduce(parse, operations.back());
+    operations.pop_back();
+  }
+}
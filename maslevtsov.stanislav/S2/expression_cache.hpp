@@ -0,0 +1,108 @@
+#ifndef EXPRESSION_CACHE_HPP
+#define EXPRESSION_CACHE_HPP
+
+#include <exception>
+#include <string>
+#include <queue.hpp>
+#include <hash_table/definition.hpp>
+#include <vector/definition.hpp>
+#include "infix_tokens.hpp"
+
+namespace maslevtsov {
+  class ExpressionCache
+  {
+  public:
+    explicit ExpressionCache(std::size_t max_size = 1 << 20);
+
+    long long evaluate(Queue< std::string > postfix);
+    long long evaluate(const std::string& infix);
+
+    std::size_t size() const noexcept;
+    void clear() noexcept;
+
+  private:
+    struct SubtreeKey
+    {
+      char operation;
+      std::size_t left;
+      std::size_t right;
+      long long value;
+
+      bool operator==(const SubtreeKey& rhs) const noexcept;
+    };
+
+    struct SubtreeHash
+    {
+      std::size_t operator()(const SubtreeKey& key) const noexcept;
+    };
+
+    struct SubtreeProbeHash
+    {
+      std::size_t operator()(const SubtreeKey& key) const noexcept;
+    };
+
+    struct SubtreeResult
+    {
+      long long value;
+      std::exception_ptr error;
+    };
+
+    struct SpanKey
+    {
+      std::size_t hash;
+      std::size_t length;
+
+      bool operator==(const SpanKey& rhs) const noexcept;
+    };
+
+    struct SpanHash
+    {
+      std::size_t operator()(const SpanKey& key) const noexcept;
+    };
+
+    struct SpanProbeHash
+    {
+      std::size_t operator()(const SpanKey& key) const noexcept;
+    };
+
+    struct SpanEntry
+    {
+      std::size_t source;
+      std::size_t offset;
+      std::size_t id;
+    };
+
+    struct SpanParse
+    {
+      const std::string& infix;
+      Vector< InfixToken > tokens;
+      Vector< std::size_t > matches;
+      Vector< std::size_t > prefixes;
+      Vector< std::size_t > operands;
+      std::size_t lowest;
+      std::size_t source;
+      bool is_broken;
+      std::exception_ptr error;
+    };
+
+    using subtrees_t = HashTable< SubtreeKey, std::size_t, SubtreeHash, SubtreeProbeHash >;
+    using spans_t = HashTable< SpanKey, SpanEntry, SpanHash, SpanProbeHash >;
+
+    std::size_t max_size_;
+    subtrees_t subtrees_;
+    spans_t spans_;
+    Vector< std::string > sources_;
+    Vector< std::size_t > powers_;
+    Vector< SubtreeResult > results_;
+
+    std::size_t intern(const SubtreeKey& key);
+    std::size_t add_error(std::exception_ptr error);
+    void push_operand(SpanParse& parse, std::size_t id);
+    void reduce(SpanParse& parse, char operation);
+    SpanKey get_span_key(const SpanParse& parse, std::size_t begin, std::size_t length) const noexcept;
+    void parse_span(SpanParse& parse, std::size_t first, std::size_t last);
+    void parse_tokens(SpanParse& parse, std::size_t first, std::size_t last);
+  };
+}
+
+#endif
@@ -9,3 +9,13 @@ void maslevtsov::calculate_expressions(expression_queue& exp_queue, results_stac
   }
   exp_queue = copy;
 }
+
+void maslevtsov::calculate_expressions(expression_queue& exp_queue, results_stack& results, ExpressionCache& cache)
+{
+  expression_queue copy = exp_queue;
+  while (!exp_queue.empty()) {
+    results.push((exp_queue.front())(cache));
+    exp_queue.pop();
+  }
+  exp_queue = copy;
+}
@@ -9,6 +9,7 @@ namespace maslevtsov {
   using results_stack = maslevtsov::Stack< long long >;
 
   void calculate_expressions(expression_queue& exp_queue, results_stack& results);
+  void calculate_expressions(expression_queue& exp_queue, results_stack& results, ExpressionCache& cache);
 }
 
 #endif
@@ -0,0 +1,14 @@
+#include "infix_tokens.hpp"
+#include <algorithm>
+
+maslevtsov::Vector< maslevtsov::InfixToken > maslevtsov::split_infix(const std::string& infix)
+{
+  Vector< InfixToken > tokens;
+  std::size_t start = 0;
+  while (start < infix.length()) {
+    std::size_t end = std::min(infix.find(' ', start), infix.length());
+    tokens.push_back(InfixToken{start, end});
+    start = end + 1;
+  }
+  return tokens;
+}
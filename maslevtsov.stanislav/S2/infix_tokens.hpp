@@ -0,0 +1,17 @@
+#ifndef INFIX_TOKENS_HPP
+#define INFIX_TOKENS_HPP
+
+#include <string>
+#include <vector/definition.hpp>
+
+namespace maslevtsov {
+  struct InfixToken
+  {
+    std::size_t begin;
+    std::size_t end;
+  };
+
+  Vector< InfixToken > split_infix(const std::string& infix);
+}
+
+#endif
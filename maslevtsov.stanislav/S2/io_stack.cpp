@@ -13,6 +13,19 @@ void maslevtsov::input_expressions(std::istream& in, expression_queue& exp_queue
   }
 }
 
+void maslevtsov::input_expressions(std::istream& in, expression_queue& exp_queue, ExpressionCache& cache)
+{
+  std::string str;
+  while (!in.eof()) {
+    std::getline(in, str);
+    if (str.empty()) {
+      continue;
+    }
+    PostfixToken token(str, cache);
+    exp_queue.push(token);
+  }
+}
+
 void maslevtsov::output_results(std::ostream& out, results_stack& results) noexcept
 {
   out << results.top();
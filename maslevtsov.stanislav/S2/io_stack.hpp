@@ -10,6 +10,7 @@ namespace maslevtsov {
   using results_stack = maslevtsov::Stack< long long >;
 
   void input_expressions(std::istream& in, expression_queue& exp_queue);
+  void input_expressions(std::istream& in, expression_queue& exp_queue, ExpressionCache& cache);
   void output_results(std::ostream& out, results_stack& results) noexcept;
 }
 
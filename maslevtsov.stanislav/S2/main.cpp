@@ -1,3 +1,4 @@
+#include <cstring>
 #include <fstream>
 #include "io_stack.hpp"
 #include "expression_processing.hpp"
@@ -6,22 +7,28 @@ int main(int argc, char** argv)
 {
   using namespace maslevtsov;
 
-  if (argc > 2) {
+  bool use_cache = argc > 1 && std::strcmp(argv[1], "--cache") == 0;
+  int file_arg = use_cache ? 2 : 1;
+  if (argc > file_arg + 1) {
     std::cerr << "Invalid amount of arguments\n";
     return 1;
   }
+  ExpressionCache cache;
   expression_queue exp_queue;
   try {
-    if (argc == 1) {
-      input_expressions(std::cin, exp_queue);
-    }
-    if (argc == 2) {
-      std::ifstream fin(argv[1]);
+    std::ifstream fin;
+    if (argc == file_arg + 1) {
+      fin.open(argv[file_arg]);
       if (!fin) {
         std::cerr << "Invalid input file\n";
         return 1;
       }
-      input_expressions(fin, exp_queue);
+    }
+    std::istream& in = fin.is_open() ? fin : std::cin;
+    if (use_cache) {
+      input_expressions(in, exp_queue, cache);
+    } else {
+      input_expressions(in, exp_queue);
     }
   } catch (...) {
     std::cerr << "Incorrect input\n";
@@ -35,7 +42,11 @@ int main(int argc, char** argv)
 
   results_stack results;
   try {
-    calculate_expressions(exp_queue, results);
+    if (use_cache) {
+      calculate_expressions(exp_queue, results, cache);
+    } else {
+      calculate_expressions(exp_queue, results);
+    }
   } catch (...) {
     std::cerr << "Calculation error\n";
     return 1;
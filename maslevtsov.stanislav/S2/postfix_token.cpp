@@ -2,6 +2,7 @@
 #include <sstream>
 #include <stack.hpp>
 #include "checked_operations.hpp"
+#include "infix_tokens.hpp"
 
 namespace {
   bool is_operation(const std::string& str) noexcept
@@ -28,54 +29,59 @@ namespace {
   {
     return get_precedence(left[0]) <= get_precedence(right[0]);
   }
-}
 
-maslevtsov::PostfixToken::PostfixToken(const std::string& infix_token):
-  token_()
-{
-  Stack< std::string > dump;
-  std::size_t start = 0;
-  while (start < infix_token.length()) {
-    std::size_t end = infix_token.find(' ', start);
-    std::string element = "";
-    if (end == std::string::npos) {
-      element = infix_token.substr(start);
-      start = infix_token.length();
-    } else {
-      element = infix_token.substr(start, end - start);
-      start = end + 1;
-    }
-    if (element == "(") {
-      dump.push(element);
-    } else if (is_operation(element)) {
-      while (!dump.empty() && (precedence_comp(dump.top(), element))) {
-        token_.push(dump.top());
-        dump.pop();
-      }
-      dump.push(element);
-    } else if (element == ")") {
-      while (!dump.empty() && dump.top() != "(") {
-        token_.push(dump.top());
+  maslevtsov::Queue< std::string > to_postfix(const std::string& infix_token)
+  {
+    maslevtsov::Queue< std::string > result;
+    maslevtsov::Stack< std::string > dump;
+    maslevtsov::Vector< maslevtsov::InfixToken > tokens = maslevtsov::split_infix(infix_token);
+    for (std::size_t i = 0; i != tokens.size(); ++i) {
+      std::string element = infix_token.substr(tokens[i].begin, tokens[i].end - tokens[i].begin);
+      if (element == "(") {
+        dump.push(element);
+      } else if (is_operation(element)) {
+        while (!dump.empty() && (precedence_comp(dump.top(), element))) {
+          result.push(dump.top());
+          dump.pop();
+        }
+        dump.push(element);
+      } else if (element == ")") {
+        while (!dump.empty() && dump.top() != "(") {
+          result.push(dump.top());
+          dump.pop();
+        }
+        if (dump.empty()) {
+          throw std::logic_error("invalid expression");
+        }
         dump.pop();
+      } else {
+        result.push(element);
       }
-      if (dump.empty()) {
+    }
+    while (!dump.empty()) {
+      if (!is_operation(dump.top())) {
         throw std::logic_error("invalid expression");
       }
+      result.push(dump.top());
       dump.pop();
-    } else {
-      token_.push(element);
     }
+    return result;
   }
-  while (!dump.empty()) {
-    if (!is_operation(dump.top())) {
-      throw std::logic_error("invalid expression");
-    }
-    token_.push(dump.top());
-    dump.pop();
-  }
+}
+
+maslevtsov::PostfixToken::PostfixToken(const std::string& infix_token):
+  token_(to_postfix(infix_token))
+{
   (*this)();
 }
 
+maslevtsov::PostfixToken::PostfixToken(const std::string& infix_token, ExpressionCache& cache):
+  token_(),
+  infix_(infix_token)
+{
+  (*this)(cache);
+}
+
 maslevtsov::PostfixToken maslevtsov::PostfixToken::operator+(const PostfixToken& other) const
 {
   PostfixToken result(*this);
@@ -109,7 +115,7 @@ maslevtsov::PostfixToken maslevtsov::PostfixToken::operator%(const PostfixToken&
 long long maslevtsov::PostfixToken::operator()() const
 {
   Stack< long long > dump;
-  Queue< std::string > exp = token_;
+  Queue< std::string > exp = get_postfix();
   while (!exp.empty()) {
     if (is_operation(exp.front())) {
       if (dump.size() < 2) {
@@ -134,14 +140,26 @@ long long maslevtsov::PostfixToken::operator()() const
   return dump.top();
 }
 
+long long maslevtsov::PostfixToken::operator()(ExpressionCache& cache) const
+{
+  return infix_.empty() ? cache.evaluate(token_) : cache.evaluate(infix_);
+}
+
 maslevtsov::PostfixToken& maslevtsov::PostfixToken::math_operator_impl(const PostfixToken& other,
   const std::string& operation)
 {
-  PostfixToken copy(other);
-  while (!copy.token_.empty()) {
-    token_.push(copy.token_.front());
-    copy.token_.pop();
+  token_ = get_postfix();
+  infix_.clear();
+  Queue< std::string > other_token = other.get_postfix();
+  while (!other_token.empty()) {
+    token_.push(other_token.front());
+    other_token.pop();
   }
   token_.push(operation);
   return *this;
 }
+
+maslevtsov::Queue< std::string > maslevtsov::PostfixToken::get_postfix() const
+{
+  return infix_.empty() ? token_ : to_postfix(infix_);
+}
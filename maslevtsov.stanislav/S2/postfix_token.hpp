@@ -3,6 +3,7 @@
 
 #include <string>
 #include <queue.hpp>
+#include "expression_cache.hpp"
 
 namespace maslevtsov {
   class PostfixToken
@@ -12,6 +13,7 @@ namespace maslevtsov {
     PostfixToken(const PostfixToken& rhs) = default;
     PostfixToken(PostfixToken&& rhs) noexcept = default;
     PostfixToken(const std::string& infix_token);
+    PostfixToken(const std::string& infix_token, ExpressionCache& cache);
     ~PostfixToken() = default;
 
     PostfixToken& operator=(const PostfixToken& rhs) = default;
@@ -23,10 +25,13 @@ namespace maslevtsov {
     PostfixToken operator/(const PostfixToken& other) const;
     PostfixToken operator%(const PostfixToken& other) const;
     long long operator()() const;
+    long long operator()(ExpressionCache& cache) const;
 
   private:
     Queue< std::string > token_;
+    std::string infix_;
 
+    Queue< std::string > get_postfix() const;
     PostfixToken& math_operator_impl(const PostfixToken& other, const std::string& operation);
   };
 }
@@ -0,0 +1,67 @@
+#include <boost/test/unit_test.hpp>
+#include <stdexcept>
+#include <string>
+#include "postfix_token.hpp"
+
+BOOST_AUTO_TEST_SUITE(expression_cache_tests)
+BOOST_AUTO_TEST_CASE(expression_cache_evaluation_test)
+{
+  maslevtsov::ExpressionCache cache;
+  maslevtsov::PostfixToken exp1("( 1 + 2 ) * ( 1 + 2 )");
+  BOOST_TEST(exp1(cache) == exp1());
+  std::size_t size = cache.size();
+  maslevtsov::PostfixToken exp2("( 1 + 2 ) * ( 1 + 2 ) - 4 % 3");
+  BOOST_TEST(exp2(cache) == exp2());
+  BOOST_TEST(exp1(cache) == 9);
+  BOOST_TEST(cache.size() == size + 4);
+}
+
+BOOST_AUTO_TEST_CASE(expression_cache_error_test)
+{
+  maslevtsov::ExpressionCache cache;
+  maslevtsov::PostfixToken exp1("9223372036854775807");
+  maslevtsov::PostfixToken exp2("1");
+  maslevtsov::PostfixToken sum(exp1 + exp2);
+  BOOST_CHECK_THROW(sum(cache), std::overflow_error);
+  BOOST_CHECK_THROW(sum(cache), std::overflow_error);
+  BOOST_CHECK_THROW(maslevtsov::PostfixToken("5 / ( 2 - 2 )", cache), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(expression_cache_clear_test)
+{
+  maslevtsov::ExpressionCache cache(2);
+  maslevtsov::PostfixToken exp("1 + 2 * 3");
+  BOOST_TEST(exp(cache) == 7);
+  BOOST_TEST(exp(cache) == 7);
+  BOOST_TEST(cache.size() == 5);
+}
+
+BOOST_AUTO_TEST_CASE(expression_cache_span_test)
+{
+  maslevtsov::ExpressionCache cache;
+  BOOST_TEST(maslevtsov::PostfixToken("( 1 + 2 ) * 3", cache)(cache) == 9);
+  std::size_t size = cache.size();
+  maslevtsov::PostfixToken exp("( 4 - ( 1 + 2 ) * 3 ) % 5", cache);
+  BOOST_TEST(exp(cache) == exp());
+  BOOST_TEST(cache.size() == size + 4);
+  BOOST_TEST(maslevtsov::PostfixToken("( 1 + 2 ) * 3 ", cache)(cache) == 9);
+  BOOST_TEST((exp + maslevtsov::PostfixToken("1 + 2", cache))(cache) == 3);
+}
+
+BOOST_AUTO_TEST_CASE(expression_cache_span_error_test)
+{
+  auto is_invalid = [](const std::logic_error& e)
+  {
+    return std::string(e.what()) == "invalid expression";
+  };
+  maslevtsov::ExpressionCache cache;
+  BOOST_CHECK_THROW(maslevtsov::PostfixToken("1 *  x", cache), std::invalid_argument);
+  BOOST_CHECK_EXCEPTION(maslevtsov::PostfixToken("1 * ", cache), std::logic_error, is_invalid);
+  BOOST_CHECK_THROW(maslevtsov::PostfixToken("x + ( 1 * )", cache), std::invalid_argument);
+  BOOST_CHECK_EXCEPTION(maslevtsov::PostfixToken("( 1 * ) + x", cache), std::logic_error, is_invalid);
+  BOOST_CHECK_EXCEPTION(maslevtsov::PostfixToken("( )", cache), std::logic_error, is_invalid);
+  BOOST_CHECK_EXCEPTION(maslevtsov::PostfixToken("( 1 + 2", cache), std::logic_error, is_invalid);
+  BOOST_TEST(maslevtsov::PostfixToken("( 1 2 ) + 3", cache)(cache) == maslevtsov::PostfixToken("( 1 2 ) + 3")());
+  BOOST_TEST(maslevtsov::PostfixToken("1 2 ( + )", cache)(cache) == maslevtsov::PostfixToken("1 2 ( + )")());
+}
+BOOST_AUTO_TEST_SUITE_END()
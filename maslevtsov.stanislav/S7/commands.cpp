@@ -1,4 +1,5 @@
 #include "commands.hpp"
+#include <utility>
 #include <vector/definition.hpp>
 #include <tree/definition.hpp>
 #include <hash_table/definition.hpp>
@@ -124,7 +125,7 @@ void maslevtsov::merge_graphs(graphs_map_t& graphs, std::istream& in)
     throw std::invalid_argument("invalid graph name");
   }
   Graph new_gr(graphs.at(gr1_name), graphs.at(gr2_name));
-  graphs[new_gr_name] = new_gr;
+  graphs[new_gr_name] = std::move(new_gr);
 }
 
 void maslevtsov::extract_from_graph(graphs_map_t& graphs, std::istream& in)
@@ -19,11 +19,17 @@ namespace {
     }
   }
 
-  void add_edges(maslevtsov::Graph& dist, const maslevtsov::Graph::edges_set_t& src)
+  void merge_edges(maslevtsov::Graph::edges_set_t& dist, const maslevtsov::Graph::edges_set_t& src)
   {
     for (auto i = src.cbegin(); i != src.cend(); ++i) {
-      for (auto j = i->second.cbegin(); j != i->second.cend(); ++j) {
-        dist.bind(i->first.first, i->first.second, *j);
+      if (i->second.empty()) {
+        continue;
+      }
+      auto inserted = dist.insert(*i);
+      if (!inserted.second) {
+        for (auto j = i->second.cbegin(); j != i->second.cend(); ++j) {
+          inserted.first->second.push_back(*j);
+        }
       }
     }
   }
@@ -50,8 +56,9 @@ namespace {
 maslevtsov::Graph::Graph(const Graph& src1, const Graph& src2):
   Graph()
 {
-  add_edges(*this, src1.edges_set_);
-  add_edges(*this, src2.edges_set_);
+  edges_set_.rehash(src1.edges_set_.size() + src2.edges_set_.size() + 1);
+  merge_edges(edges_set_, src1.edges_set_);
+  merge_edges(edges_set_, src2.edges_set_);
 }
 
 maslevtsov::Graph::Graph(const Graph& src, Vector< std::string >& vertices):
@@ -86,21 +86,21 @@ template< class Key, class T, class Hash, class ProbeHash, class KeyEqual >
 typename maslevtsov::HashTable< Key, T, Hash, ProbeHash, KeyEqual >::iterator
   maslevtsov::HashTable< Key, T, Hash, ProbeHash, KeyEqual >::begin() noexcept
 {
-  return slots_[0].state == detail::SlotState::EMPTY ? ++iterator(this, 0) : iterator(this, 0);
+  return slots_[0].state != detail::SlotState::OCCUPIED ? ++iterator(this, 0) : iterator(this, 0);
 }
 
 template< class Key, class T, class Hash, class ProbeHash, class KeyEqual >
 typename maslevtsov::HashTable< Key, T, Hash, ProbeHash, KeyEqual >::const_iterator
   maslevtsov::HashTable< Key, T, Hash, ProbeHash, KeyEqual >::begin() const noexcept
 {
-  return slots_[0].state == detail::SlotState::EMPTY ? ++const_iterator(this, 0) : const_iterator(this, 0);
+  return slots_[0].state != detail::SlotState::OCCUPIED ? ++const_iterator(this, 0) : const_iterator(this, 0);
 }
 
 template< class Key, class T, class Hash, class ProbeHash, class KeyEqual >
 typename maslevtsov::HashTable< Key, T, Hash, ProbeHash, KeyEqual >::const_iterator
   maslevtsov::HashTable< Key, T, Hash, ProbeHash, KeyEqual >::cbegin() const noexcept
 {
-  return slots_[0].state == detail::SlotState::EMPTY ? ++const_iterator(this, 0) : const_iterator(this, 0);
+  return slots_[0].state != detail::SlotState::OCCUPIED ? ++const_iterator(this, 0) : const_iterator(this, 0);
 }
 
 template< class Key, class T, class Hash, class ProbeHash, class KeyEqual >
@@ -319,7 +319,7 @@ void maslevtsov::HashTable< Key, T, Hash, ProbeHash, KeyEqual >::rehash(size_typ
     if (it->state == detail::SlotState::OCCUPIED) {
       const Key& key = it->data.first;
       size_t index = hasher_(key) % new_slots.size();
-      size_t odd_step = detail::get_odd_step(key, slots_.size(), probe_hasher_);
+      size_t odd_step = detail::get_odd_step(key, new_slots.size(), probe_hasher_);
       while (new_slots[index].state == detail::SlotState::OCCUPIED) {
         index = (index + odd_step) % new_slots.size();
       }
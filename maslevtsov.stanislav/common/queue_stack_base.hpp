@@ -93,7 +93,7 @@ namespace maslevtsov {
   QueueStackBase< T, is_pop_front >& QueueStackBase< T, is_pop_front >::operator=(QueueStackBase&& rhs) noexcept
   {
     QueueStackBase< T, is_pop_front > moved(std::move(rhs));
-    swap(rhs);
+    swap(moved);
     return *this;
   }
 
@@ -158,7 +158,8 @@ namespace maslevtsov {
     if (size_ == capacity_) {
       expand_data(size_ * 2 + 1);
     }
-    data_[size_++] = std::forward< U >(value);
+    data_[is_pop_front ? ((first_ + size_) % capacity_) : size_] = std::forward< U >(value);
+    ++size_;
   }
 
   template< class T, bool is_pop_front >
@@ -194,7 +194,7 @@ template< class T >
 void maslevtsov::Vector< T >::push_back(const T& value)
 {
   if (size_ >= capacity_) {
-    expand(capacity_ * 2);
+    expand(capacity_ == 0 ? 16 : capacity_ * 2);
   }
   data_[size_++] = value;
 }
@@ -203,7 +203,7 @@ template< class T >
 void maslevtsov::Vector< T >::push_back(T&& value)
 {
   if (size_ >= capacity_) {
-    expand(capacity_ * 2);
+    expand(capacity_ == 0 ? 16 : capacity_ * 2);
   }
   data_[size_++] = std::move(value);
 }
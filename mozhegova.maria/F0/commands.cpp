@@ -1,7 +1,7 @@
 #include "commands.hpp"
 #include <fstream>
 #include <string>
-#include <numeric>
+#include <algorithm>
 #include <iomanip>
 
 namespace
@@ -33,212 +33,20 @@ namespace
     }
   };
 
-  void bubbleSort(mozhegova::DynamicArray< std::pair< mozhegova::WordPos, std::string > > & arr)
-  {
-    size_t n = arr.size();
-    for (size_t i = 0; i < n - 1; i++)
-    {
-      bool swapped = false;
-      for (size_t j = 0; j < n - i - 1; j++)
-      {
-        if (arr[j].first > arr[j + 1].first)
-        {
-          std::pair< mozhegova::WordPos, std::string > temp = arr[j];
-          arr[j] = arr[j + 1];
-          arr[j + 1] = temp;
-          swapped = true;
-        }
-      }
-      if (swapped == false)
-      {
-        break;
-      }
-    }
-  }
-
-  std::string reconstructText(const mozhegova::Text & text)
-  {
-    mozhegova::DynamicArray< std::pair< mozhegova::WordPos, std::string > > sortedWords;
-    for (auto it1 = text.cbegin(); it1 != text.cend(); ++it1)
-    {
-      for (size_t i = 0; i < it1->second.size(); ++i)
-      {
-        sortedWords.push_back({it1->second[i], it1->first});
-      }
-    }
-    bubbleSort(sortedWords);
-    if (sortedWords.empty())
-    {
-      return "";
-    }
-    std::string result;
-    for (size_t i = 0; i < sortedWords.size(); ++i)
-    {
-      result += sortedWords[i].second;
-      if (i < sortedWords.size() - 1)
-      {
-        if (sortedWords[i].first.first != sortedWords[i + 1].first.first)
-        {
-          result += '\n';
-        }
-        else
-        {
-          result += ' ';
-        }
-      }
-    }
-    return result;
-  }
-
-  size_t getCountWords(const mozhegova::Text & text)
-  {
-    size_t count = 0;
-    for (auto it1 = text.cbegin(); it1 != text.cend(); ++it1)
-    {
-      count += it1->second.size();
-    }
-    return count;
-  }
-
   struct PrintText
   {
     std::ostream & out;
     void operator()(const std::pair< std::string, mozhegova::Text > & text) const
     {
       out << text.first << ' ';
-      out << getCountWords(text.second) << '\n';
-      out << reconstructText(text.second) << '\n';
+      out << text.second.getWordCount() << '\n';
+      out << text.second.getText() << '\n';
     }
   };
 
-  size_t getMaxLineNumWord(constWord & word)
-  {
-    mozhegova::Xrefs xrefs = word.second;
-    if (xrefs.empty())
-    {
-      return 0;
-    }
-    size_t maxNumWord = 1;
-    for (size_t i = 0; i < word.second.size(); ++i)
-    {
-      if (maxNumWord < word.second[i].first)
-      {
-        maxNumWord = word.second[i].first;
-      }
-    }
-    return maxNumWord;
-  }
-
   size_t getMaxLineNum(const mozhegova::Text & text)
   {
-    size_t maxLineNum = 1;
-    for (auto it1 = text.cbegin(); it1 != text.cend(); ++it1)
-    {
-      if (maxLineNum < getMaxLineNumWord(*it1))
-      {
-        maxLineNum = getMaxLineNumWord(*it1);
-      }
-    }
-    return maxLineNum;
-  }
-
-  size_t getMaxNumWord(constWord & word)
-  {
-    mozhegova::Xrefs xrefs = word.second;
-    if (xrefs.empty())
-    {
-      return 0;
-    }
-    size_t maxNumWord = 1;
-    for (size_t i = 0; i < word.second.size(); ++i)
-    {
-      if (maxNumWord < word.second[i].second)
-      {
-        maxNumWord = word.second[i].second;
-      }
-    }
-    return maxNumWord;
-  }
-
-  size_t getMaxNum(const mozhegova::Text & text)
-  {
-    size_t maxLineNum = 1;
-    for (auto it1 = text.cbegin(); it1 != text.cend(); ++it1)
-    {
-      if (maxLineNum < getMaxNumWord(*it1))
-      {
-        maxLineNum = getMaxNumWord(*it1);
-      }
-    }
-    return maxLineNum;
-  }
-
-  mozhegova::Text extractSubstring(const mozhegova::Text & text, size_t begin, size_t end)
-  {
-    mozhegova::Text result;
-    for (auto it1 = text.cbegin(); it1 != text.cend(); ++it1)
-    {
-      mozhegova::Xrefs newXrefs;
-      for (size_t i = 0; i < it1->second.size(); ++i)
-      {
-        if (it1->second[i].first >= begin && it1->second[i].first < end)
-        {
-          newXrefs.push_back(it1->second[i]);
-        }
-      }
-      if (!newXrefs.empty())
-      {
-        result[it1->first] = newXrefs;
-      }
-    }
-    return result;
-  }
-
-  void insertTextTo(mozhegova::Text & text1, const mozhegova::Text & text2, size_t n, size_t begin, size_t end)
-  {
-    mozhegova::Text temp = extractSubstring(text2, begin, end);
-    for (auto it1 = text1.begin(); it1 != text1.end(); ++it1)
-    {
-      for (size_t i = 0; i < it1->second.size(); ++i)
-      {
-        if (it1->second[i].first >= n)
-        {
-          it1->second[i].first += (end - begin);
-        }
-      }
-    }
-    for (auto it2 = temp.cbegin(); it2 != temp.cend(); ++it2)
-    {
-      for (size_t i = 0; i < it2->second.size(); ++i)
-      {
-        text1[it2->first].push_back({it2->second[i].first + n - begin, it2->second[i].second});
-      }
-    }
-  }
-
-  void removeSubstring(mozhegova::Text & text, size_t begin, size_t end)
-  {
-    for (auto it1 = text.begin(); it1 != text.end();)
-    {
-      bool isDeleted = false;
-      for (size_t i = 0; i < it1->second.size(); ++i)
-      {
-        if (it1->second[i].first >= begin && it1->second[i].first < end)
-        {
-          it1 = text.erase(it1);
-          isDeleted = true;
-          break;
-        }
-        else if (it1->second[i].first >= end)
-        {
-          it1->second[i].first -= (end - begin);
-        }
-      }
-      if (!isDeleted)
-      {
-        ++it1;
-      }
-    }
+    return std::max< size_t >(text.getLineCount(), 1);
   }
 }
 
@@ -256,16 +64,13 @@ void mozhegova::generateLinks(std::istream & in, Texts & texts)
     throw std::runtime_error("<INVALID COMMAND>");
   }
   Text text{};
-  size_t line = 0;
   while (!file.eof())
   {
-    ++line;
+    text.addLine();
     std::string word;
-    size_t num = 0;
     while (file.peek() != '\n' && file >> word)
     {
-      ++num;
-      text[word].push_back({line, num});
+      text.addWord(word);
     }
     file.ignore();
   }
@@ -292,7 +97,11 @@ void mozhegova::printLinks(std::istream & in, std::ostream & out, const Texts &
   {
     throw std::runtime_error("<INVALID COMMAND>");
   }
-  const Text & text = it->second;
+  const HashTable< std::string, Xrefs > text = it->second.getXrefs();
+  if (text.empty())
+  {
+    return;
+  }
   auto maxWordIt = text.cbegin();
   size_t maxWordLen = maxWordIt->first.size();
   for (; maxWordIt != text.cend(); ++maxWordIt)
@@ -317,9 +126,7 @@ void mozhegova::printText(std::istream & in, std::ostream & out, const Texts & t
   {
     throw std::runtime_error("<INVALID COMMAND>");
   }
-  const Text & text = it->second;
-  std::string reconstructed = reconstructText(text);
-  out << reconstructed << '\n';
+  out << it->second.getText() << '\n';
 }
 
 void mozhegova::printTextInFile(std::istream & in, const Texts & texts)
@@ -349,7 +156,7 @@ void mozhegova::mergeTexts(std::istream & in, Texts & texts)
   const Text & text2 = it2->second;
   Text temp = text1;
   size_t num = getMaxLineNum(temp) + 1;
-  insertTextTo(temp, text2, num, 1, getMaxLineNum(text2) + 1);
+  temp.insertLines(num, text2, 1, getMaxLineNum(text2) + 1);
   texts[newText] = std::move(temp);
 }
 
@@ -366,11 +173,11 @@ void mozhegova::insertText(std::istream & in, Texts & texts)
   }
   Text & text1 = it1->second;
   const Text & text2 = it2->second;
-  if ((num > 1 + getMaxLineNum(text1)) || (begin < 1) || (end > getMaxLineNum(text2) + 1))
+  if ((num < 1) || (num > 1 + getMaxLineNum(text1)) || (begin < 1) || (end < begin) || (end > getMaxLineNum(text2) + 1))
   {
     throw std::runtime_error("<INVALID COMMAND>");
   }
-  insertTextTo(text1, text2, num, begin, end);
+  text1.insertLines(num, text2, begin, end);
 }
 
 void mozhegova::removeLines(std::istream & in, Texts & texts)
@@ -384,11 +191,11 @@ void mozhegova::removeLines(std::istream & in, Texts & texts)
     throw std::runtime_error("<INVALID COMMAND>");
   }
   Text & text = it->second;
-  if ((begin < 1) || (end > getMaxLineNum(text) + 1))
+  if ((begin < 1) || (end < begin) || (end > getMaxLineNum(text) + 1))
   {
     throw std::runtime_error("<INVALID COMMAND>");
   }
-  removeSubstring(text, begin, end);
+  text.removeLines(begin, end);
 }
 
 void mozhegova::moveText(std::istream & in, Texts & texts)
@@ -404,12 +211,12 @@ void mozhegova::moveText(std::istream & in, Texts & texts)
   }
   Text & text1 = it1->second;
   Text & text2 = it2->second;
-  if ((num > 1 + getMaxLineNum(text1)) || (begin < 1) || (end > getMaxLineNum(text2) + 1))
+  if ((num < 1) || (num > 1 + getMaxLineNum(text1)) || (begin < 1) || (end < begin) || (end > getMaxLineNum(text2) + 1))
   {
     throw std::runtime_error("<INVALID COMMAND>");
   }
-  insertTextTo(text1, text2, num, begin, end);
-  removeSubstring(text2, begin, end);
+  text1.insertLines(num, text2, begin, end);
+  text2.removeLines(begin, end);
 }
 
 void mozhegova::sideMergeTexts(std::istream & in, Texts & texts)
@@ -425,25 +232,9 @@ void mozhegova::sideMergeTexts(std::istream & in, Texts & texts)
   }
   const Text & text1 = it1->second;
   const Text & text2 = it2->second;
-  Text temp1 = text1;
-  Text temp2 = text2;
-  size_t maxLines = std::max(getMaxLineNum(text1), getMaxLineNum(text2));
-  size_t maxNum = getMaxNum(text1);
-  for (size_t line = 1; line <= maxLines; ++line)
-  {
-    for (auto it1 = temp2.begin(); it1 != temp2.end(); ++it1)
-    {
-      for (size_t i = 0; i < it1->second.size(); ++i)
-      {
-        if (it1->second[i].first == line)
-        {
-          it1->second[i].second += maxNum;
-          temp1[it1->first].push_back(it1->second[i]);
-        }
-      }
-    }
-  }
-  texts[newText] = std::move(temp1);
+  Text temp = text1;
+  temp.appendByLines(text2);
+  texts[newText] = std::move(temp);
 }
 
 void mozhegova::splitTexts(std::istream & in, Texts & texts)
@@ -458,15 +249,15 @@ void mozhegova::splitTexts(std::istream & in, Texts & texts)
   }
   Text & text = it->second;
   size_t end = getMaxLineNum(text);
-  if (num > end)
+  if ((num < 1) || (num > end))
   {
     throw std::runtime_error("<INVALID COMMAND>");
   }
-  Text newText = extractSubstring(text, num, end + 1);
-  removeSubstring(text, num, end + 1);
-  texts[newText1] = std::move(text);
-  texts[newText2] = std::move(newText);
+  Text head = std::move(text);
+  Text tail = head.splitLines(num);
   texts.erase(textName);
+  texts[newText1] = std::move(head);
+  texts[newText2] = std::move(tail);
 }
 
 void mozhegova::invertLines(std::istream & in, Texts & texts)
@@ -479,14 +270,7 @@ void mozhegova::invertLines(std::istream & in, Texts & texts)
     throw std::runtime_error("<INVALID COMMAND>");
   }
   Text & text = it->second;
-  size_t maxLine = getMaxLineNum(text);
-  for (auto it1 = text.begin(); it1 != text.end(); ++it1)
-  {
-    for (size_t i = 0; i < it1->second.size(); ++i)
-    {
-      it1->second[i].first = maxLine - it1->second[i].first + 1;
-    }
-  }
+  text.invertLines();
 }
 
 void mozhegova::invertWords(std::istream & in, Texts & texts)
@@ -499,21 +283,7 @@ void mozhegova::invertWords(std::istream & in, Texts & texts)
     throw std::runtime_error("<INVALID COMMAND>");
   }
   Text & text = it->second;
-  size_t maxLines = getMaxLineNum(text);
-  size_t maxNum = getMaxNum(text);
-  for (size_t line = 1; line <= maxLines; ++line)
-  {
-    for (auto it1 = text.begin(); it1 != text.end(); ++it1)
-    {
-      for (size_t i = 0; i < it1->second.size(); ++i)
-      {
-        if (it1->second[i].first == line)
-        {
-          it1->second[i].second = maxNum - it1->second[i].second + 1;
-        }
-      }
-    }
-  }
+  text.invertWords();
 }
 
 void mozhegova::replaceWord(std::istream & in, Texts & texts)
@@ -525,14 +295,10 @@ void mozhegova::replaceWord(std::istream & in, Texts & texts)
   {
     throw std::runtime_error("<INVALID COMMAND>");
   }
-  Text & text = it->second;
-  auto wordIt = text.find(oldWord);
-  if (wordIt == text.end())
+  if (!it->second.replaceWord(oldWord, newWord))
   {
     throw std::runtime_error("<INVALID COMMAND>");
   }
-  text[newWord] = std::move(wordIt->second);
-  text.erase(oldWord);
 }
 
 void mozhegova::save(std::istream & in, const Texts & texts)
@@ -572,22 +338,20 @@ void mozhegova::loadFile(const std::string & fileName, Texts & texts)
     std::string textName;
     size_t wordCount;
     file >> textName >> wordCount;
-    Text & currText = texts[textName];
+    Text currText{};
     std::string word;
-    size_t line = 0;
     size_t j = 0;
     while (j < wordCount)
     {
-      ++line;
-      size_t num = 0;
+      currText.addLine();
       while (file.peek() != '\n' && file >> word)
       {
-        ++num;
-        currText[word].push_back({line, num});
+        currText.addWord(word);
         ++j;
       }
       file.ignore();
     }
+    texts[textName] = std::move(currText);
   }
 }
 
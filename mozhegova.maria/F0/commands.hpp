@@ -4,12 +4,10 @@
 #include <iostream>
 #include <hashTable.hpp>
 #include <dynamicArray.hpp>
+#include "text.hpp"
 
 namespace mozhegova
 {
-  using WordPos = std::pair< size_t, size_t >;
-  using Xrefs = DynamicArray< WordPos >;
-  using Text = HashTable< std::string, Xrefs >;
   using Texts = HashTable< std::string, Text >;
 
   void generateLinks(std::istream & in, Texts & texts);
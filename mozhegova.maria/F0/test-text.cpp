@@ -0,0 +1,148 @@
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include "commands.hpp"
+
+namespace
+{
+  mozhegova::Text makeText(const std::string & lines)
+  {
+    mozhegova::Text text;
+    std::istringstream in(lines);
+    std::string line;
+    while (std::getline(in, line))
+    {
+      text.addLine();
+      std::istringstream words(line);
+      std::string word;
+      while (words >> word)
+      {
+        text.addWord(word);
+      }
+    }
+    return text;
+  }
+
+  bool hasPos(const mozhegova::Xrefs & refs, size_t line, size_t word)
+  {
+    for (size_t i = 0; i < refs.size(); ++i)
+    {
+      if (refs[i].first == line && refs[i].second == word)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(line_count_skips_trailing_empty_lines)
+{
+  mozhegova::Text text = makeText("a\n\nb\n\n\n");
+  BOOST_TEST(text.getLineCount() == 3);
+  text.invertLines();
+  BOOST_TEST(text.getLineCount() == 3);
+  BOOST_TEST(text.getText() == "b\na");
+}
+
+BOOST_AUTO_TEST_CASE(invert_lines_then_merge)
+{
+  mozhegova::Texts texts;
+  texts["A"] = makeText("\nx y\nz\n");
+  texts["B"] = makeText("\nw\n");
+  std::istringstream invert("A");
+  mozhegova::invertLines(invert, texts);
+  BOOST_TEST(texts["A"].getLineCount() == 2);
+  std::istringstream merge("M A B");
+  mozhegova::mergeTexts(merge, texts);
+  mozhegova::HashTable< std::string, mozhegova::Xrefs > xrefs = texts["M"].getXrefs();
+  BOOST_TEST(hasPos(xrefs["z"], 1, 1));
+  BOOST_TEST(hasPos(xrefs["x"], 2, 1));
+  BOOST_TEST(hasPos(xrefs["y"], 2, 2));
+  BOOST_TEST(hasPos(xrefs["w"], 4, 1));
+}
+
+BOOST_AUTO_TEST_CASE(split_keeps_positions)
+{
+  mozhegova::Texts texts;
+  texts["t"] = makeText("\na\nb c\n\nd\n");
+  std::istringstream split("t 3 n m");
+  mozhegova::splitTexts(split, texts);
+  BOOST_TEST((texts.find("t") == texts.end()));
+  BOOST_TEST(texts["n"].getLineCount() == 2);
+  mozhegova::HashTable< std::string, mozhegova::Xrefs > xrefs = texts["m"].getXrefs();
+  BOOST_TEST(hasPos(xrefs["b"], 3, 1));
+  BOOST_TEST(hasPos(xrefs["c"], 3, 2));
+  BOOST_TEST(hasPos(xrefs["d"], 5, 1));
+  BOOST_TEST(texts["m"].getText() == "b c\nd");
+}
+
+BOOST_AUTO_TEST_CASE(invert_words_uses_text_max_num)
+{
+  mozhegova::Text text = makeText("a b c\nd\n");
+  text.invertWords();
+  mozhegova::HashTable< std::string, mozhegova::Xrefs > xrefs = text.getXrefs();
+  BOOST_TEST(hasPos(xrefs["c"], 1, 1));
+  BOOST_TEST(hasPos(xrefs["b"], 1, 2));
+  BOOST_TEST(hasPos(xrefs["a"], 1, 3));
+  BOOST_TEST(hasPos(xrefs["d"], 2, 3));
+  BOOST_TEST(text.getText() == "c b a\nd");
+  text.invertWords();
+  xrefs = text.getXrefs();
+  BOOST_TEST(hasPos(xrefs["a"], 1, 1));
+  BOOST_TEST(hasPos(xrefs["d"], 2, 1));
+}
+
+BOOST_AUTO_TEST_CASE(side_merge_offsets_by_text_max_num)
+{
+  mozhegova::Texts texts;
+  texts["A"] = makeText("a b c\nd\n");
+  texts["B"] = makeText("x\ny z\n");
+  std::istringstream merge("S A B");
+  mozhegova::sideMergeTexts(merge, texts);
+  mozhegova::HashTable< std::string, mozhegova::Xrefs > xrefs = texts["S"].getXrefs();
+  BOOST_TEST(hasPos(xrefs["x"], 1, 4));
+  BOOST_TEST(hasPos(xrefs["y"], 2, 4));
+  BOOST_TEST(hasPos(xrefs["z"], 2, 5));
+  BOOST_TEST(hasPos(xrefs["d"], 2, 1));
+  BOOST_TEST(texts["S"].getText() == "a b c x\nd y z");
+}
+
+BOOST_AUTO_TEST_CASE(split_halves_edit_independently)
+{
+  mozhegova::Texts texts;
+  texts["t"] = makeText("a b\nc a\nd\n");
+  std::istringstream split("t 2 n m");
+  mozhegova::splitTexts(split, texts);
+  std::istringstream replace("m a x");
+  mozhegova::replaceWord(replace, texts);
+  texts["n"].addWord("e");
+  texts["m"].removeLines(3, 4);
+  BOOST_TEST(texts["n"].getText() == "a b\ne");
+  BOOST_TEST(texts["m"].getText() == "c x");
+  mozhegova::HashTable< std::string, mozhegova::Xrefs > xrefs = texts["n"].getXrefs();
+  BOOST_TEST(hasPos(xrefs["a"], 1, 1));
+  BOOST_TEST(hasPos(xrefs["e"], 2, 1));
+  BOOST_TEST((xrefs.find("x") == xrefs.end()));
+  xrefs = texts["m"].getXrefs();
+  BOOST_TEST(hasPos(xrefs["x"], 2, 2));
+  BOOST_TEST((xrefs.find("a") == xrefs.end()));
+}
+
+BOOST_AUTO_TEST_CASE(repeated_edits_keep_positions)
+{
+  mozhegova::Text text = makeText("a b\nc\nd e f\n");
+  mozhegova::Text copy = text;
+  for (size_t i = 0; i < 200; ++i)
+  {
+    text.insertLines(2, copy, 1, 4);
+    text.removeLines(2, 5);
+    text.invertLines();
+    text.invertWords();
+  }
+  BOOST_TEST(text.getText() == "a b\nc\nd e f");
+  BOOST_TEST(text.getWordCount() == 6);
+  mozhegova::HashTable< std::string, mozhegova::Xrefs > xrefs = text.getXrefs();
+  BOOST_TEST(hasPos(xrefs["b"], 1, 2));
+  BOOST_TEST(hasPos(xrefs["f"], 3, 3));
+  BOOST_TEST(xrefs["a"].size() == 1);
+}
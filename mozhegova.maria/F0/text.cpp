@@ -0,0 +1,784 @@
+#include "text.hpp"
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+namespace
+{
+  constexpr size_t noPiece = static_cast< size_t >(-1);
+  constexpr std::pair< size_t, size_t > noNums{static_cast< size_t >(-1), 0};
+
+  std::pair< size_t, size_t > combine(const std::pair< size_t, size_t > & lhs, const std::pair< size_t, size_t > & rhs)
+  {
+    return {std::min(lhs.first, rhs.first), std::max(lhs.second, rhs.second)};
+  }
+}
+
+namespace mozhegova
+{
+  size_t Text::Numbering::apply(size_t num) const noexcept
+  {
+    return inverted ? shift - num : num + shift;
+  }
+
+  Text::Bounds Text::Numbering::apply(const Bounds & nums) const noexcept
+  {
+    if (nums.first > nums.second)
+    {
+      return nums;
+    }
+    return inverted ? Bounds{shift - nums.second, shift - nums.first} : Bounds{nums.first + shift, nums.second + shift};
+  }
+
+  Text::Numbering Text::Numbering::then(const Numbering & outer) const noexcept
+  {
+    return {inverted != outer.inverted, outer.inverted ? outer.shift - shift : shift + outer.shift};
+  }
+
+  Text::Text():
+    storage(std::make_shared< Storage >()),
+    root(noPiece),
+    tail(noPiece)
+  {
+    storage->buffer.push_back(Line());
+    setLineNums(0);
+  }
+
+  Text::Text(const Text & other):
+    Text()
+  {
+    DynamicArray< LineRef > refs = other.getLineRefs(0, other.getLines(other.root));
+    size_t blank = 0;
+    for (size_t i = 0; i < refs.size(); ++i)
+    {
+      if (refs[i].line == 0)
+      {
+        ++blank;
+        continue;
+      }
+      addBlank(blank);
+      blank = 0;
+      addLine();
+      addTokens(other, refs[i], 0);
+    }
+    addBlank(blank);
+    if (other.tail == noPiece)
+    {
+      tail = noPiece;
+    }
+  }
+
+  Text::Text(const std::shared_ptr< Storage > & shared):
+    storage(shared),
+    root(noPiece),
+    tail(noPiece)
+  {}
+
+  Text & Text::operator=(const Text & other)
+  {
+    if (this != std::addressof(other))
+    {
+      *this = Text(other);
+    }
+    return *this;
+  }
+
+  void Text::addLine()
+  {
+    DynamicArray< Line > & buffer = storage->buffer;
+    buffer.push_back(Line());
+    setLineNums(buffer.size() - 1);
+    appendPiece(buffer.size() - 1, 1);
+  }
+
+  void Text::addWord(const std::string & word)
+  {
+    if (tail == noPiece)
+    {
+      addLine();
+    }
+    const Piece & last = storage->pieces[tail];
+    addToken(word, storage->buffer[last.start + last.count - 1].size() + 1);
+  }
+
+  size_t Text::getLineCount() const noexcept
+  {
+    bool isFound = false;
+    return getLines(root) - countTrailingEmpty(root, false, isFound);
+  }
+
+  size_t Text::getWordCount() const
+  {
+    DynamicArray< LineRef > refs = getLineRefs(0, getLineCount());
+    size_t count = 0;
+    for (size_t i = 0; i < refs.size(); ++i)
+    {
+      count += storage->buffer[refs[i].line].size();
+    }
+    return count;
+  }
+
+  HashTable< std::string, Xrefs > Text::getXrefs() const
+  {
+    DynamicArray< LineRef > refs = getLineRefs(0, getLineCount());
+    HashTable< std::string, Xrefs > result;
+    for (size_t i = 0; i < refs.size(); ++i)
+    {
+      const Line & line = storage->buffer[refs[i].line];
+      for (size_t j = 0; j < line.size(); ++j)
+      {
+        const Token & token = line[refs[i].numbering.inverted ? line.size() - j - 1 : j];
+        result[storage->words[token.id]].push_back({i + 1, refs[i].numbering.apply(token.num)});
+      }
+    }
+    return result;
+  }
+
+  std::string Text::getText() const
+  {
+    DynamicArray< LineRef > refs = getLineRefs(0, getLineCount());
+    std::string result;
+    for (size_t i = 0; i < refs.size(); ++i)
+    {
+      const Line & line = storage->buffer[refs[i].line];
+      if (line.empty())
+      {
+        continue;
+      }
+      if (!result.empty())
+      {
+        result += '\n';
+      }
+      for (size_t j = 0; j < line.size(); ++j)
+      {
+        if (j > 0)
+        {
+          result += ' ';
+        }
+        result += storage->words[line[refs[i].numbering.inverted ? line.size() - j - 1 : j].id];
+      }
+    }
+    return result;
+  }
+
+  void Text::insertLines(size_t num, const Text & from, size_t begin, size_t end)
+  {
+    DynamicArray< Line > & buffer = storage->buffer;
+    size_t total = from.getLines(from.root);
+    size_t first = std::min(begin - 1, total);
+    size_t last = std::max(first, std::min(end - 1, total));
+    if (end <= begin)
+    {
+      return;
+    }
+    DynamicArray< LineRef > refs = from.getLineRefs(first, last);
+    DynamicArray< Line > staged;
+    for (size_t i = 0; i < refs.size(); ++i)
+    {
+      const Line & line = from.storage->buffer[refs[i].line];
+      Line copy;
+      for (size_t j = 0; j < line.size(); ++j)
+      {
+        const Token & token = line[refs[i].numbering.inverted ? line.size() - j - 1 : j];
+        copy.push_back({token.id, refs[i].numbering.apply(token.num)});
+      }
+      staged.push_back(copy);
+    }
+    size_t start = buffer.size();
+    for (size_t i = 0; i < staged.size(); ++i)
+    {
+      Line line;
+      for (size_t j = 0; j < staged[i].size(); ++j)
+      {
+        line.push_back({intern(from.storage->words[staged[i][j].id]), staged[i][j].num});
+      }
+      buffer.push_back(line);
+      setLineNums(buffer.size() - 1);
+      for (size_t j = 0; j < line.size(); ++j)
+      {
+        storage->xrefs[storage->words[line[j].id]].push_back({buffer.size() - 1, j});
+      }
+    }
+    size_t piece = staged.empty() ? noPiece : newPiece(start, staged.size());
+    if (staged.size() < end - begin)
+    {
+      piece = merge(piece, newBlank(end - begin - staged.size()));
+    }
+    if (num - 1 > getLines(root))
+    {
+      root = merge(root, newBlank(num - 1 - getLines(root)));
+    }
+    size_t left = noPiece;
+    size_t right = noPiece;
+    split(root, num - 1, left, right);
+    root = merge(merge(left, piece), right);
+    storage->pieces[root].parent = noPiece;
+    tail = noPiece;
+    reclaim();
+  }
+
+  void Text::removeLines(size_t begin, size_t end)
+  {
+    size_t first = std::min(begin - 1, getLines(root));
+    size_t last = std::max(first, std::min(end - 1, getLines(root)));
+    if (first == last)
+    {
+      return;
+    }
+    size_t left = noPiece;
+    size_t rest = noPiece;
+    size_t removed = noPiece;
+    size_t right = noPiece;
+    split(root, first, left, rest);
+    split(rest, last - first, removed, right);
+    storage->pieces[removed].parent = noPiece;
+    root = merge(left, right);
+    if (root != noPiece)
+    {
+      storage->pieces[root].parent = noPiece;
+    }
+    tail = noPiece;
+    reclaim();
+  }
+
+  Text Text::splitLines(size_t num)
+  {
+    size_t first = std::min(num - 1, getLines(root));
+    size_t left = noPiece;
+    size_t right = noPiece;
+    split(root, first, left, right);
+    root = left;
+    if (root != noPiece)
+    {
+      storage->pieces[root].parent = noPiece;
+    }
+    tail = noPiece;
+    Text result(storage);
+    result.addBlank(first);
+    result.root = result.merge(result.root, right);
+    if (result.root != noPiece)
+    {
+      storage->pieces[result.root].parent = noPiece;
+    }
+    return result;
+  }
+
+  void Text::appendByLines(const Text & other)
+  {
+    DynamicArray< LineRef > mine = getLineRefs(0, getLines(root));
+    DynamicArray< LineRef > theirs = other.getLineRefs(0, other.getLines(other.root));
+    size_t shift = getMaxNum();
+    Text result;
+    for (size_t i = 0; i < std::max(mine.size(), theirs.size()); ++i)
+    {
+      result.addLine();
+      if (i < mine.size())
+      {
+        result.addTokens(*this, mine[i], 0);
+      }
+      if (i < theirs.size())
+      {
+        result.addTokens(other, theirs[i], shift);
+      }
+    }
+    *this = std::move(result);
+  }
+
+  void Text::invertLines()
+  {
+    size_t lines = noPiece;
+    size_t trailing = noPiece;
+    split(root, getLineCount(), lines, trailing);
+    if (trailing != noPiece)
+    {
+      storage->pieces[trailing].parent = noPiece;
+    }
+    root = lines;
+    if (root != noPiece)
+    {
+      storage->pieces[root].parent = noPiece;
+    }
+    applyReverse(root);
+    tail = noPiece;
+    reclaim();
+  }
+
+  void Text::invertWords()
+  {
+    applyNumbering(root, {true, getMaxNum() + 1});
+    tail = noPiece;
+  }
+
+  bool Text::replaceWord(const std::string & oldWord, const std::string & newWord)
+  {
+    auto it = storage->xrefs.find(oldWord);
+    if (it == storage->xrefs.end())
+    {
+      return false;
+    }
+    bool isUsed = false;
+    for (size_t i = 0; i < it->second.size() && !isUsed; ++i)
+    {
+      WordPos pos;
+      isUsed = resolve(it->second[i], pos);
+    }
+    if (!isUsed)
+    {
+      return false;
+    }
+    if (oldWord == newWord)
+    {
+      return true;
+    }
+    bool isShared = storage.use_count() > 1;
+    Xrefs moved = std::move(it->second);
+    storage->xrefs.erase(it);
+    if (!isShared && storage->ids.find(newWord) == storage->ids.end())
+    {
+      size_t oldId = storage->ids.at(oldWord);
+      storage->xrefs[newWord] = std::move(moved);
+      storage->ids.erase(oldWord);
+      storage->ids[newWord] = oldId;
+      storage->words[oldId] = newWord;
+      return true;
+    }
+    size_t newId = intern(newWord);
+    Xrefs kept;
+    Xrefs & target = storage->xrefs[newWord];
+    for (size_t i = 0; i < moved.size(); ++i)
+    {
+      WordPos pos;
+      if (!isShared || resolve(moved[i], pos))
+      {
+        storage->buffer[moved[i].first][moved[i].second].id = newId;
+        target.push_back(moved[i]);
+      }
+      else
+      {
+        kept.push_back(moved[i]);
+      }
+    }
+    if (!kept.empty())
+    {
+      storage->xrefs[oldWord] = std::move(kept);
+    }
+    return true;
+  }
+
+  size_t Text::intern(const std::string & word)
+  {
+    auto it = storage->ids.find(word);
+    if (it != storage->ids.end())
+    {
+      return it->second;
+    }
+    size_t id = storage->words.size();
+    storage->words.push_back(word);
+    storage->ids[word] = id;
+    return id;
+  }
+
+  void Text::addToken(const std::string & word, size_t num)
+  {
+    DynamicArray< Line > & buffer = storage->buffer;
+    if (tail == noPiece)
+    {
+      addLine();
+    }
+    size_t id = intern(word);
+    size_t line = storage->pieces[tail].start + storage->pieces[tail].count - 1;
+    buffer[line].push_back({id, num});
+    storage->xrefs[word].push_back({line, buffer[line].size() - 1});
+    setLineNums(line);
+    storage->pieces[tail].own = combine(storage->pieces[tail].own, {num, num});
+    refresh(tail);
+  }
+
+  void Text::addTokens(const Text & from, const LineRef & ref, size_t shift)
+  {
+    const Line & line = from.storage->buffer[ref.line];
+    for (size_t j = 0; j < line.size(); ++j)
+    {
+      const Token & token = line[ref.numbering.inverted ? line.size() - j - 1 : j];
+      addToken(from.storage->words[token.id], ref.numbering.apply(token.num) + shift);
+    }
+  }
+
+  void Text::addBlank(size_t count)
+  {
+    if (count != 0)
+    {
+      root = merge(root, newBlank(count));
+      storage->pieces[root].parent = noPiece;
+      tail = noPiece;
+    }
+  }
+
+  void Text::reclaim()
+  {
+    size_t live = 2 * getLines(root) + 64;
+    if (storage->buffer.size() > live || storage->pieces.size() > live)
+    {
+      *this = Text(*this);
+    }
+  }
+
+  void Text::appendPiece(size_t start, size_t count)
+  {
+    DynamicArray< Piece > & pieces = storage->pieces;
+    if (tail != noPiece && pieces[tail].start + pieces[tail].count == start)
+    {
+      pieces[tail].count += count;
+      pieces[tail].own = combine(pieces[tail].own, getLineNums(start, start + count));
+      refresh(tail);
+      return;
+    }
+    tail = newPiece(start, count);
+    root = merge(root, tail);
+    pieces[root].parent = noPiece;
+  }
+
+  size_t Text::newPiece(size_t start, size_t count)
+  {
+    DynamicArray< Piece > & pieces = storage->pieces;
+    Bounds own = getLineNums(start, start + count);
+    Piece piece{start, count, count, own, own, storage->random(), noPiece, noPiece, noPiece, {false, 0}, {false, 0},
+      false, false, false};
+    pieces.push_back(piece);
+    storage->owners[start] = pieces.size() - 1;
+    return pieces.size() - 1;
+  }
+
+  size_t Text::newBlank(size_t count)
+  {
+    Piece piece{0, count, count, noNums, noNums, storage->random(), noPiece, noPiece, noPiece, {false, 0}, {false, 0},
+      true, false, false};
+    storage->pieces.push_back(piece);
+    return storage->pieces.size() - 1;
+  }
+
+  void Text::setLineNums(size_t line)
+  {
+    DynamicArray< Line > & buffer = storage->buffer;
+    if (line >= storage->lineNumsSize)
+    {
+      size_t size = std::max< size_t >(storage->lineNumsSize, 1);
+      while (size <= line)
+      {
+        size *= 2;
+      }
+      DynamicArray< Bounds > tree;
+      for (size_t i = 0; i < 2 * size; ++i)
+      {
+        tree.push_back(noNums);
+      }
+      for (size_t i = 0; i < buffer.size(); ++i)
+      {
+        if (!buffer[i].empty())
+        {
+          tree[size + i] = {buffer[i][0].num, buffer[i][buffer[i].size() - 1].num};
+        }
+      }
+      for (size_t i = size - 1; i > 0; --i)
+      {
+        tree[i] = combine(tree[2 * i], tree[2 * i + 1]);
+      }
+      storage->lineNums = std::move(tree);
+      storage->lineNumsSize = size;
+      return;
+    }
+    const Line & curr = buffer[line];
+    size_t node = storage->lineNumsSize + line;
+    storage->lineNums[node] = curr.empty() ? noNums : Bounds{curr[0].num, curr[curr.size() - 1].num};
+    for (node /= 2; node > 0; node /= 2)
+    {
+      storage->lineNums[node] = combine(storage->lineNums[2 * node], storage->lineNums[2 * node + 1]);
+    }
+  }
+
+  Text::Bounds Text::getLineNums(size_t first, size_t last) const
+  {
+    Bounds result = noNums;
+    for (first += storage->lineNumsSize, last += storage->lineNumsSize; first < last; first /= 2, last /= 2)
+    {
+      if (first % 2 == 1)
+      {
+        result = combine(result, storage->lineNums[first++]);
+      }
+      if (last % 2 == 1)
+      {
+        result = combine(result, storage->lineNums[--last]);
+      }
+    }
+    return result;
+  }
+
+  size_t Text::getMaxNum() const noexcept
+  {
+    Bounds nums = getNums(root);
+    return nums.first > nums.second ? 1 : std::max< size_t >(nums.second, 1);
+  }
+
+  size_t Text::countTrailingEmpty(size_t piece, bool reverse, bool & isFound) const noexcept
+  {
+    if (piece == noPiece || isFound)
+    {
+      return 0;
+    }
+    const Piece & curr = storage->pieces[piece];
+    bool childReverse = reverse != curr.pendingReverse;
+    size_t count = countTrailingEmpty(reverse ? curr.left : curr.right, childReverse, isFound);
+    bool reversed = curr.reversed != reverse;
+    for (size_t i = curr.count; i > 0 && !isFound; --i)
+    {
+      isFound = !curr.blank && !storage->buffer[reversed ? curr.start + curr.count - i : curr.start + i - 1].empty();
+      count += isFound ? 0 : 1;
+    }
+    return count + countTrailingEmpty(reverse ? curr.right : curr.left, childReverse, isFound);
+  }
+
+  size_t Text::getLines(size_t piece) const noexcept
+  {
+    return piece == noPiece ? 0 : storage->pieces[piece].lines;
+  }
+
+  Text::Bounds Text::getNums(size_t piece) const noexcept
+  {
+    return piece == noPiece ? noNums : storage->pieces[piece].nums;
+  }
+
+  void Text::update(size_t piece) noexcept
+  {
+    DynamicArray< Piece > & pieces = storage->pieces;
+    Piece & curr = pieces[piece];
+    curr.lines = getLines(curr.left) + curr.count + getLines(curr.right);
+    curr.nums = combine(combine(getNums(curr.left), curr.numbering.apply(curr.own)), getNums(curr.right));
+    if (curr.left != noPiece)
+    {
+      pieces[curr.left].parent = piece;
+    }
+    if (curr.right != noPiece)
+    {
+      pieces[curr.right].parent = piece;
+    }
+  }
+
+  void Text::applyReverse(size_t piece) noexcept
+  {
+    if (piece != noPiece)
+    {
+      Piece & curr = storage->pieces[piece];
+      std::swap(curr.left, curr.right);
+      curr.reversed = !curr.reversed;
+      curr.pendingReverse = !curr.pendingReverse;
+    }
+  }
+
+  void Text::refresh(size_t piece) noexcept
+  {
+    DynamicArray< size_t > path;
+    for (size_t curr = piece; curr != noPiece; curr = storage->pieces[curr].parent)
+    {
+      path.push_back(curr);
+    }
+    for (size_t i = path.size(); i > 0; --i)
+    {
+      push(path[i - 1]);
+    }
+    for (size_t i = 0; i < path.size(); ++i)
+    {
+      update(path[i]);
+    }
+  }
+
+  void Text::applyNumbering(size_t piece, const Numbering & numbering) noexcept
+  {
+    if (piece != noPiece)
+    {
+      Piece & curr = storage->pieces[piece];
+      curr.numbering = curr.numbering.then(numbering);
+      curr.pendingNumbering = curr.pendingNumbering.then(numbering);
+      curr.nums = numbering.apply(curr.nums);
+    }
+  }
+
+  void Text::push(size_t piece) noexcept
+  {
+    DynamicArray< Piece > & pieces = storage->pieces;
+    if (pieces[piece].pendingReverse)
+    {
+      applyReverse(pieces[piece].left);
+      applyReverse(pieces[piece].right);
+      pieces[piece].pendingReverse = false;
+    }
+    Numbering pending = pieces[piece].pendingNumbering;
+    if (pending.inverted || pending.shift != 0)
+    {
+      applyNumbering(pieces[piece].left, pending);
+      applyNumbering(pieces[piece].right, pending);
+      pieces[piece].pendingNumbering = {false, 0};
+    }
+  }
+
+  void Text::split(size_t piece, size_t count, size_t & left, size_t & right)
+  {
+    DynamicArray< Piece > & pieces = storage->pieces;
+    if (piece == noPiece)
+    {
+      left = noPiece;
+      right = noPiece;
+      return;
+    }
+    push(piece);
+    size_t before = getLines(pieces[piece].left);
+    size_t own = pieces[piece].count;
+    if (count <= before)
+    {
+      size_t rest = noPiece;
+      split(pieces[piece].left, count, left, rest);
+      pieces[piece].left = rest;
+      update(piece);
+      right = piece;
+    }
+    else if (count >= before + own)
+    {
+      size_t rest = noPiece;
+      split(pieces[piece].right, count - before - own, rest, right);
+      pieces[piece].right = rest;
+      update(piece);
+      left = piece;
+    }
+    else if (!pieces[piece].reversed)
+    {
+      size_t cut = count - before;
+      size_t tailPart = pieces[piece].blank ? newBlank(own - cut) : newPiece(pieces[piece].start + cut, own - cut);
+      pieces[tailPart].numbering = pieces[piece].numbering;
+      update(tailPart);
+      pieces[piece].count = cut;
+      pieces[piece].own = pieces[piece].blank ? noNums : getLineNums(pieces[piece].start, pieces[piece].start + cut);
+      size_t rest = pieces[piece].right;
+      pieces[piece].right = noPiece;
+      update(piece);
+      left = piece;
+      right = merge(tailPart, rest);
+    }
+    else
+    {
+      size_t cut = count - before;
+      size_t headPart = pieces[piece].blank ? newBlank(cut) : newPiece(pieces[piece].start + own - cut, cut);
+      pieces[headPart].reversed = true;
+      pieces[headPart].numbering = pieces[piece].numbering;
+      update(headPart);
+      pieces[piece].count = own - cut;
+      size_t start = pieces[piece].start;
+      pieces[piece].own = pieces[piece].blank ? noNums : getLineNums(start, start + own - cut);
+      size_t rest = pieces[piece].left;
+      pieces[piece].left = noPiece;
+      update(piece);
+      left = merge(rest, headPart);
+      right = piece;
+    }
+  }
+
+  size_t Text::merge(size_t left, size_t right)
+  {
+    DynamicArray< Piece > & pieces = storage->pieces;
+    if (left == noPiece)
+    {
+      return right;
+    }
+    if (right == noPiece)
+    {
+      return left;
+    }
+    if (pieces[left].priority > pieces[right].priority)
+    {
+      push(left);
+      size_t merged = merge(pieces[left].right, right);
+      pieces[left].right = merged;
+      update(left);
+      return left;
+    }
+    push(right);
+    size_t merged = merge(left, pieces[right].left);
+    pieces[right].left = merged;
+    update(right);
+    return right;
+  }
+
+  DynamicArray< Text::LineRef > Text::getLineRefs(size_t first, size_t last) const
+  {
+    DynamicArray< LineRef > refs;
+    size_t pos = 0;
+    collectLines(root, false, {false, 0}, pos, first, last, refs);
+    return refs;
+  }
+
+  void Text::collectLines(size_t piece, bool reverse, const Numbering & numbering, size_t & pos, size_t first,
+    size_t last, DynamicArray< LineRef > & refs) const
+  {
+    if (piece == noPiece || pos >= last)
+    {
+      return;
+    }
+    const Piece & curr = storage->pieces[piece];
+    if (pos + curr.lines <= first)
+    {
+      pos += curr.lines;
+      return;
+    }
+    bool childReverse = reverse != curr.pendingReverse;
+    Numbering childNumbering = curr.pendingNumbering.then(numbering);
+    collectLines(reverse ? curr.right : curr.left, childReverse, childNumbering, pos, first, last, refs);
+    bool reversed = curr.reversed != reverse;
+    Numbering own = curr.numbering.then(numbering);
+    size_t from = first > pos ? first - pos : 0;
+    size_t to = last > pos ? std::min(curr.count, last - pos) : 0;
+    for (size_t i = from; i < to; ++i)
+    {
+      refs.push_back({curr.blank ? 0 : reversed ? curr.start + curr.count - i - 1 : curr.start + i, own});
+    }
+    pos += curr.count;
+    collectLines(reverse ? curr.left : curr.right, childReverse, childNumbering, pos, first, last, refs);
+  }
+
+  bool Text::resolve(const WordPos & entry, WordPos & pos) const
+  {
+    const DynamicArray< Piece > & pieces = storage->pieces;
+    auto owner = storage->owners.lower_bound(entry.first);
+    if (owner == storage->owners.end())
+    {
+      return false;
+    }
+    size_t piece = owner->second;
+    DynamicArray< size_t > path;
+    for (size_t curr = piece; curr != noPiece; curr = pieces[curr].parent)
+    {
+      path.push_back(curr);
+    }
+    if (path[path.size() - 1] != root)
+    {
+      return false;
+    }
+    bool reverse = false;
+    Numbering numbering{false, 0};
+    size_t line = 0;
+    for (size_t i = path.size() - 1; i > 0; --i)
+    {
+      const Piece & curr = pieces[path[i]];
+      size_t left = reverse ? curr.right : curr.left;
+      if (path[i - 1] != left)
+      {
+        line += getLines(left) + curr.count;
+      }
+      reverse = reverse != curr.pendingReverse;
+      numbering = curr.pendingNumbering.then(numbering);
+    }
+    const Piece & curr = pieces[piece];
+    line += getLines(reverse ? curr.right : curr.left);
+    size_t offset = entry.first - curr.start;
+    line += (curr.reversed != reverse ? curr.count - offset - 1 : offset) + 1;
+    pos = {line, curr.numbering.then(numbering).apply(storage->buffer[entry.first][entry.second].num)};
+    return true;
+  }
+}
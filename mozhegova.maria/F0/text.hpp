@@ -0,0 +1,120 @@
+#ifndef TEXT_HPP
+#define TEXT_HPP
+
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <hashTable.hpp>
+#include <dynamicArray.hpp>
+#include <tree.hpp>
+
+namespace mozhegova
+{
+  using WordPos = std::pair< size_t, size_t >;
+  using Xrefs = DynamicArray< WordPos >;
+
+  class Text
+  {
+  public:
+    Text();
+    Text(const Text & other);
+    Text(Text && other) noexcept = default;
+    Text & operator=(const Text & other);
+    Text & operator=(Text && other) noexcept = default;
+    void addLine();
+    void addWord(const std::string & word);
+    size_t getLineCount() const noexcept;
+    size_t getWordCount() const;
+    HashTable< std::string, Xrefs > getXrefs() const;
+    std::string getText() const;
+    void insertLines(size_t num, const Text & from, size_t begin, size_t end);
+    void removeLines(size_t begin, size_t end);
+    Text splitLines(size_t num);
+    void appendByLines(const Text & other);
+    void invertLines();
+    void invertWords();
+    bool replaceWord(const std::string & oldWord, const std::string & newWord);
+  private:
+    using Bounds = std::pair< size_t, size_t >;
+    struct Token
+    {
+      size_t id;
+      size_t num;
+    };
+    struct Numbering
+    {
+      bool inverted;
+      size_t shift;
+      size_t apply(size_t num) const noexcept;
+      Bounds apply(const Bounds & nums) const noexcept;
+      Numbering then(const Numbering & outer) const noexcept;
+    };
+    using Line = DynamicArray< Token >;
+    struct LineRef
+    {
+      size_t line;
+      Numbering numbering;
+    };
+    struct Piece
+    {
+      size_t start;
+      size_t count;
+      size_t lines;
+      Bounds own;
+      Bounds nums;
+      size_t priority;
+      size_t left;
+      size_t right;
+      size_t parent;
+      Numbering numbering;
+      Numbering pendingNumbering;
+      bool blank;
+      bool reversed;
+      bool pendingReverse;
+    };
+    struct Storage
+    {
+      DynamicArray< std::string > words;
+      HashTable< std::string, size_t > ids;
+      DynamicArray< Line > buffer;
+      DynamicArray< Bounds > lineNums;
+      size_t lineNumsSize = 0;
+      HashTable< std::string, Xrefs > xrefs;
+      DynamicArray< Piece > pieces;
+      BiTree< size_t, size_t, std::greater< size_t > > owners;
+      std::minstd_rand random;
+    };
+    std::shared_ptr< Storage > storage;
+    size_t root;
+    size_t tail;
+    explicit Text(const std::shared_ptr< Storage > & shared);
+    size_t intern(const std::string & word);
+    void addToken(const std::string & word, size_t num);
+    void addTokens(const Text & from, const LineRef & ref, size_t shift);
+    void appendPiece(size_t start, size_t count);
+    size_t newPiece(size_t start, size_t count);
+    size_t newBlank(size_t count);
+    void addBlank(size_t count);
+    void reclaim();
+    void setLineNums(size_t line);
+    Bounds getLineNums(size_t first, size_t last) const;
+    size_t getMaxNum() const noexcept;
+    size_t countTrailingEmpty(size_t piece, bool reverse, bool & isFound) const noexcept;
+    size_t getLines(size_t piece) const noexcept;
+    Bounds getNums(size_t piece) const noexcept;
+    void update(size_t piece) noexcept;
+    void refresh(size_t piece) noexcept;
+    void applyReverse(size_t piece) noexcept;
+    void applyNumbering(size_t piece, const Numbering & numbering) noexcept;
+    void push(size_t piece) noexcept;
+    void split(size_t piece, size_t count, size_t & left, size_t & right);
+    size_t merge(size_t left, size_t right);
+    DynamicArray< LineRef > getLineRefs(size_t first, size_t last) const;
+    void collectLines(size_t piece, bool reverse, const Numbering & numbering, size_t & pos, size_t first, size_t last,
+      DynamicArray< LineRef > & refs) const;
+    bool resolve(const WordPos & entry, WordPos & pos) const;
+  };
+}
+
+#endif
@@ -226,7 +226,7 @@ namespace mozhegova
     {
       return 0.0;
     }
-    return size_ / table_.size();
+    return static_cast< float >(size_) / table_.size();
   }
 
   template< class Key, class Value, class Hash, class Equal >
@@ -354,7 +354,7 @@ namespace mozhegova
   template< class... Args >
   std::pair< HashIter< Key, Value, Hash, Equal >, bool > HashTable< Key, Value, Hash, Equal >::emplace(Args &&... args)
   {
-    if ((size_ + 1) / table_.size() > max_load_factor_)
+    if (static_cast< float >(size_ + 1) / table_.size() > max_load_factor_)
     {
       rehash(table_.size() * 2);
     }
@@ -375,11 +375,20 @@ namespace mozhegova
       }
       currSlot = (homeSlot + i * i) % table_.size();
       ++i;
+      if (i >= table_.size())
+      {
+        break;
+      }
     }
     if (firstDeleted != table_.size())
     {
       currSlot = firstDeleted;
     }
+    else if (table_[currSlot].occupied || table_[currSlot].deleted)
+    {
+      rehash(table_.size() * 2);
+      return emplace(std::move(pair));
+    }
     table_[currSlot].data = std::move(pair);
     table_[currSlot].occupied = true;
     table_[currSlot].deleted = false;
@@ -0,0 +1,583 @@
+#ifndef INTRUSIVE_RING_LIST_HPP
+#define INTRUSIVE_RING_LIST_HPP
+
+#include <memory>
+#include <cstddef>
+#include <cassert>
+#include <iterator>
+
+namespace petrov
+{
+  template< typename Tag = void >
+  struct RingHook
+  {
+    RingHook() noexcept;
+    RingHook(const RingHook< Tag > & rhs) noexcept;
+    ~RingHook();
+    RingHook< Tag > & operator=(const RingHook< Tag > & rhs) noexcept;
+    bool is_linked() const noexcept;
+  private:
+    template< typename T, typename Tag1 >
+    friend struct IntrusiveRingList;
+    template< typename T, typename Tag1 >
+    friend struct ConstIntrusiveRingIterator;
+    template< typename T, typename Tag1 >
+    friend struct IntrusiveRingIterator;
+    RingHook< Tag > * next_;
+    RingHook< Tag > * prev_;
+  };
+
+  template< typename T, typename Tag = void >
+  struct IntrusiveRingList;
+
+  template< typename T, typename Tag = void >
+  struct IntrusiveRingIterator;
+
+  template< typename T, typename Tag = void >
+  struct ConstIntrusiveRingIterator: std::iterator< std::bidirectional_iterator_tag, T >
+  {
+    friend struct IntrusiveRingList< T, Tag >;
+    friend struct IntrusiveRingIterator< T, Tag >;
+  public:
+    using hook_t = RingHook< Tag >;
+    using this_t = ConstIntrusiveRingIterator< T, Tag >;
+    ConstIntrusiveRingIterator();
+    ConstIntrusiveRingIterator(const this_t & rhs) = default;
+    ~ConstIntrusiveRingIterator() = default;
+    this_t & operator=(const this_t & rhs) = default;
+    this_t & operator++();
+    this_t operator++(int);
+    this_t & operator--();
+    this_t operator--(int);
+    const T & operator*() const;
+    const T * operator->() const;
+    bool operator==(const this_t & rhs) const;
+    bool operator!=(const this_t & rhs) const;
+  private:
+    const hook_t * hook_;
+    explicit ConstIntrusiveRingIterator(const hook_t * hook);
+  };
+
+  template< typename T, typename Tag >
+  struct IntrusiveRingIterator: std::iterator< std::bidirectional_iterator_tag, T >
+  {
+    friend struct IntrusiveRingList< T, Tag >;
+  public:
+    using hook_t = RingHook< Tag >;
+    using this_t = IntrusiveRingIterator< T, Tag >;
+    IntrusiveRingIterator();
+    IntrusiveRingIterator(const this_t & rhs) = default;
+    ~IntrusiveRingIterator() = default;
+    this_t & operator=(const this_t & rhs) = default;
+    operator ConstIntrusiveRingIterator< T, Tag >() const;
+    this_t & operator++();
+    this_t operator++(int);
+    this_t & operator--();
+    this_t operator--(int);
+    T & operator*();
+    T * operator->();
+    bool operator==(const this_t & rhs) const;
+    bool operator!=(const this_t & rhs) const;
+  private:
+    hook_t * hook_;
+    explicit IntrusiveRingIterator(hook_t * hook);
+  };
+
+  template< typename T, typename Tag >
+  struct IntrusiveRingList
+  {
+    using this_t = IntrusiveRingList< T, Tag >;
+    using hook_t = RingHook< Tag >;
+    using const_it_t = ConstIntrusiveRingIterator< T, Tag >;
+    using it_t = IntrusiveRingIterator< T, Tag >;
+
+    IntrusiveRingList() noexcept;
+    IntrusiveRingList(const this_t & rhs) = delete;
+    IntrusiveRingList(this_t && rhs) noexcept;
+    ~IntrusiveRingList();
+
+    this_t & operator=(const this_t & rhs) = delete;
+    this_t & operator=(this_t && rhs) noexcept;
+
+    const_it_t cbegin() const;
+    const_it_t cend() const;
+    it_t begin();
+    it_t end();
+
+    T & front();
+    const T & front() const;
+    T & back();
+    const T & back() const;
+
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+
+    void push_front(T & val) noexcept;
+    void push_back(T & val) noexcept;
+    it_t insert(const_it_t pos, T & val) noexcept;
+    it_t insert_after(const_it_t pos, T & val) noexcept;
+
+    void pop_front() noexcept;
+    void pop_back() noexcept;
+    it_t erase(const_it_t pos) noexcept;
+    void remove(T & val) noexcept;
+    void clear() noexcept;
+
+    void rotate() noexcept;
+    void swap(this_t & rhs) noexcept;
+
+    static it_t iterator_to(T & val) noexcept;
+    static const_it_t iterator_to(const T & val) noexcept;
+
+  private:
+    hook_t root_;
+    size_t size_;
+
+    void link_before(hook_t * pos, hook_t * hook) noexcept;
+    void unlink(hook_t * hook) noexcept;
+    void adopt(this_t & rhs) noexcept;
+    static T & value(hook_t * hook) noexcept;
+    static const T & value(const hook_t * hook) noexcept;
+  };
+
+  template< typename Tag >
+  RingHook< Tag >::RingHook() noexcept:
+    next_(nullptr),
+    prev_(nullptr)
+  {}
+
+  template< typename Tag >
+  RingHook< Tag >::RingHook(const RingHook< Tag > &) noexcept:
+    RingHook()
+  {}
+
+  template< typename Tag >
+  RingHook< Tag >::~RingHook()
+  {
+    assert(!is_linked() && "object destroyed while still linked into a ring");
+  }
+
+  template< typename Tag >
+  RingHook< Tag > & RingHook< Tag >::operator=(const RingHook< Tag > &) noexcept
+  {
+    return *this;
+  }
+
+  template< typename Tag >
+  bool RingHook< Tag >::is_linked() const noexcept
+  {
+    return next_ != nullptr;
+  }
+
+  template< typename T, typename Tag >
+  ConstIntrusiveRingIterator< T, Tag >::ConstIntrusiveRingIterator():
+    hook_(nullptr)
+  {}
+
+  template< typename T, typename Tag >
+  typename ConstIntrusiveRingIterator< T, Tag >::this_t & ConstIntrusiveRingIterator< T, Tag >::operator++()
+  {
+    assert(hook_ != nullptr);
+    hook_ = hook_->next_;
+    return *this;
+  }
+
+  template< typename T, typename Tag >
+  typename ConstIntrusiveRingIterator< T, Tag >::this_t ConstIntrusiveRingIterator< T, Tag >::operator++(int)
+  {
+    assert(hook_ != nullptr);
+    this_t result(*this);
+    ++(*this);
+    return result;
+  }
+
+  template< typename T, typename Tag >
+  typename ConstIntrusiveRingIterator< T, Tag >::this_t & ConstIntrusiveRingIterator< T, Tag >::operator--()
+  {
+    assert(hook_ != nullptr);
+    hook_ = hook_->prev_;
+    return *this;
+  }
+
+  template< typename T, typename Tag >
+  typename ConstIntrusiveRingIterator< T, Tag >::this_t ConstIntrusiveRingIterator< T, Tag >::operator--(int)
+  {
+    assert(hook_ != nullptr);
+    this_t result(*this);
+    --(*this);
+    return result;
+  }
+
+  template< typename T, typename Tag >
+  const T & ConstIntrusiveRingIterator< T, Tag >::operator*() const
+  {
+    assert(hook_ != nullptr);
+    return static_cast< const T & >(*hook_);
+  }
+
+  template< typename T, typename Tag >
+  const T * ConstIntrusiveRingIterator< T, Tag >::operator->() const
+  {
+    assert(hook_ != nullptr);
+    return std::addressof(static_cast< const T & >(*hook_));
+  }
+
+  template< typename T, typename Tag >
+  bool ConstIntrusiveRingIterator< T, Tag >::operator==(const this_t & rhs) const
+  {
+    return hook_ == rhs.hook_;
+  }
+
+  template< typename T, typename Tag >
+  bool ConstIntrusiveRingIterator< T, Tag >::operator!=(const this_t & rhs) const
+  {
+    return !(rhs == *this);
+  }
+
+  template< typename T, typename Tag >
+  ConstIntrusiveRingIterator< T, Tag >::ConstIntrusiveRingIterator(const hook_t * hook):
+    hook_(hook)
+  {}
+
+  template< typename T, typename Tag >
+  IntrusiveRingIterator< T, Tag >::IntrusiveRingIterator():
+    hook_(nullptr)
+  {}
+
+  template< typename T, typename Tag >
+  IntrusiveRingIterator< T, Tag >::operator ConstIntrusiveRingIterator< T, Tag >() const
+  {
+    return ConstIntrusiveRingIterator< T, Tag >(hook_);
+  }
+
+  template< typename T, typename Tag >
+  typename IntrusiveRingIterator< T, Tag >::this_t & IntrusiveRingIterator< T, Tag >::operator++()
+  {
+    assert(hook_ != nullptr);
+    hook_ = hook_->next_;
+    return *this;
+  }
+
+  template< typename T, typename Tag >
+  typename IntrusiveRingIterator< T, Tag >::this_t IntrusiveRingIterator< T, Tag >::operator++(int)
+  {
+    assert(hook_ != nullptr);
+    this_t result(*this);
+    ++(*this);
+    return result;
+  }
+
+  template< typename T, typename Tag >
+  typename IntrusiveRingIterator< T, Tag >::this_t & IntrusiveRingIterator< T, Tag >::operator--()
+  {
+    assert(hook_ != nullptr);
+    hook_ = hook_->prev_;
+    return *this;
+  }
+
+  template< typename T, typename Tag >
+  typename IntrusiveRingIterator< T, Tag >::this_t IntrusiveRingIterator< T, Tag >::operator--(int)
+  {
+    assert(hook_ != nullptr);
+    this_t result(*this);
+    --(*this);
+    return result;
+  }
+
+  template< typename T, typename Tag >
+  T & IntrusiveRingIterator< T, Tag >::operator*()
+  {
+    assert(hook_ != nullptr);
+    return static_cast< T & >(*hook_);
+  }
+
+  template< typename T, typename Tag >
+  T * IntrusiveRingIterator< T, Tag >::operator->()
+  {
+    assert(hook_ != nullptr);
+    return std::addressof(static_cast< T & >(*hook_));
+  }
+
+  template< typename T, typename Tag >
+  bool IntrusiveRingIterator< T, Tag >::operator==(const this_t & rhs) const
+  {
+    return hook_ == rhs.hook_;
+  }
+
+  template< typename T, typename Tag >
+  bool IntrusiveRingIterator< T, Tag >::operator!=(const this_t & rhs) const
+  {
+    return !(rhs == *this);
+  }
+
+  template< typename T, typename Tag >
+  IntrusiveRingIterator< T, Tag >::IntrusiveRingIterator(hook_t * hook):
+    hook_(hook)
+  {}
+
+  template< typename T, typename Tag >
+  IntrusiveRingList< T, Tag >::IntrusiveRingList() noexcept:
+    root_(),
+    size_(0)
+  {
+    root_.next_ = std::addressof(root_);
+    root_.prev_ = std::addressof(root_);
+  }
+
+  template< typename T, typename Tag >
+  IntrusiveRingList< T, Tag >::IntrusiveRingList(this_t && rhs) noexcept:
+    IntrusiveRingList()
+  {
+    adopt(rhs);
+  }
+
+  template< typename T, typename Tag >
+  IntrusiveRingList< T, Tag >::~IntrusiveRingList()
+  {
+    clear();
+    root_.next_ = nullptr;
+    root_.prev_ = nullptr;
+  }
+
+  template< typename T, typename Tag >
+  typename IntrusiveRingList< T, Tag >::this_t & IntrusiveRingList< T, Tag >::operator=(this_t && rhs) noexcept
+  {
+    if (this != std::addressof(rhs))
+    {
+      clear();
+      adopt(rhs);
+    }
+    return *this;
+  }
+
+  template< typename T, typename Tag >
+  typename IntrusiveRingList< T, Tag >::const_it_t IntrusiveRingList< T, Tag >::cbegin() const
+  {
+    return const_it_t(root_.next_);
+  }
+
+  template< typename T, typename Tag >
+  typename IntrusiveRingList< T, Tag >::const_it_t IntrusiveRingList< T, Tag >::cend() const
+  {
+    return const_it_t(std::addressof(root_));
+  }
+
+  template< typename T, typename Tag >
+  typename IntrusiveRingList< T, Tag >::it_t IntrusiveRingList< T, Tag >::begin()
+  {
+    return it_t(root_.next_);
+  }
+
+  template< typename T, typename Tag >
+  typename IntrusiveRingList< T, Tag >::it_t IntrusiveRingList< T, Tag >::end()
+  {
+    return it_t(std::addressof(root_));
+  }
+
+  template< typename T, typename Tag >
+  T & IntrusiveRingList< T, Tag >::front()
+  {
+    assert(!empty());
+    return value(root_.next_);
+  }
+
+  template< typename T, typename Tag >
+  const T & IntrusiveRingList< T, Tag >::front() const
+  {
+    assert(!empty());
+    return value(root_.next_);
+  }
+
+  template< typename T, typename Tag >
+  T & IntrusiveRingList< T, Tag >::back()
+  {
+    assert(!empty());
+    return value(root_.prev_);
+  }
+
+  template< typename T, typename Tag >
+  const T & IntrusiveRingList< T, Tag >::back() const
+  {
+    assert(!empty());
+    return value(root_.prev_);
+  }
+
+  template< typename T, typename Tag >
+  bool IntrusiveRingList< T, Tag >::empty() const noexcept
+  {
+    return !size_;
+  }
+
+  template< typename T, typename Tag >
+  size_t IntrusiveRingList< T, Tag >::size() const noexcept
+  {
+    return size_;
+  }
+
+  template< typename T, typename Tag >
+  void IntrusiveRingList< T, Tag >::push_front(T & val) noexcept
+  {
+    link_before(root_.next_, std::addressof(static_cast< hook_t & >(val)));
+  }
+
+  template< typename T, typename Tag >
+  void IntrusiveRingList< T, Tag >::push_back(T & val) noexcept
+  {
+    link_before(std::addressof(root_), std::addressof(static_cast< hook_t & >(val)));
+  }
+
+  template< typename T, typename Tag >
+  typename IntrusiveRingList< T, Tag >::it_t IntrusiveRingList< T, Tag >::insert(const_it_t pos, T & val) noexcept
+  {
+    hook_t * hook = std::addressof(static_cast< hook_t & >(val));
+    link_before(const_cast< hook_t * >(pos.hook_), hook);
+    return it_t(hook);
+  }
+
+  template< typename T, typename Tag >
+  typename IntrusiveRingList< T, Tag >::it_t IntrusiveRingList< T, Tag >::insert_after(const_it_t pos, T & val) noexcept
+  {
+    hook_t * hook = std::addressof(static_cast< hook_t & >(val));
+    link_before(pos.hook_->next_, hook);
+    return it_t(hook);
+  }
+
+  template< typename T, typename Tag >
+  void IntrusiveRingList< T, Tag >::pop_front() noexcept
+  {
+    if (!empty())
+    {
+      unlink(root_.next_);
+    }
+  }
+
+  template< typename T, typename Tag >
+  void IntrusiveRingList< T, Tag >::pop_back() noexcept
+  {
+    if (!empty())
+    {
+      unlink(root_.prev_);
+    }
+  }
+
+  template< typename T, typename Tag >
+  typename IntrusiveRingList< T, Tag >::it_t IntrusiveRingList< T, Tag >::erase(const_it_t pos) noexcept
+  {
+    hook_t * hook = const_cast< hook_t * >(pos.hook_);
+    assert(hook != std::addressof(root_));
+    hook_t * next = hook->next_;
+    unlink(hook);
+    return it_t(next);
+  }
+
+  template< typename T, typename Tag >
+  void IntrusiveRingList< T, Tag >::remove(T & val) noexcept
+  {
+    unlink(std::addressof(static_cast< hook_t & >(val)));
+  }
+
+  template< typename T, typename Tag >
+  void IntrusiveRingList< T, Tag >::clear() noexcept
+  {
+    hook_t * hook = root_.next_;
+    while (hook != std::addressof(root_))
+    {
+      hook_t * next = hook->next_;
+      hook->next_ = nullptr;
+      hook->prev_ = nullptr;
+      hook = next;
+    }
+    root_.next_ = std::addressof(root_);
+    root_.prev_ = std::addressof(root_);
+    size_ = 0;
+  }
+
+  template< typename T, typename Tag >
+  void IntrusiveRingList< T, Tag >::rotate() noexcept
+  {
+    if (size_ > 1)
+    {
+      hook_t * first = root_.next_;
+      root_.prev_->next_ = first;
+      first->prev_ = root_.prev_;
+      root_.next_ = first->next_;
+      first->next_->prev_ = std::addressof(root_);
+      first->next_ = std::addressof(root_);
+      root_.prev_ = first;
+    }
+  }
+
+  template< typename T, typename Tag >
+  void IntrusiveRingList< T, Tag >::swap(this_t & rhs) noexcept
+  {
+    this_t temp(std::move(rhs));
+    rhs.adopt(*this);
+    adopt(temp);
+  }
+
+  template< typename T, typename Tag >
+  typename IntrusiveRingList< T, Tag >::it_t IntrusiveRingList< T, Tag >::iterator_to(T & val) noexcept
+  {
+    return it_t(std::addressof(static_cast< hook_t & >(val)));
+  }
+
+  template< typename T, typename Tag >
+  typename IntrusiveRingList< T, Tag >::const_it_t IntrusiveRingList< T, Tag >::iterator_to(const T & val) noexcept
+  {
+    return const_it_t(std::addressof(static_cast< const hook_t & >(val)));
+  }
+
+  template< typename T, typename Tag >
+  void IntrusiveRingList< T, Tag >::link_before(hook_t * pos, hook_t * hook) noexcept
+  {
+    assert(!hook->is_linked() && "object is already linked into a ring with this tag");
+    hook->next_ = pos;
+    hook->prev_ = pos->prev_;
+    pos->prev_->next_ = hook;
+    pos->prev_ = hook;
+    size_++;
+  }
+
+  template< typename T, typename Tag >
+  void IntrusiveRingList< T, Tag >::unlink(hook_t * hook) noexcept
+  {
+    assert(hook->is_linked());
+    hook->prev_->next_ = hook->next_;
+    hook->next_->prev_ = hook->prev_;
+    hook->next_ = nullptr;
+    hook->prev_ = nullptr;
+    size_--;
+  }
+
+  template< typename T, typename Tag >
+  void IntrusiveRingList< T, Tag >::adopt(this_t & rhs) noexcept
+  {
+    assert(empty());
+    if (rhs.empty())
+    {
+      return;
+    }
+    root_.next_ = rhs.root_.next_;
+    root_.prev_ = rhs.root_.prev_;
+    root_.next_->prev_ = std::addressof(root_);
+    root_.prev_->next_ = std::addressof(root_);
+    size_ = rhs.size_;
+    rhs.root_.next_ = std::addressof(rhs.root_);
+    rhs.root_.prev_ = std::addressof(rhs.root_);
+    rhs.size_ = 0;
+  }
+
+  template< typename T, typename Tag >
+  T & IntrusiveRingList< T, Tag >::value(hook_t * hook) noexcept
+  {
+    return static_cast< T & >(*hook);
+  }
+
+  template< typename T, typename Tag >
+  const T & IntrusiveRingList< T, Tag >::value(const hook_t * hook) noexcept
+  {
+    return static_cast< const T & >(*hook);
+  }
+}
+
+#endif
@@ -0,0 +1,136 @@
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include "intrusive_ring_list.hpp"
+
+namespace
+{
+  struct ReadyTag
+  {};
+
+  struct AllTag
+  {};
+
+  struct Task: petrov::RingHook< ReadyTag >, petrov::RingHook< AllTag >
+  {
+    explicit Task(int id):
+      id_(id)
+    {}
+    int id_;
+  };
+
+  using ready_list_t = petrov::IntrusiveRingList< Task, ReadyTag >;
+  using all_list_t = petrov::IntrusiveRingList< Task, AllTag >;
+
+  template< typename List >
+  std::string print(List & list)
+  {
+    std::ostringstream out;
+    for (auto it = list.begin(); it != list.end(); ++it)
+    {
+      out << it->id_ << ' ';
+    }
+    return out.str();
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(intrusive_ring_list)
+
+BOOST_AUTO_TEST_CASE(push_and_pop)
+{
+  Task a(1);
+  Task b(2);
+  Task c(3);
+  ready_list_t list;
+  list.push_back(b);
+  list.push_front(a);
+  list.push_back(c);
+  BOOST_TEST(print(list) == "1 2 3 ");
+  BOOST_TEST(list.size() == 3);
+  BOOST_TEST(list.front().id_ == 1);
+  BOOST_TEST(list.back().id_ == 3);
+  list.pop_front();
+  list.pop_back();
+  BOOST_TEST(print(list) == "2 ");
+  BOOST_TEST(!static_cast< petrov::RingHook< ReadyTag > & >(a).is_linked());
+  list.clear();
+  BOOST_TEST(list.empty());
+}
+
+BOOST_AUTO_TEST_CASE(remove_from_middle)
+{
+  Task a(1);
+  Task b(2);
+  Task c(3);
+  ready_list_t list;
+  list.push_back(a);
+  list.push_back(b);
+  list.push_back(c);
+  list.remove(b);
+  BOOST_TEST(print(list) == "1 3 ");
+  list.insert_after(list.iterator_to(a), b);
+  BOOST_TEST(print(list) == "1 2 3 ");
+  auto it = list.erase(list.iterator_to(a));
+  BOOST_TEST(it->id_ == 2);
+  list.insert(it, a);
+  BOOST_TEST(print(list) == "1 2 3 ");
+  list.clear();
+}
+
+BOOST_AUTO_TEST_CASE(several_rings)
+{
+  Task a(1);
+  Task b(2);
+  Task c(3);
+  ready_list_t ready;
+  all_list_t all;
+  all.push_back(a);
+  all.push_back(b);
+  all.push_back(c);
+  ready.push_back(c);
+  ready.push_back(a);
+  ready.remove(c);
+  BOOST_TEST(print(all) == "1 2 3 ");
+  BOOST_TEST(print(ready) == "1 ");
+  ready.clear();
+  all.clear();
+}
+
+BOOST_AUTO_TEST_CASE(rotate)
+{
+  Task a(1);
+  Task b(2);
+  Task c(3);
+  ready_list_t list;
+  list.push_back(a);
+  list.push_back(b);
+  list.push_back(c);
+  list.rotate();
+  BOOST_TEST(print(list) == "2 3 1 ");
+  list.rotate();
+  list.rotate();
+  BOOST_TEST(print(list) == "1 2 3 ");
+  list.clear();
+}
+
+BOOST_AUTO_TEST_CASE(move_and_swap)
+{
+  Task a(1);
+  Task b(2);
+  Task c(3);
+  ready_list_t first;
+  first.push_back(a);
+  first.push_back(b);
+  ready_list_t second(std::move(first));
+  BOOST_TEST(first.empty());
+  BOOST_TEST(print(second) == "1 2 ");
+  first.push_back(c);
+  first.swap(second);
+  BOOST_TEST(print(first) == "1 2 ");
+  BOOST_TEST(print(second) == "3 ");
+  second = std::move(first);
+  BOOST_TEST(print(second) == "1 2 ");
+  BOOST_TEST(!static_cast< petrov::RingHook< ReadyTag > & >(c).is_linked());
+  second.clear();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
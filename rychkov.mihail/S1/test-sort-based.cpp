@@ -1,3 +1,6 @@
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
 #include "test_utils.hpp"
 
 BOOST_AUTO_TEST_SUITE(S1_sort_based_test)
@@ -8,6 +11,65 @@ BOOST_AUTO_TEST_CASE(sort_test)
   list.sort();
   rychkov::fullCompare(list, {-3, -1, 3, 4, 4, 6, 7});
 }
+BOOST_AUTO_TEST_CASE(sort_stability_test)
+{
+  using pair = std::pair< int, int >;
+  rychkov::List< pair > list1, list2;
+  for (int i = 0; i < 100000; i++)
+  {
+    list1.push_back({(i * 7919) % 13, i});
+  }
+  list2 = list1;
+  auto byFirst = [](const pair& lhs, const pair& rhs)
+  {
+    return lhs.first < rhs.first;
+  };
+  list1.sort(byFirst);
+  list2.parallel_sort(byFirst, 3);
+  BOOST_TEST(list1.size() == 100000);
+  BOOST_TEST((list1 == list2));
+  for (rychkov::List< pair >::const_iterator i = list1.begin(), j = ++list1.begin(); j != list1.end(); ++i, ++j)
+  {
+    BOOST_TEST(((i->first < j->first) || ((i->first == j->first) && (i->second < j->second))));
+  }
+}
+BOOST_AUTO_TEST_CASE(parallel_sort_test)
+{
+  rychkov::List< int > list;
+  for (int i = 0; i < 100000; i++)
+  {
+    list.push_back((i * 7919) % 100003);
+  }
+  rychkov::List< int > expected = list;
+  expected.sort();
+  list.parallel_sort(5);
+  rychkov::fullCompare(list, expected);
+}
+BOOST_AUTO_TEST_CASE(sort_throwing_compare_test)
+{
+  rychkov::List< int > list;
+  long long sum = 0;
+  for (int i = 0; i < 100000; i++)
+  {
+    list.push_back((i * 7919) % 100003);
+    sum += list.back();
+  }
+  std::atomic< size_t > calls{0};
+  auto throwing = [&calls](int lhs, int rhs)
+  {
+    if (++calls == 50000)
+    {
+      throw std::logic_error("compare failed");
+    }
+    return lhs < rhs;
+  };
+  BOOST_CHECK_THROW(list.sort(throwing), std::logic_error);
+  BOOST_TEST(list.size() == 100000);
+  BOOST_TEST(std::accumulate(list.begin(), list.end(), 0LL) == sum);
+  calls = 0;
+  BOOST_CHECK_THROW(list.parallel_sort(throwing, 4), std::logic_error);
+  BOOST_TEST(std::accumulate(list.rbegin(), list.rend(), 0LL) == sum);
+}
 BOOST_AUTO_TEST_CASE(merge_test)
 {
   rychkov::List< int > list1 = {-1, 3, 4, 6, 7};
@@ -85,6 +85,9 @@ namespace rychkov
     void sort();
     template< class C >
     void sort(C compare);
+    void parallel_sort(size_t threads = 0);
+    template< class C >
+    void parallel_sort(C compare, size_t threads);
 
     void clear() noexcept;
     void swap(List& rhs) noexcept;
@@ -127,8 +130,22 @@ namespace rychkov
 
     template< class C >
     bool compare(const List& rhs, C comp) const;
+    static constexpr size_t sortBuckets = 64;
+    static constexpr size_t minParallelRun = 1 << 14;
+    struct run_t
+    {
+      node_t< value_type >* head = nullptr;
+      node_t< value_type >* tail = nullptr;
+    };
+
+    template< class C >
+    static void sortRun(C& compare, run_t& run);
     template< class C >
-    const_iterator merge_sort(C& compare, const_iterator& from, size_t size_);
+    static void mergeRuns(C& compare, run_t& left, run_t& right);
+    template< class F >
+    static void runParallel(size_t nTasks, F task);
+    static void concatRuns(run_t& left, run_t& right) noexcept;
+    void adoptRun(run_t run) noexcept;
     template< class C >
     const_iterator unsafeMerge(C& compare, const_iterator& from, const_iterator to,
         const_iterator insfrom, const_iterator insto);
@@ -3,9 +3,18 @@
 
 #include "declaration.hpp"
 
+#include <algorithm>
+#include <exception>
 #include <functional>
+#include <system_error>
+#include <thread>
 #include <utility>
 
+template< class T >
+constexpr size_t rychkov::List< T >::sortBuckets;
+template< class T >
+constexpr size_t rychkov::List< T >::minParallelRun;
+
 template< class T >
 typename rychkov::List< T >::size_type rychkov::List< T >::unique()
 {
@@ -45,25 +54,248 @@ void rychkov::List< T >::sort(C compare)
   {
     return;
   }
-  const_iterator from = begin();
-  const_iterator to = merge_sort(compare, from, size_);
-  head_ = from.node_;
-  tail_ = to.node_;
-  head_->prev = nullptr;
-  tail_->next = nullptr;
+  run_t run{head_, tail_};
+  try
+  {
+    sortRun(compare, run);
+  }
+  catch (...)
+  {
+    adoptRun(run);
+    throw;
+  }
+  adoptRun(run);
+}
+template< class T >
+void rychkov::List< T >::parallel_sort(size_t threads)
+{
+  parallel_sort(std::less<>(), threads);
 }
 template< class T >
 template< class C >
-typename rychkov::List< T >::const_iterator rychkov::List< T >::merge_sort(C& compare, const_iterator& from, size_t count)
+void rychkov::List< T >::parallel_sort(C compare, size_t threads)
 {
-  if (count == 1)
+  if (threads == 0)
   {
-    return from;
+    threads = std::thread::hardware_concurrency();
+  }
+  size_t nRuns = std::min({threads, sortBuckets, size_ / minParallelRun});
+  if (nRuns <= 1)
+  {
+    sort(std::move(compare));
+    return;
   }
-  const_iterator mid = merge_sort(compare, from, (count + 1) / 2);
-  const_iterator postMid = ++const_iterator{mid};
-  const_iterator to = merge_sort(compare, postMid, count / 2);
-  return unsafeMerge(compare, from, mid, postMid, to);
+  run_t runs[sortBuckets];
+  node_t< value_type >* node = head_;
+  for (size_t i = 0; i < nRuns; i++)
+  {
+    runs[i].head = node;
+    size_t runSize = size_ / nRuns + (i < size_ % nRuns);
+    for (size_t j = 1; j < runSize; j++)
+    {
+      node = node->next;
+    }
+    runs[i].tail = node;
+    node = node->next;
+    runs[i].tail->next = nullptr;
+  }
+
+  std::exception_ptr errors[sortBuckets];
+  for (size_t width = 1; width / 2 < nRuns; width *= 2)
+  {
+    size_t nTasks = (width == 1) ? nRuns : (nRuns + width / 2 - 1) / width;
+    runParallel(nTasks, [&runs, &errors, &compare, width](size_t i)
+    {
+      C localCompare = compare;
+      try
+      {
+        if (width == 1)
+        {
+          sortRun(localCompare, runs[i]);
+        }
+        else
+        {
+          mergeRuns(localCompare, runs[i * width], runs[i * width + width / 2]);
+        }
+      }
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+      }
+    });
+    for (size_t i = 0; i < nTasks; i++)
+    {
+      if (errors[i])
+      {
+        for (size_t j = 1; j < nRuns; j++)
+        {
+          concatRuns(runs[0], runs[j]);
+        }
+        adoptRun(runs[0]);
+        std::rethrow_exception(errors[i]);
+      }
+    }
+  }
+  adoptRun(runs[0]);
+}
+template< class T >
+template< class F >
+void rychkov::List< T >::runParallel(size_t nTasks, F task)
+{
+  std::thread workers[sortBuckets];
+  size_t started = 1;
+  try
+  {
+    for (; started < nTasks; started++)
+    {
+      workers[started] = std::thread(task, started);
+    }
+  }
+  catch (const std::system_error&)
+  {
+    for (size_t i = started; i < nTasks; i++)
+    {
+      task(i);
+    }
+  }
+  task(0);
+  for (size_t i = 1; i < started; i++)
+  {
+    workers[i].join();
+  }
+}
+template< class T >
+template< class C >
+void rychkov::List< T >::sortRun(C& compare, run_t& run)
+{
+  run_t buckets[sortBuckets];
+  run_t carry;
+  run_t result;
+  run_t rest = run;
+  size_t used = 0;
+  try
+  {
+    while (rest.head != nullptr)
+    {
+      carry = {rest.head, rest.head};
+      rest.head = rest.head->next;
+      carry.tail->next = nullptr;
+      size_t i = 0;
+      for (; (i < used) && (buckets[i].head != nullptr); i++)
+      {
+        mergeRuns(compare, buckets[i], carry);
+        carry = buckets[i];
+        buckets[i] = {};
+      }
+      buckets[i] = carry;
+      carry = {};
+      used = std::max(used, i + 1);
+    }
+    for (size_t i = 0; i < used; i++)
+    {
+      mergeRuns(compare, buckets[i], result);
+      result = buckets[i];
+      buckets[i] = {};
+    }
+  }
+  catch (...)
+  {
+    for (size_t i = used; i > 0; i--)
+    {
+      concatRuns(result, buckets[i - 1]);
+    }
+    concatRuns(result, carry);
+    concatRuns(result, rest);
+    run = result;
+    throw;
+  }
+  run = result;
+}
+template< class T >
+template< class C >
+void rychkov::List< T >::mergeRuns(C& compare, run_t& left, run_t& right)
+{
+  if ((left.head == nullptr) || (right.head == nullptr))
+  {
+    concatRuns(left, right);
+    return;
+  }
+  node_t< value_type >* i = left.head;
+  node_t< value_type >* j = right.head;
+  run_t merged;
+  if (compare(j->data, i->data))
+  {
+    merged = {j, j};
+    j = j->next;
+  }
+  else
+  {
+    merged = {i, i};
+    i = i->next;
+  }
+  try
+  {
+    while ((i != nullptr) && (j != nullptr))
+    {
+      node_t< value_type >* taken = nullptr;
+      if (compare(j->data, i->data))
+      {
+        taken = j;
+        j = j->next;
+      }
+      else
+      {
+        taken = i;
+        i = i->next;
+      }
+      merged.tail->next = taken;
+      taken->prev = merged.tail;
+      merged.tail = taken;
+    }
+  }
+  catch (...)
+  {
+    merged.tail->next = nullptr;
+    run_t restLeft{i, (i != nullptr) ? left.tail : nullptr};
+    run_t restRight{j, (j != nullptr) ? right.tail : nullptr};
+    concatRuns(merged, restLeft);
+    concatRuns(merged, restRight);
+    left = merged;
+    right = {};
+    throw;
+  }
+  run_t restRun = (i != nullptr) ? run_t{i, left.tail} : run_t{j, right.tail};
+  merged.tail->next = nullptr;
+  concatRuns(merged, restRun);
+  left = merged;
+  right = {};
+}
+template< class T >
+void rychkov::List< T >::concatRuns(run_t& left, run_t& right) noexcept
+{
+  if (right.head == nullptr)
+  {
+    return;
+  }
+  if (left.head == nullptr)
+  {
+    left = right;
+  }
+  else
+  {
+    left.tail->next = right.head;
+    right.head->prev = left.tail;
+    left.tail = right.tail;
+  }
+  right = {};
+}
+template< class T >
+void rychkov::List< T >::adoptRun(run_t run) noexcept
+{
+  head_ = run.head;
+  tail_ = run.tail;
+  head_->prev = nullptr;
+  tail_->next = nullptr;
 }
 template< class T >
 template< class C >